@@ -0,0 +1,139 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include "core/renderer/pxl_culling.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Frustum culling 1M spheres. cull_spheres() (AVX / SSE, picked at runtime) against a
+// plain scalar loop written here, same test and same inputs, and the two visible
+// arrays have to match exactly. Then the whole RenderQueue cull stage with the same
+// count of draws, which also pays for reading the transforms and the world spheres
+
+static u32_t cull_reference(
+    const pxl::culling::Frustum& frustum,
+    const f32_t* x, const f32_t* y, const f32_t* z, const f32_t* radius,
+    u32_t count, u8_t* visible
+) {
+    u32_t total = 0;
+
+    for(u32_t i = 0; i < count; i++) {
+        bool inside = true;
+        for(const auto& plane : frustum.planes) {
+            f32_t distance = plane.x * x[i] + plane.y * y[i] + plane.z * z[i] + plane.w;
+            if(distance < -radius[i]) { inside = false; break; }
+        }
+
+        visible[i] = inside;
+        total += inside;
+    }
+
+    return total;
+}
+
+namespace pxl {
+namespace bench {
+
+    int cull(const Args& args) {
+        const u32_t count = (u32_t)args.get("objects", 1000000);
+        const u32_t runs = std::max<u32_t>(1, (u32_t)args.get("runs", 20));
+        const u64_t queue_frames = args.get("queue-frames", 10);
+
+        if(!count) {
+            fprintf(stderr, "objects has to be > 0\n");
+            return 1;
+        }
+
+        printf("  %u spheres, %u runs, SIMD path: %s\n", count, runs, pxl::culling::get_simd_path());
+
+        const Camera camera = scene_camera(16.0f / 9.0f);
+        const pxl::culling::Frustum frustum = pxl::culling::extract_frustum(camera.view_projection);
+
+        // Same scene the frame bench draws, unit-ish boxes scaled 0.5 - 2
+        std::vector<f32_t> x(count), y(count), z(count), radius(count);
+        for(u32_t i = 0; i < count; i++) {
+            const glm::mat4 transform = scene_transform(i);
+            x[i] = transform[3].x;
+            y[i] = transform[3].y;
+            z[i] = transform[3].z;
+            radius[i] = glm::length(glm::vec3(transform[0])) * 1.7f;
+        }
+
+        std::vector<u8_t> simd_visible(count), scalar_visible(count);
+        u32_t simd_total = 0, scalar_total = 0;
+
+        Samples scalar_ms, simd_ms;
+        for(u32_t run = 0; run < runs; run++) {
+            auto start = bench_clock::now();
+            scalar_total = cull_reference(frustum, x.data(), y.data(), z.data(), radius.data(), count, scalar_visible.data());
+            scalar_ms.add(elapsed_ms(start));
+
+            start = bench_clock::now();
+            simd_total = pxl::culling::cull_spheres(frustum, x.data(), y.data(), z.data(), radius.data(), count, simd_visible.data());
+            simd_ms.add(elapsed_ms(start));
+        }
+
+        print_samples_header();
+        print_samples("scalar", scalar_ms);
+        print_samples(pxl::culling::get_simd_path(), simd_ms);
+
+        const f64_t simd_p50 = simd_ms.percentile(0.5);
+        if(simd_p50 > 0.0)
+            printf("  %.1fx over scalar (p50), %u of %u visible\n", scalar_ms.percentile(0.5) / simd_p50, simd_total, count);
+
+        if(simd_total != scalar_total || memcmp(simd_visible.data(), scalar_visible.data(), count) != 0) {
+            printf("  MISMATCH, %s visible %u, scalar visible %u\n", pxl::culling::get_simd_path(), simd_total, scalar_total);
+            return 1;
+        }
+
+        printf("  %s matches scalar\n", pxl::culling::get_simd_path());
+
+        if(!queue_frames) return 0;
+
+        // The same count as draws through the headless engine, only the cull stage matters here
+        FrameOptions options;
+        options.draws = count;
+        options.frames = queue_frames;
+        options.warmup = 2;
+
+        printf("\n  RenderQueue cull stage, %u draws, %llu frames\n", count, (unsigned long long)queue_frames);
+
+        FrameResult result;
+        run_frames(options, result);
+
+        print_samples_header();
+        print_samples("queue cull", result.cull_ms);
+        return 0;
+    }
+
+};
+};
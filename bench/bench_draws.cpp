@@ -0,0 +1,69 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include <cstdio>
+
+// Draw throughput with the per draw constants going through the uniform ring: the
+// queue fills one PxlObject block per visible draw in build(), the GL41Renderer
+// copies them into the ring once per frame and only moves a glBindBufferRange per
+// draw. Headless shows the CPU side (submit + cull + sort + build with the constants),
+// --gl adds the ring upload and the GL calls
+
+namespace pxl {
+namespace bench {
+
+    int draws(const Args& args) {
+        FrameOptions options;
+        if(!frame_options(args, options)) return 1;
+
+        print_frame_options(options);
+
+        FrameResult result;
+        run_frames(options, result);
+        print_frame_result(options, result);
+
+        const RenderStats& totals = result.totals;
+        const f64_t frames = (f64_t)(totals.frames ? totals.frames : 1);
+        const f64_t objects = (f64_t)totals.instances / frames;
+
+        printf("  %.0f object blocks per frame\n", objects);
+
+        if(totals.uniform_bytes) {
+            const f64_t bytes = (f64_t)totals.uniform_bytes / frames;
+            printf("  uniform ring %.2f MB per frame, %.0f B per object\n",
+                bytes / (1024.0 * 1024.0), objects > 0.0 ? bytes / objects : 0.0);
+        }
+
+        return 0;
+    }
+
+};
+};
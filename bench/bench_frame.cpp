@@ -0,0 +1,223 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include "main/engine.h"
+#include "scene/iapplogic.h"
+
+#include <cstdio>
+#include <cstring>
+
+// The engine drives the frames, so this measures the same tick / render path a game
+// takes. Headless runs go through the NullRenderer (no GL), --gl opens a window and
+// runs the GL41Renderer. Draws come in a scrambled order with a few shaders and
+// meshes, a slice of them translucent, so every queue stage has work to do
+
+class FrameBench : public IAppLogic {
+
+private:
+    const pxl::bench::FrameOptions& options;
+    pxl::bench::FrameResult& result;
+    Engine* engine = nullptr;
+
+    std::vector<u64_t> meshes;
+    std::vector<u64_t> shaders;
+    std::vector<DrawCall> draws;
+
+    u64_t frame = 0;
+    pxl::bench::bench_clock::time_point frame_start;
+
+public:
+    FrameBench(const pxl::bench::FrameOptions& options, pxl::bench::FrameResult& result) :
+        options(options), result(result) {
+
+    }
+
+    void set_engine(Engine* engine) { this->engine = engine; }
+
+    void init() override {
+        const char* vertex = options.instanced ? "bench/res/bench_instanced.vert" : "bench/res/bench_object.vert";
+        for(u32_t i = 0; i < options.shaders; i++) {
+            Shader shader { vertex, "bench/res/bench.frag" };
+            shaders.push_back(renderer->add_shader(shader));
+        }
+
+        for(u32_t i = 0; i < options.meshes; i++) {
+            Mesh mesh = pxl::bench::make_box(2, i);
+            meshes.push_back(renderer->add_mesh(mesh));
+        }
+
+        renderer->set_camera(pxl::bench::scene_camera(16.0f / 9.0f));
+
+        // Built once, the per frame cost is the submit itself
+        draws.resize(options.draws);
+        for(u32_t i = 0; i < options.draws; i++) {
+            const u32_t scrambled = pxl::bench::hash(i);
+            const u32_t mesh = options.unique_meshes ? i % options.meshes : scrambled % options.meshes;
+
+            DrawCall& draw = draws[i];
+            draw = DrawCall();
+            draw.mesh_id = meshes[mesh];
+            draw.shader_id = shaders[(scrambled / options.meshes) % options.shaders];
+            draw.transform = pxl::bench::scene_transform(i);
+            draw.translucent = options.translucent_every && scrambled % options.translucent_every == 0;
+        }
+    }
+
+    void tick(const f32_t& dt) override {
+        (void)dt;
+    }
+
+    void render() override {
+        collect();
+
+        auto start = pxl::bench::bench_clock::now();
+        for(const DrawCall& draw : draws)
+            renderer->submit_draw_call(draw);
+
+        if(frame > options.warmup) result.submit_ms.add(pxl::bench::elapsed_ms(start));
+
+        // Windowed frames tick on the wall clock, so max_ticks can't count them
+        if(frame >= options.warmup + options.frames) engine->stop();
+    }
+
+    void cleanup() override {
+        collect();
+    }
+
+private:
+    // The renderer's stats are the previous frame's until draw() runs again
+    void collect() {
+        // Let the GPU catch up so the frame time covers its work too
+        if(options.gl) glFinish();
+
+        auto now = pxl::bench::bench_clock::now();
+
+        if(frame > options.warmup) {
+            const RenderStats& stats = renderer->get_frame_stats();
+
+            result.cull_ms.add(stats.cull_ms);
+            result.sort_ms.add(stats.sort_ms);
+            result.build_ms.add(stats.build_ms);
+            result.execute_ms.add(stats.execute_ms);
+            result.frame_ms.add(std::chrono::duration<f64_t, std::milli>(now - frame_start).count());
+            result.totals.accumulate(stats);
+        }
+
+        frame_start = now;
+        frame++;
+    }
+
+};
+
+namespace pxl {
+namespace bench {
+
+    bool frame_options(const Args& args, FrameOptions& options) {
+        options.draws = (u32_t)args.get("draws", options.draws);
+        options.meshes = (u32_t)args.get("meshes", options.meshes);
+        options.shaders = (u32_t)args.get("shaders", options.shaders);
+        options.frames = args.get("frames", options.frames);
+        options.warmup = args.get("warmup", options.warmup);
+        options.gl = args.get("gl", options.gl) != 0;
+        options.instanced = args.get("instanced", options.instanced) != 0;
+
+        const char* storage = args.get_str("storage", nullptr);
+        if(storage) {
+            if(strcmp(storage, "pooled") == 0) options.storage = MeshStorage::POOLED;
+            else if(strcmp(storage, "separate") == 0) options.storage = MeshStorage::SEPARATE;
+            else {
+                fprintf(stderr, "--storage is separate or pooled\n");
+                return false;
+            }
+        }
+
+        if(!options.draws || !options.meshes || !options.shaders || !options.frames) {
+            fprintf(stderr, "draws, meshes, shaders and frames have to be > 0\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    void print_frame_options(const FrameOptions& options) {
+        printf("  %u draws per frame, %u meshes, %u shaders, %llu frames (+%llu warmup)\n",
+            options.draws, options.meshes, options.shaders,
+            (unsigned long long)options.frames, (unsigned long long)options.warmup);
+        printf("  %s, %s storage%s\n",
+            options.gl ? "GL41Renderer (windowed)" : "NullRenderer (headless)",
+            options.storage == MeshStorage::POOLED ? "pooled" : "separate",
+            options.instanced ? ", instanced shaders" : "");
+    }
+
+    void run_frames(const FrameOptions& options, FrameResult& result) {
+        EngineConfig config;
+        config.mode = options.gl ? EngineMode::WINDOWED : EngineMode::HEADLESS;
+        config.unlocked = true;
+        config.mesh_storage = options.storage;
+        // Everything resident before the first timed frame
+        config.upload_budget = 0;
+
+        FrameBench app(options, result);
+        Engine engine(app, config);
+        app.set_engine(&engine);
+        engine.start();
+    }
+
+    void print_frame_result(const FrameOptions& options, const FrameResult& result) {
+        print_samples_header();
+        print_samples("submit", result.submit_ms);
+        print_samples("cull", result.cull_ms);
+        print_samples("sort", result.sort_ms);
+        print_samples("build", result.build_ms);
+        print_samples("execute", result.execute_ms);
+        print_samples("frame (wall)", result.frame_ms);
+
+        const f64_t frame_avg = result.frame_ms.average();
+        if(frame_avg > 0.0)
+            printf("  %.2f M draws/s\n", (f64_t)options.draws / frame_avg / 1000.0);
+
+        print_render_stats(result.totals);
+    }
+
+    int frame(const Args& args) {
+        FrameOptions options;
+        if(!frame_options(args, options)) return 1;
+
+        print_frame_options(options);
+
+        FrameResult result;
+        run_frames(options, result);
+        print_frame_result(options, result);
+        return 0;
+    }
+
+};
+};
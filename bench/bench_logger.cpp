@@ -0,0 +1,173 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include "core/debug/pxl_logger.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+// Caller side latency of a log call: what the thread that logs pays, the logger
+// thread formats and writes behind it. LOG() compiles out unless PXL_LOGGER_ENABLED
+// is set, so the calls go through PIXL_LOG_IMPL directly, the same code LOG() expands to.
+// Every call is timed with the logger's own clock (rdtsc on x86), the cost of the
+// two reads is measured and taken off
+
+struct LoggerBenchThread {
+    std::vector<u32_t> ticks;
+    std::thread thread;
+};
+
+static void logger_bench_thread(LoggerBenchThread* self, u32_t index, u32_t calls, u64_t timer_ticks,
+    std::atomic<u32_t>* ready, const std::atomic<bool>* go) {
+
+    self->ticks.resize(calls);
+
+    ready->fetch_add(1, std::memory_order_acq_rel);
+    while(!go->load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    for(u32_t i = 0; i < calls; i++) {
+        u64_t start = pxl::logger::now_ticks();
+        PIXL_LOG_IMPL(pxl::logger::LogLevel::LOG, "bench call %u on thread %u, value %f", i, index, (f64_t)i * 0.5);
+        u64_t ticks = pxl::logger::now_ticks() - start;
+
+        ticks = ticks > timer_ticks ? ticks - timer_ticks : 0;
+        self->ticks[i] = (u32_t)std::min<u64_t>(ticks, 0xFFFFFFFFu);
+    }
+}
+
+// Ticks two back to back clock reads take, the floor under every sample
+static u64_t measure_timer_ticks() {
+    u64_t best = ~0ull;
+    for(u32_t i = 0; i < 100000; i++) {
+        u64_t start = pxl::logger::now_ticks();
+        u64_t ticks = pxl::logger::now_ticks() - start;
+        if(ticks < best) best = ticks;
+    }
+    return best;
+}
+
+namespace pxl {
+namespace bench {
+
+    int logger(const Args& args) {
+        const u64_t calls = args.get("calls", 10000000);
+        const u32_t threads = (u32_t)args.get("threads", 8);
+        const char* path = args.get_str("log", "bench_logger.log");
+
+        if(!calls || !threads) {
+            fprintf(stderr, "calls and threads have to be > 0\n");
+            return 1;
+        }
+
+        const u32_t per_thread = (u32_t)(calls / threads);
+
+        pxl::logger::set_level(pxl::logger::LogLevel::LOG);
+        pxl::logger::set_console_enabled(false);
+        if(!pxl::logger::add_file_sink(path)) {
+            fprintf(stderr, "can't open %s\n", path);
+            return 1;
+        }
+
+        const u64_t timer_ticks = measure_timer_ticks();
+
+        printf("%u threads x %u calls, file sink %s (rotating)\n", threads, per_thread, path);
+
+        std::vector<LoggerBenchThread> workers(threads);
+        std::atomic<u32_t> ready{0};
+        std::atomic<bool> go{false};
+
+        for(u32_t i = 0; i < threads; i++)
+            workers[i].thread = std::thread(logger_bench_thread, &workers[i], i, per_thread, timer_ticks, &ready, &go);
+
+        while(ready.load(std::memory_order_acquire) < threads)
+            std::this_thread::yield();
+
+        // ticks -> ns over the whole run, no extra calibration step
+        const u64_t start_ticks = pxl::logger::now_ticks();
+        const auto start = bench_clock::now();
+
+        go.store(true, std::memory_order_release);
+        for(auto& worker : workers)
+            worker.thread.join();
+
+        const f64_t calls_ms = elapsed_ms(start);
+        const u64_t run_ticks = pxl::logger::now_ticks() - start_ticks;
+
+        pxl::logger::flush();
+        const f64_t drained_ms = elapsed_ms(start);
+
+        const f64_t ns_per_tick = run_ticks ? calls_ms * 1e6 / (f64_t)run_ticks : 1.0;
+
+        std::vector<u32_t> all;
+        all.reserve((size_t)per_thread * threads);
+        for(auto& worker : workers) {
+            all.insert(all.end(), worker.ticks.begin(), worker.ticks.end());
+            std::vector<u32_t>().swap(worker.ticks);
+        }
+
+        auto percentile = [&all, ns_per_tick](f64_t p) {
+            size_t rank = (size_t)(p * (f64_t)(all.size() - 1) + 0.5);
+            std::nth_element(all.begin(), all.begin() + rank, all.end());
+            return (f64_t)all[rank] * ns_per_tick;
+        };
+
+        const pxl::logger::LoggerStats stats = pxl::logger::get_stats();
+
+        printf("  caller latency, timer floor (%.1f ns) taken off\n", (f64_t)timer_ticks * ns_per_tick);
+        printf("    %-18s %10.1f ns\n", "p50", percentile(0.5));
+        printf("    %-18s %10.1f ns\n", "p99", percentile(0.99));
+        printf("    %-18s %10.1f ns\n", "p99.9", percentile(0.999));
+        printf("    %-18s %10.1f ns\n", "max", percentile(1.0));
+        printf("  %.1f ms for the calls (%.2f M calls/s), %.1f ms until written\n",
+            calls_ms, (f64_t)all.size() / calls_ms / 1000.0, drained_ms);
+        printf("  %llu records, %.1f MB written, %llu producer stalls\n",
+            (unsigned long long)stats.records, (f64_t)stats.bytes_written / (1024.0 * 1024.0),
+            (unsigned long long)stats.producer_stalls);
+
+        pxl::logger::shutdown();
+
+        // add_file_sink() keeps 5 files by default, --keep leaves them for a look
+        if(!args.flag("keep")) {
+            std::remove(path);
+            for(u32_t i = 1; i < 5; i++)
+                std::remove((std::string(path) + "." + std::to_string(i)).c_str());
+        }
+
+        return 0;
+    }
+
+};
+};
@@ -0,0 +1,75 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include <cstdio>
+
+// 10K unique meshes, each drawn once with one shader, so every draw switches mesh.
+// With separate storage that's a VAO bind and a glDrawElements per draw, pooled
+// meshes share one VAO and on 4.3+ contexts the whole run goes out as one
+// glMultiDrawElementsIndirect. Headless shows what the queue costs for it, run
+// with --gl --storage=separate and --gl --storage=pooled to compare the GL side
+
+namespace pxl {
+namespace bench {
+
+    int meshes(const Args& args) {
+        FrameOptions options;
+        options.draws = 10000;
+        options.meshes = 10000;
+        options.shaders = 1;
+        options.instanced = true;
+        options.unique_meshes = true;
+        options.translucent_every = 0;
+        options.storage = MeshStorage::POOLED;
+        if(!frame_options(args, options)) return 1;
+
+        print_frame_options(options);
+
+        FrameResult result;
+        run_frames(options, result);
+        print_frame_result(options, result);
+
+        const RenderStats& totals = result.totals;
+        const f64_t frames = (f64_t)(totals.frames ? totals.frames : 1);
+
+        printf("  per frame: %.0f draws after culling, %.0f mesh switches, %.0f multi draws\n",
+            (f64_t)totals.instances / frames,
+            (f64_t)totals.mesh_changes / frames,
+            (f64_t)totals.multi_draws / frames);
+
+        if(options.gl)
+            printf("  per frame: %.0f GL state calls\n", (f64_t)totals.gl_state_calls / frames);
+
+        return 0;
+    }
+
+};
+};
@@ -0,0 +1,165 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include "core/debug/pxl_profiler.h"
+
+#include <cstdio>
+
+// What one PXL_PROFILE_SCOPE costs the code it wraps. The profiler is opt in, so
+// the default build only shows that the macro compiles to nothing. Uncomment
+// PXL_PROFILER_ENABLED in core/config.h (or pass -DPXL_PROFILER_ENABLED) and
+// rebuild to measure recording zones against the budget
+
+#ifndef PXL_BENCH_ZONE_BUDGET_NS
+#define PXL_BENCH_ZONE_BUDGET_NS 20.0
+#endif
+
+// Every loop body stores here so the loops can't be dropped or merged
+static volatile u32_t zone_sink = 0;
+
+static f64_t ns_per(pxl::bench::bench_clock::time_point start, u64_t count) {
+    return pxl::bench::elapsed_ms(start) * 1e6 / (f64_t)count;
+}
+
+static f64_t time_loop(u32_t iterations) {
+    auto start = pxl::bench::bench_clock::now();
+    for(u32_t i = 0; i < iterations; i++)
+        zone_sink = i;
+    return ns_per(start, iterations);
+}
+
+static f64_t time_zones(u32_t iterations) {
+    auto start = pxl::bench::bench_clock::now();
+    for(u32_t i = 0; i < iterations; i++) {
+        PXL_PROFILE_SCOPE("bench zone");
+        zone_sink = i;
+    }
+    return ns_per(start, iterations);
+}
+
+// Per zone, four deep like Engine::render > draw > build > ...
+static f64_t time_nested_zones(u32_t iterations) {
+    auto start = pxl::bench::bench_clock::now();
+    for(u32_t i = 0; i < iterations / 4; i++) {
+        PXL_PROFILE_SCOPE("bench depth 0");
+        {
+            PXL_PROFILE_SCOPE("bench depth 1");
+            {
+                PXL_PROFILE_SCOPE("bench depth 2");
+                {
+                    PXL_PROFILE_SCOPE("bench depth 3");
+                    zone_sink = i;
+                }
+            }
+        }
+    }
+    return ns_per(start, iterations / 4 * 4);
+}
+
+#if defined(PXL_PROFILER_ENABLED) && !defined(PXL_PROFILER_TRACY)
+// A zone reads the clock twice, on VMs that trap rdtsc that alone can blow the budget
+static volatile u64_t tick_sink = 0;
+
+static f64_t time_timestamps(u32_t iterations) {
+    auto start = pxl::bench::bench_clock::now();
+    for(u32_t i = 0; i < iterations; i++)
+        tick_sink = pxl::profiler::now_ticks();
+    return ns_per(start, iterations);
+}
+#endif
+
+// What the zone adds on top of the loop it sits in, timer noise can dip below 0
+static f64_t zone_ns(f64_t measured, f64_t loop) {
+    return measured > loop ? measured - loop : 0.0;
+}
+
+// Best of `repeat`, the minimum is the least disturbed by the scheduler
+static f64_t best_of(u32_t repeat, f64_t (*run)(u32_t), u32_t iterations) {
+    f64_t best = run(iterations);
+    for(u32_t i = 1; i < repeat; i++) {
+        f64_t ns = run(iterations);
+        if(ns < best) best = ns;
+    }
+    return best;
+}
+
+namespace pxl {
+namespace bench {
+
+    int profiler(const Args& args) {
+        const u32_t iterations = (u32_t)args.get("iterations", 1000000);
+        const u32_t repeat = (u32_t)args.get("repeat", 10);
+        if(!iterations || !repeat) {
+            fprintf(stderr, "iterations and repeat have to be > 0\n");
+            return 1;
+        }
+
+        printf("%u zones per run, best of %u\n", iterations, repeat);
+
+        const f64_t loop = best_of(repeat, time_loop, iterations);
+        printf("  %-28s %8.2f ns\n", "empty loop", loop);
+
+#if defined(PXL_PROFILER_ENABLED) && !defined(PXL_PROFILER_TRACY)
+        pxl::profiler::set_enabled(false);
+        const f64_t off = zone_ns(best_of(repeat, time_zones, iterations), loop);
+        printf("  %-28s %8.2f ns\n", "zone, recording off", off);
+        pxl::profiler::set_enabled(true);
+        const char* mode = "recording";
+#elif defined(PXL_PROFILER_TRACY)
+        const char* mode = "tracy";
+#else
+        const char* mode = "compiled out";
+#endif
+
+        const f64_t flat = zone_ns(best_of(repeat, time_zones, iterations), loop);
+        const f64_t nested = zone_ns(best_of(repeat, time_nested_zones, iterations), loop / 4.0);
+
+        printf("  zone, %-22s %8.2f ns\n", mode, flat);
+        printf("  zone, %-22s %8.2f ns\n", "4 deep", nested);
+
+#if defined(PXL_PROFILER_ENABLED) && !defined(PXL_PROFILER_TRACY)
+        pxl::profiler::clear();
+
+        const f64_t timestamp = best_of(repeat, time_timestamps, iterations);
+        printf("  %-28s %8.2f ns (%s)\n", "timestamp", timestamp,
+            PXL_PROFILER_RDTSC ? "rdtsc" : "steady_clock");
+        printf("  %-28s %8.2f ns\n", "zone minus 2 timestamps", flat > 2.0 * timestamp ? flat - 2.0 * timestamp : 0.0);
+        printf("  budget %.0f ns per zone: %s\n", PXL_BENCH_ZONE_BUDGET_NS,
+            flat <= PXL_BENCH_ZONE_BUDGET_NS && nested <= PXL_BENCH_ZONE_BUDGET_NS ? "ok" : "OVER");
+#elif !defined(PXL_PROFILER_TRACY)
+        printf("  rebuild with PXL_PROFILER_ENABLED to measure recording zones\n");
+#endif
+
+        return 0;
+    }
+
+};
+};
@@ -0,0 +1,214 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include "main/engine.h"
+#include "scene/iapplogic.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+// 200K draws recorded from 1 - 16 threads per frame. The recorders are persistent
+// like a game's job threads, so each keeps its CommandBuffer across frames, they
+// get woken per frame, record their slice through submit_draw_call() and are joined
+// before the engine calls draw(). Reports the record time and the build the queue
+// does afterwards (merge + cull + sort + command emission)
+
+class RecordBench : public IAppLogic {
+
+private:
+    u32_t draw_count;
+    u32_t thread_count;
+    u64_t warmup;
+    u64_t frames;
+    Engine* engine = nullptr;
+
+    std::vector<u64_t> meshes;
+    std::vector<u64_t> shaders;
+    std::vector<DrawCall> draws;
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    u64_t generation = 0;
+    u32_t finished = 0;
+    bool quit = false;
+
+    u64_t frame = 0;
+
+public:
+    pxl::bench::Samples record_ms;
+    pxl::bench::Samples build_ms;      // cull + sort + build as the queue reports them
+
+public:
+    RecordBench(u32_t draw_count, u32_t thread_count, u64_t warmup, u64_t frames) :
+        draw_count(draw_count), thread_count(thread_count), warmup(warmup), frames(frames) {
+
+    }
+
+    void set_engine(Engine* engine) { this->engine = engine; }
+
+    void init() override {
+        for(u32_t i = 0; i < 8; i++) {
+            Shader shader { "bench/res/bench_object.vert", "bench/res/bench.frag" };
+            shaders.push_back(renderer->add_shader(shader));
+        }
+
+        for(u32_t i = 0; i < 64; i++) {
+            Mesh mesh = pxl::bench::make_box(2, i);
+            meshes.push_back(renderer->add_mesh(mesh));
+        }
+
+        renderer->set_camera(pxl::bench::scene_camera(16.0f / 9.0f));
+
+        draws.resize(draw_count);
+        for(u32_t i = 0; i < draw_count; i++) {
+            const u32_t scrambled = pxl::bench::hash(i);
+
+            DrawCall& draw = draws[i];
+            draw = DrawCall();
+            draw.mesh_id = meshes[scrambled % 64];
+            draw.shader_id = shaders[(scrambled / 64) % 8];
+            draw.transform = pxl::bench::scene_transform(i);
+            draw.translucent = scrambled % 16 == 0;
+        }
+
+        for(u32_t i = 0; i < thread_count; i++)
+            threads.emplace_back(&RecordBench::recorder_main, this, i);
+    }
+
+    void tick(const f32_t& dt) override {
+        (void)dt;
+    }
+
+    void render() override {
+        collect();
+
+        auto start = pxl::bench::bench_clock::now();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished = 0;
+            generation++;
+            wake.notify_all();
+            done.wait(lock, [this] { return finished == thread_count; });
+        }
+
+        if(frame > warmup) record_ms.add(pxl::bench::elapsed_ms(start));
+        if(frame >= warmup + frames) engine->stop();
+    }
+
+    void cleanup() override {
+        collect();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+            wake.notify_all();
+        }
+
+        for(auto& thread : threads) thread.join();
+        threads.clear();
+    }
+
+private:
+    void collect() {
+        if(frame > warmup) {
+            const RenderStats& stats = renderer->get_frame_stats();
+            build_ms.add(stats.cull_ms + stats.sort_ms + stats.build_ms);
+        }
+
+        frame++;
+    }
+
+    void recorder_main(u32_t index) {
+        const u32_t begin = (u32_t)((u64_t)draw_count * index / thread_count);
+        const u32_t end = (u32_t)((u64_t)draw_count * (index + 1) / thread_count);
+
+        u64_t seen = 0;
+        for(;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this, seen] { return quit || generation != seen; });
+                if(quit) return;
+                seen = generation;
+            }
+
+            for(u32_t i = begin; i < end; i++)
+                renderer->submit_draw_call(draws[i]);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if(++finished == thread_count) done.notify_one();
+        }
+    }
+
+};
+
+namespace pxl {
+namespace bench {
+
+    int record(const Args& args) {
+        const u32_t draws = (u32_t)args.get("draws", 200000);
+        const u32_t max_threads = (u32_t)args.get("threads", 16);
+        const u64_t frames = args.get("frames", 30);
+        const u64_t warmup = args.get("warmup", 5);
+
+        if(!draws || !max_threads || !frames) {
+            fprintf(stderr, "draws, threads and frames have to be > 0\n");
+            return 1;
+        }
+
+        printf("  %u draws per frame, %llu frames (+%llu warmup), %u hardware threads\n",
+            draws, (unsigned long long)frames, (unsigned long long)warmup, std::thread::hardware_concurrency());
+        printf("  %8s %12s %12s %12s\n", "threads", "record ms", "build ms", "total ms");
+
+        // 1, 2, 4, ... up to --threads, p50s
+        for(u32_t threads = 1; threads <= max_threads; threads *= 2) {
+            EngineConfig config;
+            config.mode = EngineMode::HEADLESS;
+            config.unlocked = true;
+
+            RecordBench app(draws, threads, warmup, frames);
+            Engine engine(app, config);
+            app.set_engine(&engine);
+            engine.start();
+
+            const f64_t record = app.record_ms.percentile(0.5);
+            const f64_t build = app.build_ms.percentile(0.5);
+            printf("  %8u %12.3f %12.3f %12.3f\n", threads, record, build, record + build);
+        }
+
+        return 0;
+    }
+
+};
+};
@@ -0,0 +1,149 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include "core/renderer/pxl_sort_key.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Draw sorting, three ways over the same frame of draws:
+//
+//  DrawCall comparator     what RenderQueue did before sort keys, std::sort of the
+//                          whole DrawCall array by shader then mesh id
+//  key comparator          std::sort of (key, index) pairs, same keys as the radix path
+//  radix                   pxl::sort_key::radix_sort, what build() runs now
+//
+// Only the sort is timed, refilling the input between runs isn't. The radix output is
+// checked against std::stable_sort of the same pairs
+
+struct SortBenchPair {
+    u64_t key;
+    u32_t index;
+};
+
+static bool sort_bench_less(const SortBenchPair& a, const SortBenchPair& b) {
+    return a.key < b.key;
+}
+
+static bool draw_call_less(const DrawCall& a, const DrawCall& b) {
+    if(a.shader_id == b.shader_id)
+        return a.mesh_id < b.mesh_id;
+    return a.shader_id < b.shader_id;
+}
+
+namespace pxl {
+namespace bench {
+
+    int sort(const Args& args) {
+        const u32_t draws = (u32_t)args.get("draws", 100000);
+        const u32_t meshes = std::max<u32_t>(1, (u32_t)args.get("meshes", 64));
+        const u32_t shaders = std::max<u32_t>(1, (u32_t)args.get("shaders", 8));
+        const u32_t runs = std::max<u32_t>(1, (u32_t)args.get("runs", 20));
+
+        printf("  %u draws, %u meshes, %u shaders, 1 in 16 translucent, %u runs\n", draws, meshes, shaders, runs);
+
+        // Same mix as the frame bench, ids start at 1 like the renderer's
+        std::vector<DrawCall> calls(draws);
+        std::vector<u64_t> source_keys(draws);
+
+        for(u32_t i = 0; i < draws; i++) {
+            const u32_t mesh = hash(i * 4 + 0) % meshes;
+            const u32_t shader = hash(i * 4 + 1) % shaders;
+            const u32_t depth = pxl::sort_key::quantize_depth(hash01(i * 4 + 2));
+            const bool translucent = (hash(i * 4 + 3) & 15) == 0;
+
+            calls[i].mesh_id = mesh + 1;
+            calls[i].shader_id = shader + 1;
+            calls[i].transform = scene_transform(i);
+            calls[i].translucent = translucent;
+
+            source_keys[i] = translucent
+                ? pxl::sort_key::make_translucent(0, shader, 0, mesh, depth)
+                : pxl::sort_key::make_opaque(0, shader, 0, mesh, depth);
+        }
+
+        std::vector<DrawCall> work_calls(draws);
+        std::vector<SortBenchPair> pairs(draws);
+        std::vector<u64_t> keys(draws), scratch_keys(draws);
+        std::vector<u32_t> order(draws), scratch_order(draws);
+
+        Samples draw_call_samples, pair_samples, radix_samples;
+
+        for(u32_t run = 0; run < runs; run++) {
+            work_calls = calls;
+            auto start = bench_clock::now();
+            std::sort(work_calls.begin(), work_calls.end(), draw_call_less);
+            draw_call_samples.add(elapsed_ms(start));
+
+            for(u32_t i = 0; i < draws; i++)
+                pairs[i] = { source_keys[i], i };
+            start = bench_clock::now();
+            std::sort(pairs.begin(), pairs.end(), sort_bench_less);
+            pair_samples.add(elapsed_ms(start));
+
+            memcpy(keys.data(), source_keys.data(), draws * sizeof(u64_t));
+            for(u32_t i = 0; i < draws; i++)
+                order[i] = i;
+            start = bench_clock::now();
+            pxl::sort_key::radix_sort(keys.data(), order.data(), scratch_keys.data(), scratch_order.data(), draws);
+            radix_samples.add(elapsed_ms(start));
+        }
+
+        print_samples_header();
+        print_samples("DrawCall comparator", draw_call_samples);
+        print_samples("key comparator", pair_samples);
+        print_samples("radix", radix_samples);
+
+        const f64_t radix_ms = radix_samples.percentile(0.5);
+        if(radix_ms > 0.0) {
+            printf("  radix speedup (p50)    %.1fx over DrawCall comparator, %.1fx over key comparator\n",
+                draw_call_samples.percentile(0.5) / radix_ms, pair_samples.percentile(0.5) / radix_ms);
+        }
+
+        // Radix is stable, so keys and indices both have to match
+        for(u32_t i = 0; i < draws; i++)
+            pairs[i] = { source_keys[i], i };
+        std::stable_sort(pairs.begin(), pairs.end(), sort_bench_less);
+
+        for(u32_t i = 0; i < draws; i++) {
+            if(pairs[i].key != keys[i] || pairs[i].index != order[i]) {
+                printf("  MISMATCH at %u, radix output differs from std::stable_sort\n", i);
+                return 1;
+            }
+        }
+
+        printf("  radix output matches std::stable_sort\n");
+        return 0;
+    }
+
+};
+};
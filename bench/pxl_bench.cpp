@@ -0,0 +1,274 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_bench.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace pxl {
+namespace bench {
+
+    Args::Args(int argc, char** argv, int first) {
+        for(int i = first; i < argc; i++) {
+            const char* arg = argv[i];
+            if(strncmp(arg, "--", 2) != 0) {
+                fprintf(stderr, "ignoring argument %s, options are --key=value\n", arg);
+                continue;
+            }
+
+            arg += 2;
+            const char* equals = strchr(arg, '=');
+            if(equals) values.emplace_back(std::string(arg, equals - arg), std::string(equals + 1));
+            else values.emplace_back(std::string(arg), std::string("1"));
+        }
+    }
+
+    const char* Args::get_str(const char* key, const char* fallback) const {
+        // Last one wins so a run can be tweaked by appending
+        for(auto it = values.rbegin(); it != values.rend(); ++it)
+            if(it->first == key) return it->second.c_str();
+        return fallback;
+    }
+
+    u64_t Args::get(const char* key, u64_t fallback) const {
+        const char* value = get_str(key, nullptr);
+        return value ? strtoull(value, nullptr, 10) : fallback;
+    }
+
+    f64_t Args::get_f64(const char* key, f64_t fallback) const {
+        const char* value = get_str(key, nullptr);
+        return value ? strtod(value, nullptr) : fallback;
+    }
+
+    bool Args::flag(const char* key) const {
+        const char* value = get_str(key, nullptr);
+        return value && value[0] && value[0] != '0';
+    }
+
+    f64_t Samples::average() const {
+        if(values.empty()) return 0.0;
+        f64_t sum = 0.0;
+        for(f64_t value : values) sum += value;
+        return sum / (f64_t)values.size();
+    }
+
+    f64_t Samples::min() const {
+        return values.empty() ? 0.0 : *std::min_element(values.begin(), values.end());
+    }
+
+    f64_t Samples::max() const {
+        return values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+    }
+
+    f64_t Samples::percentile(f64_t p) const {
+        if(values.empty()) return 0.0;
+
+        std::vector<f64_t> sorted = values;
+        size_t rank = (size_t)(p * (f64_t)(sorted.size() - 1) + 0.5);
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+        return sorted[rank];
+    }
+
+    void print_samples_header() {
+        printf("  %-22s %10s %10s %10s %10s\n", "", "avg ms", "p50 ms", "min ms", "max ms");
+    }
+
+    void print_samples(const char* name, const Samples& samples) {
+        printf("  %-22s %10.3f %10.3f %10.3f %10.3f\n", name,
+            samples.average(), samples.percentile(0.5), samples.min(), samples.max());
+    }
+
+    void print_render_stats(const RenderStats& stats) {
+        const f64_t frames = (f64_t)std::max<u64_t>(stats.frames, 1);
+
+        printf("  RenderStats, per frame over %llu frames\n", (unsigned long long)stats.frames);
+
+        auto line = [frames](const char* name, u64_t value) {
+            printf("    %-24s %14.1f\n", name, (f64_t)value / frames);
+        };
+
+        line("draw_calls", stats.draw_calls);
+        line("instances", stats.instances);
+        line("instanced_draws", stats.instanced_draws);
+        line("multi_draws", stats.multi_draws);
+        line("culled", stats.culled);
+        line("triangles", stats.triangles);
+        line("state_changes", stats.state_changes());
+        line("  shader_changes", stats.shader_changes);
+        line("  material_changes", stats.material_changes);
+        line("  mesh_changes", stats.mesh_changes);
+        line("  texture_changes", stats.texture_changes);
+        line("redundant_skipped", stats.redundant_skipped);
+        line("gl_state_calls", stats.gl_state_calls);
+        line("gl_state_calls_avoided", stats.gl_state_calls_avoided);
+        line("uniforms_uploaded", stats.uniforms_uploaded);
+        line("uniforms_skipped", stats.uniforms_skipped);
+        line("uniform_bytes", stats.uniform_bytes);
+
+        printf("    %-24s %14.3f\n", "cull_ms", stats.cull_ms / frames);
+        printf("    %-24s %14.3f\n", "sort_ms", stats.sort_ms / frames);
+        printf("    %-24s %14.3f\n", "build_ms", stats.build_ms / frames);
+        printf("    %-24s %14.3f\n", "execute_ms", stats.execute_ms / frames);
+    }
+
+    Mesh make_box(u32_t detail, u32_t seed) {
+        Mesh mesh;
+        if(detail == 0) detail = 1;
+
+        const glm::vec3 size(
+            0.5f + hash01(seed * 3 + 0),
+            0.5f + hash01(seed * 3 + 1),
+            0.5f + hash01(seed * 3 + 2));
+
+        // normal axis, u axis, v axis per face
+        static const glm::vec3 faces[6][3] = {
+            { {  1, 0, 0 }, { 0, 0, -1 }, { 0, 1, 0 } },
+            { { -1, 0, 0 }, { 0, 0,  1 }, { 0, 1, 0 } },
+            { { 0,  1, 0 }, { 1, 0,  0 }, { 0, 0, -1 } },
+            { { 0, -1, 0 }, { 1, 0,  0 }, { 0, 0,  1 } },
+            { { 0, 0,  1 }, { 1, 0,  0 }, { 0, 1, 0 } },
+            { { 0, 0, -1 }, { -1, 0, 0 }, { 0, 1, 0 } },
+        };
+
+        const u32_t row = detail + 1;
+        for(const auto& face : faces) {
+            const u32_t base = (u32_t)mesh.verticies.size();
+
+            for(u32_t y = 0; y <= detail; y++) {
+                for(u32_t x = 0; x <= detail; x++) {
+                    const f32_t u = (f32_t)x / (f32_t)detail;
+                    const f32_t v = (f32_t)y / (f32_t)detail;
+                    const glm::vec3 p = (face[0] + face[1] * (u * 2.0f - 1.0f) + face[2] * (v * 2.0f - 1.0f)) * size;
+
+                    mesh.verticies.push_back({ p.x, p.y, p.z, u, v, hash01(seed), u, v });
+                }
+            }
+
+            for(u32_t y = 0; y < detail; y++) {
+                for(u32_t x = 0; x < detail; x++) {
+                    const u32_t i = base + y * row + x;
+                    mesh.indices.insert(mesh.indices.end(), { i, i + 1, i + row + 1, i, i + row + 1, i + row });
+                }
+            }
+        }
+
+        return mesh;
+    }
+
+    Camera scene_camera(f32_t aspect) {
+        const glm::vec3 eye(0.0f, 0.0f, 50.0f);
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), aspect, 0.1f, 1000.0f);
+        const glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f, 0.0f, -200.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        Camera camera;
+        camera.view_projection = projection * view;
+        camera.position = eye;
+        camera.far_plane = 1000.0f;
+        camera.projection_scale = projection[1][1];
+        return camera;
+    }
+
+    glm::mat4 scene_transform(u32_t index) {
+        const glm::vec3 position(
+            (hash01(index * 4 + 0) * 2.0f - 1.0f) * 150.0f,
+            (hash01(index * 4 + 1) * 2.0f - 1.0f) * 80.0f,
+            -hash01(index * 4 + 2) * 400.0f);
+
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+        transform = glm::rotate(transform, hash01(index * 4 + 3) * 6.283f, glm::vec3(0.3f, 1.0f, 0.1f));
+        return glm::scale(transform, glm::vec3(0.5f + hash01(index) * 1.5f));
+    }
+
+};
+};
+
+struct BenchEntry {
+    const char* name;
+    int (*run)(const pxl::bench::Args& args);
+    const char* about;
+};
+
+static const BenchEntry entries[] = {
+    { "frame", pxl::bench::frame,
+        "100K draws per frame through a headless Engine, CPU ms per render stage" },
+    { "draws", pxl::bench::draws,
+        "100K draws with per draw constants in the uniform ring, --gl for the GL path" },
+    { "meshes", pxl::bench::meshes,
+        "10K unique meshes drawn once each, --gl --storage=separate|pooled for the GL side" },
+    { "cull", pxl::bench::cull,
+        "1M spheres, SIMD cull_spheres vs scalar, then the queue's cull stage" },
+    { "record", pxl::bench::record,
+        "200K draws recorded from 1 - 16 threads, record and frame build ms" },
+    { "profiler", pxl::bench::profiler,
+        "ns per PXL_PROFILE_SCOPE zone, against the 20 ns budget" },
+    { "logger", pxl::bench::logger,
+        "10M log calls from 8 threads, caller latency p50 / p99 / p99.9" },
+    { "sort", pxl::bench::sort,
+        "100K draws, DrawCall comparator vs key comparator vs radix sort" },
+};
+
+static void print_usage() {
+    printf("usage: PixlBench <name | all> [--key=value ...]\n\n");
+    for(const auto& entry : entries)
+        printf("  %-12s %s\n", entry.name, entry.about);
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        print_usage();
+        return 0;
+    }
+
+    const bool all = strcmp(argv[1], "all") == 0;
+    const pxl::bench::Args args(argc, argv, 2);
+
+    bool found = false;
+    int result = 0;
+    for(const auto& entry : entries) {
+        if(!all && strcmp(argv[1], entry.name) != 0) continue;
+
+        found = true;
+        printf("== %s\n", entry.name);
+        result |= entry.run(args);
+        printf("\n");
+    }
+
+    if(!found) {
+        fprintf(stderr, "unknown benchmark %s\n\n", argv[1]);
+        print_usage();
+        return 1;
+    }
+
+    return result;
+}
@@ -0,0 +1,163 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_BENCH_H
+#define PXL_BENCH_H
+
+#include "misc/utility/types.h"
+#include "core/config.h"
+#include "core/renderer/pxl_renderer.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Benchmark entry points, built into their own executable by `make bench` so the
+// numbers quoted in commits can be reproduced :)*
+//
+//      PixlBench                       lists the benchmarks
+//      PixlBench frame --draws=50000   runs one, options are --key=value
+//      PixlBench all                   runs every one with its defaults
+
+namespace pxl {
+namespace bench {
+
+    using bench_clock = std::chrono::steady_clock;
+
+    inline f64_t elapsed_ms(bench_clock::time_point start) {
+        return std::chrono::duration<f64_t, std::milli>(bench_clock::now() - start).count();
+    }
+
+    class Args {
+
+    private:
+        std::vector<std::pair<std::string, std::string>> values;
+
+    public:
+        Args(int argc, char** argv, int first);
+
+        u64_t get(const char* key, u64_t fallback) const;
+        f64_t get_f64(const char* key, f64_t fallback) const;
+        const char* get_str(const char* key, const char* fallback) const;
+        // --key alone or --key=1
+        bool flag(const char* key) const;
+
+    };
+
+    // Per frame samples of one stage
+    class Samples {
+
+    private:
+        std::vector<f64_t> values;
+
+    public:
+        void add(f64_t value) { values.push_back(value); }
+        size_t size() const { return values.size(); }
+
+        f64_t average() const;
+        f64_t min() const;
+        f64_t max() const;
+        // p in 0..1, nearest rank
+        f64_t percentile(f64_t p) const;
+
+    };
+
+    void print_samples_header();
+    void print_samples(const char* name, const Samples& samples);
+
+    // RenderStats summed over `frames`, printed as per frame averages
+    void print_render_stats(const RenderStats& stats);
+
+    // A closed unit-ish box with `detail` quads per side edge, sizes vary with `seed`
+    // so bounds and triangle counts differ between meshes
+    Mesh make_box(u32_t detail, u32_t seed);
+
+    // Deterministic scrambling, the benches must not depend on rand()
+    inline u32_t hash(u32_t x) {
+        x ^= x >> 16; x *= 0x7feb352du;
+        x ^= x >> 15; x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // 0..1
+    inline f32_t hash01(u32_t x) {
+        return (f32_t)(hash(x) >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Camera looking down -z at the scene volume of scene_transform(), ~a third of
+    // the volume falls outside the frustum
+    Camera scene_camera(f32_t aspect);
+    glm::mat4 scene_transform(u32_t index);
+
+    // One frame bench run, the draws / meshes benches only change the scene
+    struct FrameOptions {
+        u32_t draws = 100000;
+        u32_t meshes = 64;
+        u32_t shaders = 8;
+        u64_t frames = 120;
+        u64_t warmup = 10;
+
+        bool gl = false;                // windowed Engine with GL41Renderer, else headless NullRenderer
+        bool instanced = false;         // shaders read pxl_instance_model, multi draw needs it
+        bool unique_meshes = false;     // draw i uses mesh i % meshes instead of a scrambled one
+        u32_t translucent_every = 16;   // 1 in N draws translucent, 0 = none
+        MeshStorage storage = MeshStorage::SEPARATE;
+    };
+
+    struct FrameResult {
+        Samples submit_ms;
+        Samples cull_ms;
+        Samples sort_ms;
+        Samples build_ms;
+        Samples execute_ms;
+        Samples frame_ms;
+        RenderStats totals;
+    };
+
+    // --draws --meshes --shaders --frames --warmup --gl --instanced --storage=separate|pooled
+    // on top of `defaults`, false when they don't make sense
+    bool frame_options(const Args& args, FrameOptions& options);
+    void print_frame_options(const FrameOptions& options);
+    void run_frames(const FrameOptions& options, FrameResult& result);
+    void print_frame_result(const FrameOptions& options, const FrameResult& result);
+
+    int frame(const Args& args);
+    int draws(const Args& args);
+    int meshes(const Args& args);
+    int cull(const Args& args);
+    int record(const Args& args);
+    int profiler(const Args& args);
+    int logger(const Args& args);
+    int sort(const Args& args);
+
+};
+};
+
+#endif
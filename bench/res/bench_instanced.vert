@@ -0,0 +1,20 @@
+#version 410 core
+
+// Reads the model from the instance attribute, so pooled draws can batch into
+// one multi draw indirect
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec2 uv;
+layout(location = 3) in mat4 pxl_instance_model;
+
+layout(std140) uniform PxlFrame {
+    mat4 pxl_view_projection;
+    vec4 pxl_camera;
+};
+
+out vec3 frag_color;
+
+void main() {
+    frag_color = color;
+    gl_Position = pxl_view_projection * pxl_instance_model * vec4(position, 1.0);
+}
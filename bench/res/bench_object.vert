@@ -0,0 +1,18 @@
+#version 410 core
+
+// One PxlObject block per draw, the uniform ring binds its range
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec2 uv;
+
+layout(std140) uniform PxlObject {
+    mat4 pxl_model;
+    mat4 pxl_model_view_projection;
+};
+
+out vec3 frag_color;
+
+void main() {
+    frag_color = color;
+    gl_Position = pxl_model_view_projection * vec4(position, 1.0);
+}
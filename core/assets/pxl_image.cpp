@@ -0,0 +1,291 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_image.h"
+#include "pxl_texture_container.h"
+
+#include "core/io/pxl_mapped_file.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace pxl {
+namespace image {
+
+    static std::unordered_map<std::string, Decoder>& decoders() {
+        static std::unordered_map<std::string, Decoder> table = {
+            { "tga", decode_tga },
+            { "pxtex", pxl::pxtex::decode }
+        };
+        return table;
+    }
+
+    static std::string lower_extension(const char* path) {
+        const char* dot = std::strrchr(path, '.');
+        std::string extension = dot ? dot + 1 : "";
+        for(char& c : extension) c = (char)std::tolower((unsigned char)c);
+        return extension;
+    }
+
+    void register_decoder(const char* extension, Decoder decoder) {
+        decoders()[lower_extension((std::string(".") + extension).c_str())] = decoder;
+    }
+
+    bool load(const char* path, Image& out) {
+        auto it = decoders().find(lower_extension(path));
+        if(it == decoders().end()) {
+            ERR("No image decoder for: %s", path);
+            return false;
+        }
+
+        MappedFile file;
+        if(!file.open(path)) {
+            ERR("Couldn't read image: %s", path);
+            return false;
+        }
+
+        if(!it->second(file.data(), file.size(), out)) {
+            ERR("Couldn't decode image: %s", path);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool can_map(const char* path) {
+        return lower_extension(path) == "pxtex";
+    }
+
+    bool map(const char* path, MappedFile& file, ImageView& out) {
+        if(!file.open(path)) {
+            ERR("Couldn't read image: %s", path);
+            return false;
+        }
+
+        if(!pxl::pxtex::map(file.data(), file.size(), out)) {
+            ERR("Couldn't decode image: %s", path);
+            file.close();
+            return false;
+        }
+
+        return true;
+    }
+
+    ImageView view(const Image& image) {
+        ImageView result;
+        result.format = image.format;
+        result.levels.reserve(image.levels.size());
+
+        for(const ImageLevel& level : image.levels)
+            result.levels.push_back({ level.width, level.height, level.data.data(), level.data.size() });
+
+        return result;
+    }
+
+    bool decode_tga(const u8_t* file, size_t size, Image& out) {
+        if(size < 18) return false;
+
+        const u8_t* header = file;
+        const u8_t id_length = header[0];
+        const u8_t colormap_type = header[1];
+        const u8_t type = header[2];
+        const u32_t width = header[12] | (header[13] << 8);
+        const u32_t height = header[14] | (header[15] << 8);
+        const u32_t channels = header[16] / 8;
+        const u8_t descriptor = header[17];
+
+        // 2 / 10 truecolor, 3 / 11 grayscale, +8 = RLE. No color mapped ones
+        if(colormap_type != 0 || (type != 2 && type != 3 && type != 10 && type != 11)) return false;
+
+        const bool rle = type >= 10;
+        const bool gray = type == 3 || type == 11;
+
+        if(gray ? channels != 1 : channels != 3 && channels != 4) return false;
+        if(width == 0 || height == 0) return false;
+
+        ImageLevel level;
+        level.width = width;
+        level.height = height;
+        level.data.resize((size_t)width * height * 4);
+
+        auto read_pixel = [&](const u8_t* source, u8_t* target) {
+            if(gray) {
+                target[0] = target[1] = target[2] = source[0];
+                target[3] = 255;
+            } else {
+                target[0] = source[2];
+                target[1] = source[1];
+                target[2] = source[0];
+                target[3] = channels == 4 ? source[3] : 255;
+            }
+        };
+
+        const size_t total = (size_t)width * height;
+        size_t position = 18 + id_length;
+        size_t pixel = 0;
+
+        if(!rle) {
+            if(position + total * channels > size) return false;
+
+            for(; pixel < total; pixel++, position += channels)
+                read_pixel(&file[position], &level.data[pixel * 4]);
+        }
+
+        while(pixel < total) {
+            if(position >= size) return false;
+
+            u8_t packet = file[position++];
+            size_t count = (packet & 0x7f) + 1;
+            if(pixel + count > total) return false;
+
+            if(packet & 0x80) {
+                if(position + channels > size) return false;
+
+                for(size_t i = 0; i < count; i++)
+                    read_pixel(&file[position], &level.data[(pixel + i) * 4]);
+                position += channels;
+            } else {
+                if(position + count * channels > size) return false;
+
+                for(size_t i = 0; i < count; i++, position += channels)
+                    read_pixel(&file[position], &level.data[(pixel + i) * 4]);
+            }
+
+            pixel += count;
+        }
+
+        // Bottom left origin is already what GL wants, flip the top left ones
+        if(descriptor & 0x20) {
+            const size_t row = (size_t)width * 4;
+            for(u32_t y = 0; y < height / 2; y++)
+                std::swap_ranges(
+                    level.data.begin() + y * row, level.data.begin() + (y + 1) * row,
+                    level.data.begin() + (height - 1 - y) * row);
+        }
+
+        out.format = TextureFormat::RGBA8;
+        out.levels.clear();
+        out.levels.push_back(std::move(level));
+
+        return true;
+    }
+
+    size_t level_bytes(TextureFormat format, u32_t width, u32_t height) {
+        const size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+
+        switch(format) {
+            case TextureFormat::RGBA8:      return (size_t)width * height * 4;
+            case TextureFormat::BC1:
+            case TextureFormat::ETC2_RGB8:  return blocks * 8;
+            case TextureFormat::BC3:
+            case TextureFormat::BC5:
+            case TextureFormat::BC7:
+            case TextureFormat::ETC2_RGBA8:
+            case TextureFormat::ASTC_4X4:   return blocks * 16;
+            case TextureFormat::COUNT:      break;
+        }
+        return 0;
+    }
+
+    bool is_compressed(TextureFormat format) {
+        return format != TextureFormat::RGBA8 && format < TextureFormat::COUNT;
+    }
+
+    const char* format_name(TextureFormat format) {
+        switch(format) {
+            case TextureFormat::RGBA8:      return "RGBA8";
+            case TextureFormat::BC1:        return "BC1";
+            case TextureFormat::BC3:        return "BC3";
+            case TextureFormat::BC5:        return "BC5";
+            case TextureFormat::BC7:        return "BC7";
+            case TextureFormat::ETC2_RGB8:  return "ETC2_RGB8";
+            case TextureFormat::ETC2_RGBA8: return "ETC2_RGBA8";
+            case TextureFormat::ASTC_4X4:   return "ASTC_4X4";
+            case TextureFormat::COUNT:      break;
+        }
+        return "unknown";
+    }
+
+    u8_t mip_count(u32_t width, u32_t height) {
+        u32_t size = std::max(width, height);
+        u8_t count = 1;
+        while(size > 1) {
+            size >>= 1;
+            count++;
+        }
+        return count;
+    }
+
+    // Plain 2x2 average in stored (gamma) space, odd edges reuse their last texel
+    bool generate_mips(Image& image) {
+        if(image.format != TextureFormat::RGBA8 || image.levels.empty()) return false;
+
+        image.levels.resize(1);
+
+        const u8_t count = mip_count(image.get_width(), image.get_height());
+
+        for(u8_t i = 1; i < count; i++) {
+            const ImageLevel& source = image.levels[i - 1];
+
+            ImageLevel level;
+            level.width = std::max<u32_t>(source.width / 2, 1);
+            level.height = std::max<u32_t>(source.height / 2, 1);
+            level.data.resize((size_t)level.width * level.height * 4);
+
+            for(u32_t y = 0; y < level.height; y++) {
+                const u32_t y0 = std::min(y * 2, source.height - 1);
+                const u32_t y1 = std::min(y * 2 + 1, source.height - 1);
+
+                for(u32_t x = 0; x < level.width; x++) {
+                    const u32_t x0 = std::min(x * 2, source.width - 1);
+                    const u32_t x1 = std::min(x * 2 + 1, source.width - 1);
+
+                    const u8_t* a = &source.data[((size_t)y0 * source.width + x0) * 4];
+                    const u8_t* b = &source.data[((size_t)y0 * source.width + x1) * 4];
+                    const u8_t* c = &source.data[((size_t)y1 * source.width + x0) * 4];
+                    const u8_t* d = &source.data[((size_t)y1 * source.width + x1) * 4];
+                    u8_t* target = &level.data[((size_t)y * level.width + x) * 4];
+
+                    for(u32_t channel = 0; channel < 4; channel++)
+                        target[channel] = (u8_t)((a[channel] + b[channel] + c[channel] + d[channel] + 2) / 4);
+                }
+            }
+
+            image.levels.push_back(std::move(level));
+        }
+
+        return true;
+    }
+
+};
+};
@@ -0,0 +1,122 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_IMAGE_H
+#define PXL_IMAGE_H
+
+#include "misc/utility/types.h"
+
+#include <cstddef>
+#include <vector>
+
+// CPU side images for the TextureManager. Levels are finest first, rows bottom up
+// like GL wants them and tightly packed in the image's format
+
+// Values are stored in .pxtex files, only ever append
+enum class TextureFormat : u8_t {
+    RGBA8       = 0,
+    BC1         = 1,    // RGB, 4 bpp
+    BC3         = 2,    // RGBA, 8 bpp
+    BC5         = 3,    // two channels (normal maps), 8 bpp
+    BC7         = 4,    // RGBA, 8 bpp, best quality
+    ETC2_RGB8   = 5,    // mobile / GLES targets, no encoder here, the container carries them
+    ETC2_RGBA8  = 6,
+    ASTC_4X4    = 7,
+    COUNT
+};
+
+struct ImageLevel {
+    u32_t width = 0;
+    u32_t height = 0;
+    std::vector<u8_t> data;
+};
+
+struct Image {
+    TextureFormat format = TextureFormat::RGBA8;
+    std::vector<ImageLevel> levels;
+
+    u32_t get_width() const { return levels.empty() ? 0 : levels[0].width; }
+    u32_t get_height() const { return levels.empty() ? 0 : levels[0].height; }
+};
+
+// Levels that live somewhere else (an Image, a mapped .pxtex), nothing is owned
+struct ImageLevelView {
+    u32_t width = 0;
+    u32_t height = 0;
+    const u8_t* data = nullptr;
+    size_t size = 0;
+};
+
+struct ImageView {
+    TextureFormat format = TextureFormat::RGBA8;
+    std::vector<ImageLevelView> levels;
+
+    u32_t get_width() const { return levels.empty() ? 0 : levels[0].width; }
+    u32_t get_height() const { return levels.empty() ? 0 : levels[0].height; }
+};
+
+class MappedFile;
+
+namespace pxl {
+namespace image {
+
+    // Decoders get the whole file (mapped, not read), they're looked up by extension
+    // (no dot, any case)
+    using Decoder = bool (*)(const u8_t* file, size_t size, Image& out);
+
+    // Register at startup, load() runs on job workers and doesn't lock the table.
+    // "tga" (truecolor / grayscale, RLE or not) and "pxtex" (pxl_texture_container.h)
+    // are built in
+    void register_decoder(const char* extension, Decoder decoder);
+    bool load(const char* path, Image& out);
+
+    // Files already in their GPU format (.pxtex) can skip decoding: map() opens
+    // `file` and points `out` at the levels inside it. Only for can_map() paths,
+    // the view is good while `file` stays open
+    bool can_map(const char* path);
+    bool map(const char* path, MappedFile& file, ImageView& out);
+
+    // Points at the image's levels, good until the image changes
+    ImageView view(const Image& image);
+
+    bool decode_tga(const u8_t* file, size_t size, Image& out);
+
+    size_t level_bytes(TextureFormat format, u32_t width, u32_t height);
+    // 4x4 block formats, everything but RGBA8
+    bool is_compressed(TextureFormat format);
+    const char* format_name(TextureFormat format);
+    u8_t mip_count(u32_t width, u32_t height);
+
+    // Box filters the rest of the chain from level 0, RGBA8 only
+    bool generate_mips(Image& image);
+
+};
+};
+
+#endif
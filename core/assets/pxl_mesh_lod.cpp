@@ -0,0 +1,377 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_mesh_lod.h"
+
+#include "core/renderer/pxl_culling.h"
+#include "core/debug/pxl_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace pxl {
+namespace lod {
+
+    // Symmetric 4x4 error matrix, upper triangle only. Doubles, floats run out of
+    // precision summing up thousands of planes
+    struct Quadric {
+        f64_t a2, ab, ac, ad;
+        f64_t b2, bc, bd;
+        f64_t c2, cd;
+        f64_t d2;
+        f64_t weight;
+    };
+
+    struct Collapse {
+        u32_t from;
+        u32_t to;
+        f64_t cost;     // squared distance
+    };
+
+    struct PositionKey {
+        u32_t x, y, z;
+        bool operator==(const PositionKey& other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct PositionHash {
+        size_t operator()(const PositionKey& key) const {
+            u64_t hash = key.x * 0x9e3779b97f4a7c15ull;
+            hash ^= key.y + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+            hash ^= key.z + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+            return (size_t)hash;
+        }
+    };
+
+    static void add_plane(Quadric& q, f64_t a, f64_t b, f64_t c, f64_t d, f64_t weight) {
+        q.a2 += weight * a * a; q.ab += weight * a * b; q.ac += weight * a * c; q.ad += weight * a * d;
+        q.b2 += weight * b * b; q.bc += weight * b * c; q.bd += weight * b * d;
+        q.c2 += weight * c * c; q.cd += weight * c * d;
+        q.d2 += weight * d * d;
+        q.weight += weight;
+    }
+
+    static Quadric combine(const Quadric& a, const Quadric& b) {
+        return {
+            a.a2 + b.a2, a.ab + b.ab, a.ac + b.ac, a.ad + b.ad,
+            a.b2 + b.b2, a.bc + b.bc, a.bd + b.bd,
+            a.c2 + b.c2, a.cd + b.cd,
+            a.d2 + b.d2,
+            a.weight + b.weight
+        };
+    }
+
+    // Area weighted squared distance of the vertex to the quadric's planes
+    static f64_t evaluate(const Quadric& q, const Vertex& v) {
+        f64_t x = v.x, y = v.y, z = v.z;
+
+        f64_t error =
+              q.a2 * x * x + 2.0 * q.ab * x * y + 2.0 * q.ac * x * z + 2.0 * q.ad * x
+            + q.b2 * y * y + 2.0 * q.bc * y * z + 2.0 * q.bd * y
+            + q.c2 * z * z + 2.0 * q.cd * z
+            + q.d2;
+
+        return q.weight > 0.0 ? std::max(error, 0.0) / q.weight : 0.0;
+    }
+
+    static glm::dvec3 position(const Vertex& v) {
+        return glm::dvec3(v.x, v.y, v.z);
+    }
+
+    static u32_t float_bits(f32_t value) {
+        u32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Moving `from` onto `to` must not turn any remaining triangle around
+    static bool flips(
+        const std::vector<Vertex>& vertices, const std::vector<u32_t>& triangles,
+        const std::vector<u32_t>& positions,
+        const u32_t* around, u32_t around_count, u32_t from, u32_t to
+    ) {
+        glm::dvec3 target = position(vertices[to]);
+
+        for(u32_t i = 0; i < around_count; i++) {
+            const u32_t* triangle = &triangles[around[i] * 3];
+
+            // Triangles on the collapsed edge go away anyway
+            if(positions[triangle[0]] == positions[to]
+                || positions[triangle[1]] == positions[to]
+                || positions[triangle[2]] == positions[to])
+                continue;
+
+            glm::dvec3 corners[3];
+            glm::dvec3 moved[3];
+            for(u32_t c = 0; c < 3; c++) {
+                corners[c] = position(vertices[triangle[c]]);
+                moved[c] = triangle[c] == from ? target : corners[c];
+            }
+
+            glm::dvec3 before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            glm::dvec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+
+            // Also rejects triangles that would get folded nearly flat
+            f64_t limit = 0.25 * glm::length(before) * glm::length(after);
+            if(glm::dot(before, after) <= limit) return true;
+        }
+
+        return false;
+    }
+
+    std::vector<u32_t> simplify(
+        const std::vector<Vertex>& vertices, const std::vector<u32_t>& indices,
+        size_t target_index_count, f32_t max_error, f32_t* out_error
+    ) {
+        PXL_PROFILE_FUNCTION();
+
+        const u32_t vertex_count = (u32_t)vertices.size();
+        std::vector<u32_t> result(indices.begin(), indices.end() - indices.size() % 3);
+
+        f32_t result_error = 0.0f;
+        if(out_error) *out_error = 0.0f;
+        if(result.size() <= target_index_count || vertex_count == 0) return result;
+
+        // Weld by exact position, seams share a quadric and get locked
+        std::vector<u32_t> positions(vertex_count);
+        std::vector<u32_t> group_size;
+        {
+            std::unordered_map<PositionKey, u32_t, PositionHash> lookup;
+            lookup.reserve(vertex_count);
+
+            for(u32_t v = 0; v < vertex_count; v++) {
+                PositionKey key = {
+                    float_bits(vertices[v].x), float_bits(vertices[v].y), float_bits(vertices[v].z) };
+                auto it = lookup.emplace(key, (u32_t)group_size.size()).first;
+                if(it->second == group_size.size()) group_size.push_back(0);
+
+                positions[v] = it->second;
+                group_size[it->second]++;
+            }
+        }
+
+        const u32_t position_count = (u32_t)group_size.size();
+        std::vector<Quadric> quadrics(position_count, Quadric {});
+        std::vector<u8_t> locked(position_count, 0);
+
+        for(u32_t p = 0; p < position_count; p++)
+            locked[p] = group_size[p] > 1;
+
+        // Borders: a directed edge with no twin going the other way
+        {
+            std::unordered_map<u64_t, u32_t> edges;
+            edges.reserve(result.size());
+
+            for(size_t i = 0; i < result.size(); i += 3) {
+                for(u32_t e = 0; e < 3; e++) {
+                    u64_t a = positions[result[i + e]];
+                    u64_t b = positions[result[i + (e + 1) % 3]];
+                    edges[(a << 32) | b]++;
+                }
+            }
+
+            for(const auto& edge : edges) {
+                u64_t a = edge.first >> 32;
+                u64_t b = edge.first & 0xffffffffull;
+                if(edges.find((b << 32) | a) == edges.end()) {
+                    locked[a] = 1;
+                    locked[b] = 1;
+                }
+            }
+        }
+
+        for(size_t i = 0; i < result.size(); i += 3) {
+            glm::dvec3 p0 = position(vertices[result[i]]);
+            glm::dvec3 p1 = position(vertices[result[i + 1]]);
+            glm::dvec3 p2 = position(vertices[result[i + 2]]);
+
+            glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+            f64_t length = glm::length(normal);
+            if(length <= 0.0) continue;
+
+            normal /= length;
+            f64_t d = -glm::dot(normal, p0);
+
+            for(u32_t c = 0; c < 3; c++)
+                add_plane(quadrics[positions[result[i + c]]], normal.x, normal.y, normal.z, d, length * 0.5);
+        }
+
+        const f64_t max_error_squared = (f64_t)max_error * max_error;
+
+        std::vector<Collapse> collapses;
+        std::vector<u32_t> remap(vertex_count);
+        std::vector<u8_t> touched(vertex_count);
+        std::vector<u32_t> around_offsets(vertex_count + 1);
+        std::vector<u32_t> around;
+
+        // Passes of independent collapses, cheapest first. A collapse touches every
+        // vertex around it so the rest of the pass only sees up to date triangles
+        while(result.size() > target_index_count) {
+            const u32_t triangle_count = (u32_t)(result.size() / 3);
+
+            std::fill(around_offsets.begin(), around_offsets.end(), 0);
+            for(u32_t index : result) around_offsets[index + 1]++;
+            for(u32_t v = 0; v < vertex_count; v++) around_offsets[v + 1] += around_offsets[v];
+
+            around.resize(result.size());
+            {
+                std::vector<u32_t> fill(around_offsets.begin(), around_offsets.end() - 1);
+                for(u32_t t = 0; t < triangle_count; t++)
+                    for(u32_t c = 0; c < 3; c++)
+                        around[fill[result[t * 3 + c]]++] = t;
+            }
+
+            collapses.clear();
+            for(u32_t t = 0; t < triangle_count; t++) {
+                for(u32_t e = 0; e < 3; e++) {
+                    u32_t a = result[t * 3 + e];
+                    u32_t b = result[t * 3 + (e + 1) % 3];
+
+                    // Only single vertex positions move, both ways round
+                    Quadric edge_quadric = combine(quadrics[positions[a]], quadrics[positions[b]]);
+                    if(!locked[positions[a]]) collapses.push_back({ a, b, evaluate(edge_quadric, vertices[b]) });
+                    if(!locked[positions[b]]) collapses.push_back({ b, a, evaluate(edge_quadric, vertices[a]) });
+                }
+            }
+
+            if(collapses.empty()) break;
+
+            std::sort(collapses.begin(), collapses.end(),
+                [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+            for(u32_t v = 0; v < vertex_count; v++) remap[v] = v;
+            std::fill(touched.begin(), touched.end(), 0);
+
+            // A collapse usually removes two triangles
+            const size_t target_triangles = target_index_count / 3;
+            size_t remaining = triangle_count;
+            u32_t applied = 0;
+
+            for(const Collapse& collapse : collapses) {
+                if(remaining <= target_triangles) break;
+                if(collapse.cost > max_error_squared) break;
+                if(touched[collapse.from] || touched[collapse.to]) continue;
+
+                const u32_t* from_around = &around[around_offsets[collapse.from]];
+                u32_t from_around_count = around_offsets[collapse.from + 1] - around_offsets[collapse.from];
+
+                if(flips(vertices, result, positions, from_around, from_around_count, collapse.from, collapse.to))
+                    continue;
+
+                remap[collapse.from] = collapse.to;
+
+                Quadric& target = quadrics[positions[collapse.to]];
+                target = combine(target, quadrics[positions[collapse.from]]);
+
+                for(u32_t i = 0; i < from_around_count; i++) {
+                    const u32_t* triangle = &result[from_around[i] * 3];
+                    touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+                }
+
+                result_error = std::max(result_error, (f32_t)std::sqrt(collapse.cost));
+                remaining = remaining > 2 ? remaining - 2 : 0;
+                applied++;
+            }
+
+            if(!applied) break;
+
+            // Rewrite, dropping the triangles that lost an edge
+            size_t write = 0;
+            for(size_t i = 0; i < result.size(); i += 3) {
+                u32_t a = remap[result[i]];
+                u32_t b = remap[result[i + 1]];
+                u32_t c = remap[result[i + 2]];
+
+                if(positions[a] == positions[b] || positions[b] == positions[c] || positions[a] == positions[c])
+                    continue;
+
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+
+            result.resize(write);
+        }
+
+        if(out_error) *out_error = result_error;
+        return result;
+    }
+
+    u8_t generate(Mesh& mesh, u8_t max_lods, f32_t ratio, f32_t max_error) {
+        PXL_PROFILE_FUNCTION();
+
+        if(mesh.indices.empty() || mesh.verticies.empty()) return 0;
+        max_lods = (u8_t)std::min<u32_t>(max_lods, PXL_MAX_MESH_LODS);
+
+        // Regenerating starts over from the finest level
+        if(mesh.lod_count > 0) mesh.indices.resize(mesh.lods[0].index_count);
+
+        Bounds bounds = mesh.bounds.radius >= 0.0f
+            ? mesh.bounds
+            : pxl::culling::compute_bounds(mesh.verticies);
+
+        const std::vector<u32_t> base = mesh.indices;
+
+        mesh.lods[0] = { 0, (u32_t)base.size(), 0.0f };
+        mesh.lod_count = 1;
+
+        size_t previous = base.size();
+        f32_t previous_error = 0.0f;
+
+        // Every level is simplified from the full mesh so errors don't pile up
+        for(u8_t i = 1; i < max_lods; i++) {
+            size_t target = (size_t)(previous * ratio) / 3 * 3;
+            if(target < 3) break;
+
+            f32_t error = 0.0f;
+            std::vector<u32_t> indices = simplify(
+                mesh.verticies, base, target, max_error * bounds.radius, &error);
+
+            // Locked borders or the error limit stopped it, not worth another range
+            if(indices.empty() || indices.size() * 10 > previous * 9) break;
+
+            MeshLod& level = mesh.lods[i];
+            level.first_index = (u32_t)mesh.indices.size();
+            level.index_count = (u32_t)indices.size();
+            level.error = std::max(error, previous_error);
+
+            mesh.indices.insert(mesh.indices.end(), indices.begin(), indices.end());
+            mesh.lod_count++;
+
+            previous = indices.size();
+            previous_error = level.error;
+        }
+
+        return mesh.lod_count;
+    }
+
+};
+};
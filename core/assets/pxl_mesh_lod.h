@@ -0,0 +1,62 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_MESH_LOD_H
+#define PXL_MESH_LOD_H
+
+#include "core/renderer/pxl_renderer_backend.h"
+
+// Offline LOD chain generation, run it when loading / baking assets, not per frame.
+//
+// The simplifier collapses edges in quadric error order (Garland / Heckbert) onto
+// existing vertices, so uvs and colors never get interpolated. Vertices on open
+// borders and on attribute seams (same position, different vertex) are locked,
+// which keeps silhouettes and texture layouts intact at the cost of reducing
+// seam heavy meshes less
+
+namespace pxl {
+namespace lod {
+
+    // Triangle list over `vertices` reduced to about target_index_count indices.
+    // Stops early once a collapse would move the surface more than max_error
+    // (object space). out_error gets the largest error actually introduced
+    std::vector<u32_t> simplify(
+        const std::vector<Vertex>& vertices, const std::vector<u32_t>& indices,
+        size_t target_index_count, f32_t max_error, f32_t* out_error = nullptr);
+
+    // Appends up to max_lods - 1 simplified index lists behind mesh.indices, each
+    // about `ratio` of the one before, and fills mesh.lods. max_error is relative to
+    // the bounding radius. Stops when a level barely shrinks. Returns the LOD count
+    u8_t generate(
+        Mesh& mesh, u8_t max_lods = PXL_MAX_MESH_LODS,
+        f32_t ratio = 0.5f, f32_t max_error = 0.1f);
+
+};
+};
+
+#endif
@@ -0,0 +1,542 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_mesh_optimize.h"
+
+#include "core/renderer/pxl_culling.h"
+#include "core/debug/pxl_profiler.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Forsyth keeps a bigger cache model than the analyzer, the scores only need the
+// recency ordering to be right
+#define PXL_FORSYTH_CACHE_SIZE 32
+
+namespace pxl {
+namespace optimize {
+
+    // Old index -> new index (~0u drops the vertex), applied to every vertex stream and the indices
+    static void remap_vertices(Mesh& mesh, const std::vector<u32_t>& remap, u32_t new_count) {
+        const size_t old_count = remap.size();
+
+        if(!mesh.verticies.empty()) {
+            std::vector<Vertex> vertices(new_count);
+            for(size_t v = 0; v < old_count; v++)
+                if(remap[v] != ~0u) vertices[remap[v]] = mesh.verticies[v];
+            mesh.verticies = std::move(vertices);
+        }
+
+        if(mesh.is_quantized()) {
+            const u32_t stride = mesh.layout.stride;
+            std::vector<u8_t> data((size_t)new_count * stride);
+            for(size_t v = 0; v < old_count; v++)
+                if(remap[v] != ~0u)
+                    std::memcpy(&data[(size_t)remap[v] * stride], &mesh.vertex_data[v * stride], stride);
+            mesh.vertex_data = std::move(data);
+        }
+
+        for(u32_t& index : mesh.indices) index = remap[index];
+    }
+
+    u64_t weld(Mesh& mesh) {
+        PXL_PROFILE_FUNCTION();
+
+        const size_t count = mesh.get_vertex_count();
+        const bool has_f32 = !mesh.verticies.empty();
+        const bool has_packed = mesh.is_quantized();
+        const u32_t stride = mesh.layout.stride;
+
+        if(has_f32 && has_packed && mesh.verticies.size() != count) {
+            ERR("f32 and packed vertex counts differ, not welding");
+            return 0;
+        }
+
+        auto hash_vertex = [&](size_t v) {
+            u64_t hash = 0xcbf29ce484222325ull;
+            auto mix = [&hash](const u8_t* bytes, size_t size) {
+                for(size_t i = 0; i < size; i++) {
+                    hash ^= bytes[i];
+                    hash *= 0x100000001b3ull;
+                }
+            };
+
+            if(has_f32) mix((const u8_t*)&mesh.verticies[v], sizeof(Vertex));
+            if(has_packed) mix(&mesh.vertex_data[v * stride], stride);
+            return hash;
+        };
+
+        auto same_vertex = [&](size_t a, size_t b) {
+            if(has_f32 && std::memcmp(&mesh.verticies[a], &mesh.verticies[b], sizeof(Vertex)) != 0) return false;
+            if(has_packed && std::memcmp(&mesh.vertex_data[a * stride], &mesh.vertex_data[b * stride], stride) != 0) return false;
+            return true;
+        };
+
+        // Open addressing over vertex indices, at most half full
+        size_t table_size = 1;
+        while(table_size < count * 2) table_size *= 2;
+        std::vector<u32_t> table(table_size, ~0u);
+
+        std::vector<u32_t> remap(count);
+        u32_t unique = 0;
+        std::vector<u32_t> first_of;        // new index -> old index
+
+        for(size_t v = 0; v < count; v++) {
+            size_t slot = hash_vertex(v) & (table_size - 1);
+
+            while(table[slot] != ~0u && !same_vertex(first_of[table[slot]], v))
+                slot = (slot + 1) & (table_size - 1);
+
+            if(table[slot] == ~0u) {
+                table[slot] = unique++;
+                first_of.push_back((u32_t)v);
+            }
+
+            remap[v] = table[slot];
+        }
+
+        if(unique == count) return 0;
+
+        remap_vertices(mesh, remap, unique);
+        return count - unique;
+    }
+
+    static f32_t forsyth_score(s32_t cache_position, u32_t live_triangles) {
+        if(live_triangles == 0) return -1.0f;
+
+        f32_t score = 0.0f;
+        if(cache_position >= 0) {
+            // The triangle just drawn is in the cache either way, no bonus for its corners
+            score = cache_position < 3
+                ? 0.75f
+                : std::pow(1.0f - (f32_t)(cache_position - 3) / (PXL_FORSYTH_CACHE_SIZE - 3), 1.5f);
+        }
+
+        // Vertices with few triangles left get finished first, so they don't linger
+        return score + 2.0f / std::sqrt((f32_t)live_triangles);
+    }
+
+    void vertex_cache(u32_t* indices, size_t index_count, u32_t vertex_count) {
+        PXL_PROFILE_FUNCTION();
+
+        const u32_t triangle_count = (u32_t)(index_count / 3);
+        if(triangle_count < 2) return;
+
+        // Vertex -> triangles still to be emitted, swap removed from the front of each range
+        std::vector<u32_t> live(vertex_count, 0);
+        for(size_t i = 0; i < triangle_count * 3; i++) live[indices[i]]++;
+
+        std::vector<u32_t> offsets(vertex_count + 1, 0);
+        for(u32_t v = 0; v < vertex_count; v++) offsets[v + 1] = offsets[v] + live[v];
+
+        std::vector<u32_t> adjacency(triangle_count * 3);
+        {
+            std::vector<u32_t> fill(offsets.begin(), offsets.end() - 1);
+            for(u32_t t = 0; t < triangle_count; t++)
+                for(u32_t c = 0; c < 3; c++)
+                    adjacency[fill[indices[t * 3 + c]]++] = t;
+        }
+
+        std::vector<s32_t> cache_position(vertex_count, -1);
+        std::vector<f32_t> vertex_score(vertex_count);
+        for(u32_t v = 0; v < vertex_count; v++) vertex_score[v] = forsyth_score(-1, live[v]);
+
+        std::vector<f32_t> triangle_score(triangle_count);
+        for(u32_t t = 0; t < triangle_count; t++)
+            triangle_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+
+        std::vector<u8_t> emitted(triangle_count, 0);
+        std::vector<u32_t> result(triangle_count * 3);
+
+        u32_t cache[PXL_FORSYTH_CACHE_SIZE + 3];
+        u32_t cache_count = 0;
+
+        s32_t best = -1;
+        u32_t cursor = 0;
+
+        for(u32_t out = 0; out < triangle_count; out++) {
+            // Nothing in the cache has triangles left, start over at the next unused one
+            if(best < 0) {
+                while(emitted[cursor]) cursor++;
+                best = (s32_t)cursor;
+            }
+
+            const u32_t* triangle = &indices[best * 3];
+            std::memcpy(&result[out * 3], triangle, 3 * sizeof(u32_t));
+            emitted[best] = 1;
+
+            for(u32_t c = 0; c < 3; c++) {
+                u32_t v = triangle[c];
+                u32_t* list = &adjacency[offsets[v]];
+
+                for(u32_t i = 0; i < live[v]; i++) {
+                    if(list[i] == (u32_t)best) {
+                        list[i] = list[live[v] - 1];
+                        break;
+                    }
+                }
+                live[v]--;
+            }
+
+            // Triangle corners move to the front, the rest shifts back
+            u32_t next_cache[PXL_FORSYTH_CACHE_SIZE + 3];
+            u32_t next_count = 0;
+
+            for(u32_t c = 0; c < 3; c++) next_cache[next_count++] = triangle[c];
+            for(u32_t i = 0; i < cache_count; i++) {
+                u32_t v = cache[i];
+                if(v != triangle[0] && v != triangle[1] && v != triangle[2])
+                    next_cache[next_count++] = v;
+            }
+
+            for(u32_t i = 0; i < next_count; i++) {
+                u32_t v = next_cache[i];
+                cache_position[v] = i < PXL_FORSYTH_CACHE_SIZE ? (s32_t)i : -1;
+
+                f32_t score = forsyth_score(cache_position[v], live[v]);
+                f32_t delta = score - vertex_score[v];
+                vertex_score[v] = score;
+
+                for(u32_t j = 0; j < live[v]; j++)
+                    triangle_score[adjacency[offsets[v] + j]] += delta;
+            }
+
+            best = -1;
+            f32_t best_score = -1.0f;
+
+            cache_count = std::min<u32_t>(next_count, PXL_FORSYTH_CACHE_SIZE);
+            for(u32_t i = 0; i < cache_count; i++) {
+                u32_t v = next_cache[i];
+                cache[i] = v;
+
+                for(u32_t j = 0; j < live[v]; j++) {
+                    u32_t t = adjacency[offsets[v] + j];
+                    if(triangle_score[t] > best_score) {
+                        best_score = triangle_score[t];
+                        best = (s32_t)t;
+                    }
+                }
+            }
+        }
+
+        std::memcpy(indices, result.data(), triangle_count * 3 * sizeof(u32_t));
+    }
+
+    // FIFO cache through timestamps: a vertex is cached while fewer than cache_size
+    // misses happened since it was loaded
+    struct CacheSimulation {
+        std::vector<u32_t> stamps;
+        u32_t time;
+        u32_t cache_size;
+
+        CacheSimulation(u32_t vertex_count, u32_t cache_size) :
+            stamps(vertex_count, 0), time(cache_size + 1), cache_size(cache_size) {}
+
+        void reset() { time += cache_size + 1; }
+
+        u32_t triangle(const u32_t* triangle) {
+            u32_t misses = 0;
+            for(u32_t c = 0; c < 3; c++) {
+                u32_t v = triangle[c];
+                if(time - stamps[v] > cache_size) {
+                    stamps[v] = time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+    };
+
+    VertexCacheStats analyze_vertex_cache(const u32_t* indices, size_t index_count, u32_t vertex_count, u32_t cache_size) {
+        VertexCacheStats stats;
+        const size_t triangle_count = index_count / 3;
+        if(triangle_count == 0) return stats;
+
+        CacheSimulation cache(vertex_count, cache_size);
+        std::vector<u8_t> referenced(vertex_count, 0);
+
+        u64_t misses = 0;
+        u64_t unique = 0;
+        for(size_t t = 0; t < triangle_count; t++) {
+            misses += cache.triangle(&indices[t * 3]);
+            for(u32_t c = 0; c < 3; c++) {
+                u32_t v = indices[t * 3 + c];
+                unique += referenced[v] == 0;
+                referenced[v] = 1;
+            }
+        }
+
+        stats.acmr = (f32_t)misses / (f32_t)triangle_count;
+        stats.atvr = unique ? (f32_t)misses / (f32_t)unique : 0.0f;
+        return stats;
+    }
+
+    static glm::vec3 position(const Vertex& v) {
+        return glm::vec3(v.x, v.y, v.z);
+    }
+
+    void overdraw(u32_t* indices, size_t index_count, const std::vector<Vertex>& vertices, f32_t threshold) {
+        PXL_PROFILE_FUNCTION();
+
+        const u32_t triangle_count = (u32_t)(index_count / 3);
+        const u32_t vertex_count = (u32_t)vertices.size();
+        if(triangle_count < 2 || vertex_count == 0) return;
+
+        // Hard boundaries: all three corners miss, the cache is cold there anyway
+        std::vector<u32_t> hard;
+        {
+            CacheSimulation cache(vertex_count, PXL_VERTEX_CACHE_SIZE);
+            for(u32_t t = 0; t < triangle_count; t++)
+                if(cache.triangle(&indices[t * 3]) == 3) hard.push_back(t);
+        }
+        if(hard.empty() || hard[0] != 0) hard.insert(hard.begin(), 0);
+        hard.push_back(triangle_count);
+
+        // Soft boundaries inside each: wherever the cluster so far is already within
+        // threshold of the whole hard cluster's ACMR, a restart costs little
+        std::vector<u32_t> clusters;
+        CacheSimulation cache(vertex_count, PXL_VERTEX_CACHE_SIZE);
+
+        for(size_t h = 0; h + 1 < hard.size(); h++) {
+            u32_t begin = hard[h];
+            u32_t end = hard[h + 1];
+
+            cache.reset();
+            u32_t hard_misses = 0;
+            for(u32_t t = begin; t < end; t++) hard_misses += cache.triangle(&indices[t * 3]);
+            f32_t hard_acmr = (f32_t)hard_misses / (f32_t)(end - begin);
+
+            clusters.push_back(begin);
+
+            cache.reset();
+            u32_t start = begin;
+            u32_t misses = 0;
+
+            for(u32_t t = begin; t < end; t++) {
+                misses += cache.triangle(&indices[t * 3]);
+
+                u32_t size = t + 1 - start;
+                if(t + 1 < end && size >= 8 && (f32_t)misses / (f32_t)size <= hard_acmr * threshold) {
+                    clusters.push_back(t + 1);
+                    cache.reset();
+                    start = t + 1;
+                    misses = 0;
+                }
+            }
+        }
+        clusters.push_back(triangle_count);
+
+        // Area weighted centroid of the mesh and of every cluster
+        const u32_t cluster_count = (u32_t)clusters.size() - 1;
+        std::vector<glm::vec3> cluster_center(cluster_count, glm::vec3(0.0f));
+        std::vector<glm::vec3> cluster_normal(cluster_count, glm::vec3(0.0f));
+        std::vector<f32_t> cluster_area(cluster_count, 0.0f);
+
+        glm::vec3 mesh_center(0.0f);
+        f32_t mesh_area = 0.0f;
+
+        for(u32_t c = 0; c < cluster_count; c++) {
+            for(u32_t t = clusters[c]; t < clusters[c + 1]; t++) {
+                glm::vec3 p0 = position(vertices[indices[t * 3]]);
+                glm::vec3 p1 = position(vertices[indices[t * 3 + 1]]);
+                glm::vec3 p2 = position(vertices[indices[t * 3 + 2]]);
+
+                glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                f32_t area = glm::length(normal);
+                glm::vec3 center = (p0 + p1 + p2) * (area / 3.0f);
+
+                cluster_center[c] += center;
+                cluster_normal[c] += normal;
+                cluster_area[c] += area;
+
+                mesh_center += center;
+                mesh_area += area;
+            }
+        }
+
+        if(mesh_area > 0.0f) mesh_center /= mesh_area;
+
+        // Further out along its own normal = more likely to cover the others
+        std::vector<f32_t> keys(cluster_count, 0.0f);
+        for(u32_t c = 0; c < cluster_count; c++) {
+            if(cluster_area[c] <= 0.0f) continue;
+
+            glm::vec3 center = cluster_center[c] / cluster_area[c];
+            f32_t length = glm::length(cluster_normal[c]);
+            if(length > 0.0f)
+                keys[c] = glm::dot(center - mesh_center, cluster_normal[c] / length);
+        }
+
+        std::vector<u32_t> order(cluster_count);
+        for(u32_t c = 0; c < cluster_count; c++) order[c] = c;
+        std::stable_sort(order.begin(), order.end(),
+            [&keys](u32_t a, u32_t b) { return keys[a] > keys[b]; });
+
+        std::vector<u32_t> result;
+        result.reserve(triangle_count * 3);
+        for(u32_t c : order)
+            result.insert(result.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3);
+
+        std::memcpy(indices, result.data(), result.size() * sizeof(u32_t));
+    }
+
+    void vertex_fetch(Mesh& mesh) {
+        PXL_PROFILE_FUNCTION();
+
+        const size_t count = mesh.get_vertex_count();
+        std::vector<u32_t> remap(count, ~0u);
+        u32_t next = 0;
+
+        for(u32_t index : mesh.indices)
+            if(remap[index] == ~0u) remap[index] = next++;
+
+        // Unreferenced vertices fall off the end
+        remap_vertices(mesh, remap, next);
+    }
+
+    std::vector<Mesh> split(const Mesh& mesh, u32_t max_vertices) {
+        PXL_PROFILE_FUNCTION();
+
+        std::vector<Mesh> parts;
+
+        const u32_t vertex_count = (u32_t)mesh.get_vertex_count();
+        const size_t index_count = mesh.lod_count ? mesh.lods[0].index_count : mesh.indices.size();
+        if(index_count < 3 || vertex_count == 0 || max_vertices < 3) return parts;
+
+        const bool has_f32 = !mesh.verticies.empty();
+        const bool has_packed = mesh.is_quantized();
+        const u32_t stride = mesh.layout.stride;
+
+        // Old index -> index in the current part, valid while stamp matches the part
+        std::vector<u32_t> remap(vertex_count);
+        std::vector<u32_t> stamp(vertex_count, ~0u);
+
+        auto begin_part = [&]() {
+            Mesh part;
+            part.textures = mesh.textures;
+            part.layout = mesh.layout;
+            part.position_scale = mesh.position_scale;
+            part.position_offset = mesh.position_offset;
+            parts.push_back(std::move(part));
+        };
+
+        auto finish_part = [&]() {
+            Mesh& part = parts.back();
+            part.bounds = has_f32 ? pxl::culling::compute_bounds(part.verticies) : mesh.bounds;
+        };
+
+        begin_part();
+        u32_t part_vertices = 0;
+
+        for(size_t i = 0; i + 2 < index_count; i += 3) {
+            const u32_t part_index = (u32_t)parts.size() - 1;
+
+            u32_t missing = 0;
+            for(u32_t c = 0; c < 3; c++)
+                missing += stamp[mesh.indices[i + c]] != part_index;
+
+            if(part_vertices + missing > max_vertices) {
+                finish_part();
+                begin_part();
+                part_vertices = 0;
+            }
+
+            Mesh& part = parts.back();
+            const u32_t current = (u32_t)parts.size() - 1;
+
+            for(u32_t c = 0; c < 3; c++) {
+                u32_t v = mesh.indices[i + c];
+
+                if(stamp[v] != current) {
+                    stamp[v] = current;
+                    remap[v] = part_vertices++;
+
+                    if(has_f32) part.verticies.push_back(mesh.verticies[v]);
+                    if(has_packed)
+                        part.vertex_data.insert(part.vertex_data.end(),
+                            mesh.vertex_data.begin() + (size_t)v * stride,
+                            mesh.vertex_data.begin() + (size_t)(v + 1) * stride);
+                }
+
+                part.indices.push_back(remap[v]);
+            }
+        }
+
+        finish_part();
+        return parts;
+    }
+
+    void optimize(Mesh& mesh, OptimizeReport* report) {
+        PXL_PROFILE_FUNCTION();
+
+        if(mesh.indices.empty() || mesh.get_vertex_count() == 0) return;
+
+        OptimizeReport result;
+        result.vertices_before = mesh.get_vertex_count();
+
+        // Every LOD is its own index stream, LOD 0 is the one reported
+        std::vector<MeshLod> ranges;
+        if(mesh.lod_count)
+            ranges.assign(mesh.lods, mesh.lods + mesh.lod_count);
+        else
+            ranges.push_back({ 0, (u32_t)mesh.indices.size(), 0.0f });
+
+        result.before = analyze_vertex_cache(
+            mesh.indices.data() + ranges[0].first_index, ranges[0].index_count,
+            (u32_t)mesh.get_vertex_count());
+
+        weld(mesh);
+
+        const u32_t vertex_count = (u32_t)mesh.get_vertex_count();
+        for(const MeshLod& range : ranges) {
+            u32_t* indices = mesh.indices.data() + range.first_index;
+
+            vertex_cache(indices, range.index_count, vertex_count);
+            if(!mesh.verticies.empty())
+                overdraw(indices, range.index_count, mesh.verticies);
+        }
+
+        vertex_fetch(mesh);
+
+        result.vertices_after = mesh.get_vertex_count();
+        result.after = analyze_vertex_cache(
+            mesh.indices.data() + ranges[0].first_index, ranges[0].index_count,
+            (u32_t)mesh.get_vertex_count());
+
+        LOG("Mesh optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %llu -> %llu vertices",
+            (f64_t)result.before.acmr, (f64_t)result.after.acmr,
+            (f64_t)result.before.atvr, (f64_t)result.after.atvr,
+            result.vertices_before, result.vertices_after);
+
+        if(report) *report = result;
+    }
+
+};
+};
@@ -0,0 +1,94 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_MESH_OPTIMIZE_H
+#define PXL_MESH_OPTIMIZE_H
+
+#include "core/renderer/pxl_renderer_backend.h"
+
+// Import time index / vertex reordering. Run it once per asset after loading and
+// before uploading, order matters:
+//
+//      weld -> (LODs) -> vertex cache -> overdraw -> vertex fetch -> quantize
+//
+// Meshes over PXL_U16_INDEX_VERTICES vertices can be split() into parts that
+// fit 16 bit indices
+//
+// optimize() does all of it over every LOD range of a mesh and reports the
+// before / after numbers from the CPU cache simulation
+
+#ifndef PXL_VERTEX_CACHE_SIZE
+#define PXL_VERTEX_CACHE_SIZE 16        // FIFO entries the analyzer simulates
+#endif
+
+struct VertexCacheStats {
+    f32_t acmr = 0.0f;      // vertex shader runs per triangle, 0.5 .. 3
+    f32_t atvr = 0.0f;      // vertex shader runs per referenced vertex, 1 is ideal
+};
+
+struct OptimizeReport {
+    u64_t vertices_before = 0;
+    u64_t vertices_after = 0;
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+namespace pxl {
+namespace optimize {
+
+    // Merges bitwise identical vertices (f32 and packed data both have to match),
+    // remaps the indices. Returns the vertices removed
+    u64_t weld(Mesh& mesh);
+
+    // Forsyth's linear speed vertex cache optimisation, in place
+    void vertex_cache(u32_t* indices, size_t index_count, u32_t vertex_count);
+
+    // Splits cache ordered triangles into clusters where the cache goes cold anyway
+    // (or where it costs less than `threshold` x the ACMR) and sorts the clusters so
+    // outward facing ones draw first (Sander et al.). Expects vertex_cache() output
+    void overdraw(u32_t* indices, size_t index_count, const std::vector<Vertex>& vertices, f32_t threshold = 1.05f);
+
+    // Renumbers vertices in first use order so fetches walk the buffer linearly
+    void vertex_fetch(Mesh& mesh);
+
+    // Cuts a mesh into parts of at most max_vertices vertices so each one gets 16
+    // bit indices. Triangles keep their order, run it after vertex_cache() for
+    // tight parts. LODs aren't carried over, split first and generate them per part
+    std::vector<Mesh> split(const Mesh& mesh, u32_t max_vertices = PXL_U16_INDEX_VERTICES);
+
+    VertexCacheStats analyze_vertex_cache(
+        const u32_t* indices, size_t index_count, u32_t vertex_count,
+        u32_t cache_size = PXL_VERTEX_CACHE_SIZE);
+
+    // Everything above, every LOD range on its own
+    void optimize(Mesh& mesh, OptimizeReport* report = nullptr);
+
+};
+};
+
+#endif
@@ -0,0 +1,198 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_texture_atlas.h"
+
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+// The copy inside imgui_draw.cpp is static too, no clash
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+namespace pxl {
+namespace atlas {
+
+    static u32_t blocks(u32_t texels) {
+        return (texels + 3) / 4;
+    }
+
+    static u32_t trim(u32_t texels, u32_t limit) {
+        u32_t size = 4;
+        while(size < texels && size < limit) size <<= 1;
+        return std::min(size, limit);
+    }
+
+    // Copies `source` to x, y of the page and repeats its outer texels over the padding
+    static void blit(const ImageLevel& source, ImageLevel& page, u32_t x, u32_t y, u32_t padding) {
+        const u32_t left = x - padding;
+        const u32_t right = std::min(x + source.width + padding, page.width);
+        const u32_t bottom = y - padding;
+        const u32_t top = std::min(y + source.height + padding, page.height);
+
+        for(u32_t py = bottom; py < top; py++) {
+            const u32_t sy = std::min(py < y ? 0 : py - y, source.height - 1);
+            const u8_t* row = &source.data[(size_t)sy * source.width * 4];
+            u8_t* target = &page.data[((size_t)py * page.width) * 4];
+
+            for(u32_t px = left; px < x; px++) std::memcpy(&target[px * 4], row, 4);
+            std::memcpy(&target[x * 4], row, (size_t)source.width * 4);
+            for(u32_t px = x + source.width; px < right; px++)
+                std::memcpy(&target[px * 4], &row[(source.width - 1) * 4], 4);
+        }
+    }
+
+    void pack(const std::vector<const Image*>& images, TextureAtlas& out,
+        const AtlasSettings& settings, AtlasReport* report) {
+        out.pages.clear();
+        out.placements.assign(images.size(), AtlasPlacement());
+
+        // Packed in 4 texel blocks, that's what keeps the entries block aligned
+        const u32_t page_blocks = settings.page_size / 4;
+        const u32_t padding = settings.padding;
+
+        AtlasReport result;
+        std::vector<stbrp_rect> pending;
+
+        for(size_t i = 0; i < images.size(); i++) {
+            const Image* image = images[i];
+
+            if(!image || image->format != TextureFormat::RGBA8 || image->levels.empty()
+                || image->get_width() > settings.max_entry || image->get_height() > settings.max_entry
+                || blocks(image->get_width() + padding * 2) > page_blocks
+                || blocks(image->get_height() + padding * 2) > page_blocks) {
+                result.skipped++;
+                continue;
+            }
+
+            stbrp_rect rect = {};
+            rect.id = (int)i;
+            rect.w = (stbrp_coord)blocks(image->get_width() + padding * 2);
+            rect.h = (stbrp_coord)blocks(image->get_height() + padding * 2);
+            pending.push_back(rect);
+        }
+
+        std::vector<stbrp_node> nodes(page_blocks);
+        u64_t entry_texels = 0;
+        u64_t page_texels = 0;
+
+        while(!pending.empty()) {
+            stbrp_context context;
+            stbrp_init_target(&context, (int)page_blocks, (int)page_blocks, nodes.data(), (int)nodes.size());
+            stbrp_setup_heuristic(&context, STBRP_HEURISTIC_Skyline_BF_sortHeight);
+            stbrp_pack_rects(&context, pending.data(), (int)pending.size());
+
+            std::vector<stbrp_rect> placed, rest;
+            for(const stbrp_rect& rect : pending)
+                (rect.was_packed ? placed : rest).push_back(rect);
+
+            // Every entry fits an empty page, nothing placed would loop forever
+            if(placed.empty()) break;
+
+            // Full pages keep the whole size, the last one shrinks to what it uses
+            u32_t width = settings.page_size;
+            u32_t height = settings.page_size;
+
+            if(rest.empty()) {
+                u32_t used_x = 0, used_y = 0;
+                for(const stbrp_rect& rect : placed) {
+                    used_x = std::max<u32_t>(used_x, rect.x + rect.w);
+                    used_y = std::max<u32_t>(used_y, rect.y + rect.h);
+                }
+
+                width = trim(used_x * 4, settings.page_size);
+                height = trim(used_y * 4, settings.page_size);
+            }
+
+            ImageLevel level;
+            level.width = width;
+            level.height = height;
+            level.data.assign((size_t)width * height * 4, 0);
+
+            const u32_t page = (u32_t)out.pages.size();
+
+            for(const stbrp_rect& rect : placed) {
+                const ImageLevel& source = images[rect.id]->levels[0];
+                const u32_t x = rect.x * 4 + padding;
+                const u32_t y = rect.y * 4 + padding;
+
+                blit(source, level, x, y, padding);
+
+                AtlasPlacement& placement = out.placements[rect.id];
+                placement.page = page;
+                placement.scale = glm::vec2((f32_t)source.width / width, (f32_t)source.height / height);
+                placement.offset = glm::vec2((f32_t)x / width, (f32_t)y / height);
+
+                entry_texels += (u64_t)source.width * source.height;
+                result.packed++;
+            }
+
+            page_texels += (u64_t)width * height;
+
+            Image image;
+            image.levels.push_back(std::move(level));
+            out.pages.push_back(std::move(image));
+
+            pending.swap(rest);
+        }
+
+        result.pages = (u32_t)out.pages.size();
+        result.fill = page_texels ? (f32_t)((f64_t)entry_texels / page_texels) : 0.0f;
+
+        LOG("Packed %u textures into %u atlas pages (%.0f%% filled), %u left on their own",
+            result.packed, result.pages, result.fill * 100.0f, result.skipped);
+
+        if(report) *report = result;
+    }
+
+    bool fits(const Mesh& mesh) {
+        if(mesh.is_quantized()) return false;
+
+        for(const Vertex& vertex : mesh.verticies)
+            if(vertex.u < 0.0f || vertex.u > 1.0f || vertex.v < 0.0f || vertex.v > 1.0f) return false;
+
+        return true;
+    }
+
+    bool remap_uvs(Mesh& mesh, const AtlasPlacement& placement) {
+        if(placement.page == PXL_ATLAS_NONE || !fits(mesh)) return false;
+
+        for(Vertex& vertex : mesh.verticies) {
+            vertex.u = vertex.u * placement.scale.x + placement.offset.x;
+            vertex.v = vertex.v * placement.scale.y + placement.offset.y;
+        }
+
+        return true;
+    }
+
+};
+};
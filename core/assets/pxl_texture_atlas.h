@@ -0,0 +1,109 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_TEXTURE_ATLAS_H
+#define PXL_TEXTURE_ATLAS_H
+
+#include "pxl_image.h"
+#include "core/renderer/pxl_renderer_backend.h"
+
+// Import time atlas packing: small textures that would each break a batch get
+// packed into a few shared pages (rectangles by imstb_rectpack), the meshes using
+// them get their UVs moved into the page. Materials that only differed by their
+// texture come out identical and dedupe into one, so their draws sort, bind and
+// instance together.
+//
+// Only textures sampled inside 0..1 can move into an atlas, anything that wraps
+// has to stay on its own (remap_uvs() refuses those meshes). Run it before
+// pxl::vertex::quantize(), the UVs have to be plain floats still.
+//
+// Entries are placed on 4 texel blocks so a page compresses (pxl_texture_compress.h)
+// without two textures sharing a block, and get PXL_ATLAS_PADDING texels of their
+// own edge around them against filtering / mip bleeding. Packing is deterministic,
+// a material's other maps (normals, ...) packed in the same order with the same
+// sizes land on the same spots and share the placements
+
+#ifndef PXL_ATLAS_PAGE_SIZE
+#define PXL_ATLAS_PAGE_SIZE 2048
+#endif
+
+#ifndef PXL_ATLAS_PADDING
+#define PXL_ATLAS_PADDING 4             // gutter texels, mips stay clean down to level log2(padding)
+#endif
+
+#ifndef PXL_ATLAS_MAX_ENTRY
+#define PXL_ATLAS_MAX_ENTRY 512         // textures larger on any side stay on their own
+#endif
+
+#define PXL_ATLAS_NONE 0xFFFFFFFF
+
+struct AtlasSettings {
+    u32_t page_size = PXL_ATLAS_PAGE_SIZE;
+    u32_t padding = PXL_ATLAS_PADDING;
+    u32_t max_entry = PXL_ATLAS_MAX_ENTRY;
+};
+
+// uv' = uv * scale + offset
+struct AtlasPlacement {
+    u32_t page = PXL_ATLAS_NONE;        // not packed, keep using the texture itself
+    glm::vec2 scale = glm::vec2(1.0f);
+    glm::vec2 offset = glm::vec2(0.0f);
+};
+
+struct TextureAtlas {
+    std::vector<Image> pages;           // RGBA8, one level, the last one trimmed to what it uses
+    std::vector<AtlasPlacement> placements;    // one per input image, same order
+};
+
+struct AtlasReport {
+    u32_t packed = 0;
+    u32_t skipped = 0;                  // too large or not RGBA8
+    u32_t pages = 0;
+    f32_t fill = 0.0f;                  // texels of the entries / texels of the pages
+};
+
+namespace pxl {
+namespace atlas {
+
+    // Packs the RGBA8 level 0 of every image that fits, everything else gets a
+    // PXL_ATLAS_NONE placement. Pages fill up one after the other, largest entries first
+    void pack(const std::vector<const Image*>& images, TextureAtlas& out,
+        const AtlasSettings& settings = AtlasSettings(), AtlasReport* report = nullptr);
+
+    // Whether every UV of the mesh is inside 0..1 (so it can sample an atlas)
+    bool fits(const Mesh& mesh);
+
+    // Moves the mesh's UVs into its entry. False and untouched when the entry
+    // wasn't packed, the mesh is quantized or its UVs leave 0..1
+    bool remap_uvs(Mesh& mesh, const AtlasPlacement& placement);
+
+};
+};
+
+#endif
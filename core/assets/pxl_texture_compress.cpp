@@ -0,0 +1,483 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_texture_compress.h"
+
+#include "core/thread/pxl_job_system.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace pxl {
+namespace bc {
+
+    static f32_t clamp_color(f32_t value) {
+        return std::min(std::max(value, 0.0f), 255.0f);
+    }
+
+    // Mean and dominant direction of the first `channels` channels, zero axis for
+    // flat blocks
+    static void principal_axis(const u8_t* texels, u32_t channels, f32_t* mean, f32_t* axis) {
+        for(u32_t c = 0; c < channels; c++) {
+            mean[c] = 0.0f;
+            for(u32_t i = 0; i < 16; i++) mean[c] += texels[i * 4 + c];
+            mean[c] /= 16.0f;
+        }
+
+        f32_t covariance[4][4] = {};
+        for(u32_t i = 0; i < 16; i++) {
+            f32_t delta[4];
+            for(u32_t c = 0; c < channels; c++) delta[c] = texels[i * 4 + c] - mean[c];
+
+            for(u32_t a = 0; a < channels; a++)
+                for(u32_t b = 0; b < channels; b++)
+                    covariance[a][b] += delta[a] * delta[b];
+        }
+
+        // Power iteration, started on the row of the widest channel
+        u32_t widest = 0;
+        for(u32_t c = 1; c < channels; c++)
+            if(covariance[c][c] > covariance[widest][widest]) widest = c;
+
+        f32_t vector[4];
+        for(u32_t c = 0; c < channels; c++) vector[c] = covariance[widest][c];
+
+        for(u32_t iteration = 0; iteration < 8; iteration++) {
+            f32_t next[4] = {};
+            f32_t largest = 0.0f;
+
+            for(u32_t a = 0; a < channels; a++) {
+                for(u32_t b = 0; b < channels; b++) next[a] += covariance[a][b] * vector[b];
+                largest = std::max(largest, std::fabs(next[a]));
+            }
+
+            if(largest <= 0.0f) break;
+            for(u32_t c = 0; c < channels; c++) vector[c] = next[c] / largest;
+        }
+
+        f32_t length = 0.0f;
+        for(u32_t c = 0; c < channels; c++) length += vector[c] * vector[c];
+        length = std::sqrt(length);
+
+        for(u32_t c = 0; c < channels; c++) axis[c] = length > 1e-6f ? vector[c] / length : 0.0f;
+    }
+
+    // Extremes of the texels projected on the axis
+    static void project(const u8_t* texels, u32_t channels, const f32_t* mean, const f32_t* axis, f32_t& low, f32_t& high) {
+        low = 0.0f;
+        high = 0.0f;
+
+        for(u32_t i = 0; i < 16; i++) {
+            f32_t t = 0.0f;
+            for(u32_t c = 0; c < channels; c++) t += (texels[i * 4 + c] - mean[c]) * axis[c];
+            low = std::min(low, t);
+            high = std::max(high, t);
+        }
+    }
+
+    // Least squares endpoints for fixed per texel weights (`weights[i]` of end0),
+    // false when the system is degenerate (every texel on one weight)
+    static bool refit(const u8_t* texels, u32_t channels, const f32_t* weights, f32_t* end0, f32_t* end1) {
+        f32_t aa = 0.0f, bb = 0.0f, ab = 0.0f;
+        f32_t ax[4] = {}, bx[4] = {};
+
+        for(u32_t i = 0; i < 16; i++) {
+            f32_t a = weights[i];
+            f32_t b = 1.0f - a;
+
+            aa += a * a;
+            bb += b * b;
+            ab += a * b;
+
+            for(u32_t c = 0; c < channels; c++) {
+                ax[c] += a * texels[i * 4 + c];
+                bx[c] += b * texels[i * 4 + c];
+            }
+        }
+
+        f32_t determinant = aa * bb - ab * ab;
+        if(std::fabs(determinant) < 1e-6f) return false;
+
+        for(u32_t c = 0; c < channels; c++) {
+            end0[c] = clamp_color((ax[c] * bb - bx[c] * ab) / determinant);
+            end1[c] = clamp_color((bx[c] * aa - ax[c] * ab) / determinant);
+        }
+
+        return true;
+    }
+
+    static u16_t pack_565(const f32_t* color) {
+        u32_t r = (u32_t)std::lround(clamp_color(color[0]) * 31.0f / 255.0f);
+        u32_t g = (u32_t)std::lround(clamp_color(color[1]) * 63.0f / 255.0f);
+        u32_t b = (u32_t)std::lround(clamp_color(color[2]) * 31.0f / 255.0f);
+        return (u16_t)((r << 11) | (g << 5) | b);
+    }
+
+    static void unpack_565(u16_t value, f32_t* color) {
+        u32_t r = (value >> 11) & 31;
+        u32_t g = (value >> 5) & 63;
+        u32_t b = value & 31;
+
+        color[0] = (f32_t)((r << 3) | (r >> 2));
+        color[1] = (f32_t)((g << 2) | (g >> 4));
+        color[2] = (f32_t)((b << 3) | (b >> 2));
+    }
+
+    // Four color mode indices (c0 > c1, equal ends only use index 0), returns the
+    // squared error
+    static f32_t fit_bc1(const u8_t* texels, u16_t c0, u16_t c1, u8_t* indices) {
+        f32_t palette[4][3];
+        unpack_565(c0, palette[0]);
+        unpack_565(c1, palette[1]);
+
+        for(u32_t c = 0; c < 3; c++) {
+            palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+            palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+        }
+
+        const u32_t candidates = c0 == c1 ? 1 : 4;
+        f32_t error = 0.0f;
+
+        for(u32_t i = 0; i < 16; i++) {
+            f32_t best = INFINITY;
+            for(u32_t p = 0; p < candidates; p++) {
+                f32_t distance = 0.0f;
+                for(u32_t c = 0; c < 3; c++) {
+                    f32_t delta = texels[i * 4 + c] - palette[p][c];
+                    distance += delta * delta;
+                }
+
+                if(distance < best) {
+                    best = distance;
+                    indices[i] = (u8_t)p;
+                }
+            }
+            error += best;
+        }
+
+        return error;
+    }
+
+    void encode_bc1(const u8_t* texels, u8_t* out) {
+        f32_t mean[4], axis[4];
+        principal_axis(texels, 3, mean, axis);
+
+        f32_t low, high;
+        project(texels, 3, mean, axis, low, high);
+
+        // Inset a little, the extremes rarely sit on the palette anyway
+        f32_t inset = (high - low) / 16.0f;
+        low += inset;
+        high -= inset;
+
+        f32_t end0[3], end1[3];
+        for(u32_t c = 0; c < 3; c++) {
+            end0[c] = clamp_color(mean[c] + axis[c] * high);
+            end1[c] = clamp_color(mean[c] + axis[c] * low);
+        }
+
+        u16_t c0 = pack_565(end0);
+        u16_t c1 = pack_565(end1);
+        if(c0 < c1) std::swap(c0, c1);
+
+        u8_t indices[16];
+        f32_t error = fit_bc1(texels, c0, c1, indices);
+
+        if(c0 != c1) {
+            static const f32_t palette_weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+            f32_t weights[16];
+            for(u32_t i = 0; i < 16; i++) weights[i] = palette_weights[indices[i]];
+
+            if(refit(texels, 3, weights, end0, end1)) {
+                u16_t r0 = pack_565(end0);
+                u16_t r1 = pack_565(end1);
+                if(r0 < r1) std::swap(r0, r1);
+
+                u8_t refit_indices[16];
+                f32_t refit_error = fit_bc1(texels, r0, r1, refit_indices);
+
+                if(refit_error < error) {
+                    c0 = r0;
+                    c1 = r1;
+                    std::memcpy(indices, refit_indices, sizeof(indices));
+                }
+            }
+        }
+
+        u32_t bits = 0;
+        for(u32_t i = 0; i < 16; i++) bits |= (u32_t)indices[i] << (i * 2);
+
+        out[0] = (u8_t)(c0 & 0xff);
+        out[1] = (u8_t)(c0 >> 8);
+        out[2] = (u8_t)(c1 & 0xff);
+        out[3] = (u8_t)(c1 >> 8);
+        for(u32_t b = 0; b < 4; b++) out[4 + b] = (u8_t)(bits >> (b * 8));
+    }
+
+    // Eight value mode (a0 > a1), min / max are exact so no fitting needed
+    void encode_bc4(const u8_t* texels, u32_t channel, u8_t* out) {
+        u8_t low = 255, high = 0;
+        for(u32_t i = 0; i < 16; i++) {
+            low = std::min(low, texels[i * 4 + channel]);
+            high = std::max(high, texels[i * 4 + channel]);
+        }
+
+        out[0] = high;
+        out[1] = low;
+
+        u64_t bits = 0;
+        if(high > low) {
+            // Steps from high (0) to low (7) -> codes, 0 and 1 are the ends
+            static const u8_t codes[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+
+            for(u32_t i = 0; i < 16; i++) {
+                s32_t step = (s32_t)std::lround((f32_t)(high - texels[i * 4 + channel]) * 7.0f / (f32_t)(high - low));
+                bits |= (u64_t)codes[step] << (i * 3);
+            }
+        }
+
+        for(u32_t b = 0; b < 6; b++) out[2 + b] = (u8_t)(bits >> (b * 8));
+    }
+
+    void encode_bc3(const u8_t* texels, u8_t* out) {
+        encode_bc4(texels, 3, out);
+        encode_bc1(texels, out + 8);
+    }
+
+    void encode_bc5(const u8_t* texels, u8_t* out) {
+        encode_bc4(texels, 0, out);
+        encode_bc4(texels, 1, out + 8);
+    }
+
+    static const u32_t bc7_weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct BC7Endpoint {
+        u8_t quantized[4];      // 7 bits
+        u8_t p;
+        u8_t expanded[4];       // quantized << 1 | p
+    };
+
+    // Picks the p-bit that lands closer
+    static BC7Endpoint quantize_bc7(const f32_t* color) {
+        BC7Endpoint best = {};
+        f32_t best_error = INFINITY;
+
+        for(u8_t p = 0; p < 2; p++) {
+            BC7Endpoint endpoint = {};
+            endpoint.p = p;
+
+            f32_t error = 0.0f;
+            for(u32_t c = 0; c < 4; c++) {
+                s32_t value = (s32_t)std::lround((clamp_color(color[c]) - p) / 2.0f);
+                value = std::min(std::max(value, 0), 127);
+
+                endpoint.quantized[c] = (u8_t)value;
+                endpoint.expanded[c] = (u8_t)((value << 1) | p);
+
+                f32_t delta = endpoint.expanded[c] - color[c];
+                error += delta * delta;
+            }
+
+            if(error < best_error) {
+                best_error = error;
+                best = endpoint;
+            }
+        }
+
+        return best;
+    }
+
+    static f32_t fit_bc7(const u8_t* texels, const BC7Endpoint& end0, const BC7Endpoint& end1, u8_t* indices) {
+        u32_t palette[16][4];
+        for(u32_t p = 0; p < 16; p++)
+            for(u32_t c = 0; c < 4; c++)
+                palette[p][c] = ((64 - bc7_weights[p]) * end0.expanded[c] + bc7_weights[p] * end1.expanded[c] + 32) >> 6;
+
+        f32_t error = 0.0f;
+        for(u32_t i = 0; i < 16; i++) {
+            s32_t best = 0x7fffffff;
+            for(u32_t p = 0; p < 16; p++) {
+                s32_t distance = 0;
+                for(u32_t c = 0; c < 4; c++) {
+                    s32_t delta = (s32_t)texels[i * 4 + c] - (s32_t)palette[p][c];
+                    distance += delta * delta;
+                }
+
+                if(distance < best) {
+                    best = distance;
+                    indices[i] = (u8_t)p;
+                }
+            }
+            error += (f32_t)best;
+        }
+
+        return error;
+    }
+
+    // Mode 6 layout, LSB first: mode (7) R0 R1 G0 G1 B0 B1 A0 A1 (7 each) P0 P1,
+    // then 16 indices, 4 bits each except index 0 whose top bit is implied 0
+    void encode_bc7(const u8_t* texels, u8_t* out) {
+        f32_t mean[4], axis[4];
+        principal_axis(texels, 4, mean, axis);
+
+        f32_t low, high;
+        project(texels, 4, mean, axis, low, high);
+
+        f32_t color0[4], color1[4];
+        for(u32_t c = 0; c < 4; c++) {
+            color0[c] = clamp_color(mean[c] + axis[c] * low);
+            color1[c] = clamp_color(mean[c] + axis[c] * high);
+        }
+
+        BC7Endpoint end0 = quantize_bc7(color0);
+        BC7Endpoint end1 = quantize_bc7(color1);
+
+        u8_t indices[16];
+        f32_t error = fit_bc7(texels, end0, end1, indices);
+
+        f32_t weights[16];
+        for(u32_t i = 0; i < 16; i++) weights[i] = 1.0f - bc7_weights[indices[i]] / 64.0f;
+
+        if(error > 0.0f && refit(texels, 4, weights, color0, color1)) {
+            BC7Endpoint refit0 = quantize_bc7(color0);
+            BC7Endpoint refit1 = quantize_bc7(color1);
+
+            u8_t refit_indices[16];
+            f32_t refit_error = fit_bc7(texels, refit0, refit1, refit_indices);
+
+            if(refit_error < error) {
+                end0 = refit0;
+                end1 = refit1;
+                std::memcpy(indices, refit_indices, sizeof(indices));
+            }
+        }
+
+        if(indices[0] & 8) {
+            std::swap(end0, end1);
+            for(u32_t i = 0; i < 16; i++) indices[i] = (u8_t)(15 - indices[i]);
+        }
+
+        std::memset(out, 0, 16);
+        u32_t position = 0;
+
+        auto write = [&](u32_t value, u32_t bits) {
+            for(u32_t b = 0; b < bits; b++, position++)
+                if((value >> b) & 1) out[position >> 3] |= (u8_t)(1 << (position & 7));
+        };
+
+        write(1 << 6, 7);
+        for(u32_t c = 0; c < 4; c++) {
+            write(end0.quantized[c], 7);
+            write(end1.quantized[c], 7);
+        }
+        write(end0.p, 1);
+        write(end1.p, 1);
+
+        write(indices[0], 3);
+        for(u32_t i = 1; i < 16; i++) write(indices[i], 4);
+    }
+
+};
+
+namespace texture {
+
+    bool can_compress(TextureFormat format) {
+        return format == TextureFormat::BC1 || format == TextureFormat::BC3
+            || format == TextureFormat::BC5 || format == TextureFormat::BC7;
+    }
+
+    bool compress(const Image& source, TextureFormat format, Image& out) {
+        if(source.format != TextureFormat::RGBA8 || source.levels.empty()) {
+            ERR("Only RGBA8 images can be compressed");
+            return false;
+        }
+
+        if(format == TextureFormat::RGBA8) {
+            out = source;
+            return true;
+        }
+
+        if(!can_compress(format)) {
+            ERR("No %s encoder", pxl::image::format_name(format));
+            return false;
+        }
+
+        const size_t block_bytes = pxl::image::level_bytes(format, 4, 4);
+
+        Image result;
+        result.format = format;
+        result.levels.resize(source.levels.size());
+
+        for(size_t l = 0; l < source.levels.size(); l++) {
+            const ImageLevel& level = source.levels[l];
+            ImageLevel& target = result.levels[l];
+
+            target.width = level.width;
+            target.height = level.height;
+            target.data.resize(pxl::image::level_bytes(format, level.width, level.height));
+
+            const u32_t blocks_x = (level.width + 3) / 4;
+            const u32_t blocks_y = (level.height + 3) / 4;
+
+            pxl::jobs::parallel_for(blocks_y, 8, [&](u32_t begin, u32_t end) {
+                u8_t texels[64];
+
+                for(u32_t by = begin; by < end; by++) {
+                    for(u32_t bx = 0; bx < blocks_x; bx++) {
+                        for(u32_t y = 0; y < 4; y++) {
+                            const u32_t sy = std::min(by * 4 + y, level.height - 1);
+                            for(u32_t x = 0; x < 4; x++) {
+                                const u32_t sx = std::min(bx * 4 + x, level.width - 1);
+                                std::memcpy(&texels[(y * 4 + x) * 4], &level.data[((size_t)sy * level.width + sx) * 4], 4);
+                            }
+                        }
+
+                        u8_t* block = target.data.data() + ((size_t)by * blocks_x + bx) * block_bytes;
+
+                        switch(format) {
+                            case TextureFormat::BC1: pxl::bc::encode_bc1(texels, block); break;
+                            case TextureFormat::BC3: pxl::bc::encode_bc3(texels, block); break;
+                            case TextureFormat::BC5: pxl::bc::encode_bc5(texels, block); break;
+                            case TextureFormat::BC7: pxl::bc::encode_bc7(texels, block); break;
+                            default: break;
+                        }
+                    }
+                }
+            });
+        }
+
+        out = std::move(result);
+        return true;
+    }
+
+};
+};
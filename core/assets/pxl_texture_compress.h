@@ -0,0 +1,66 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_TEXTURE_COMPRESS_H
+#define PXL_TEXTURE_COMPRESS_H
+
+#include "pxl_image.h"
+
+// CPU block compression for the cook step (pxl_texture_container.h), not meant
+// for runtime. Blocks are 16 RGBA8 texels, row major in memory order.
+//
+// Endpoints come from the block's principal axis (power iteration on the color
+// covariance) and get one least squares refit against the picked indices, the
+// better of the two is kept. BC7 only uses mode 6 (one subset, RGBA endpoints,
+// 16 levels), no partitions: close to BC3 speed, clearly better gradients and
+// alpha. ETC2 / ASTC have no encoder, .pxtex files can still carry them
+
+namespace pxl {
+namespace bc {
+
+    void encode_bc1(const u8_t* texels, u8_t* out);                     // 8 bytes
+    void encode_bc4(const u8_t* texels, u32_t channel, u8_t* out);      // 8 bytes, one channel
+    void encode_bc3(const u8_t* texels, u8_t* out);                     // 16 bytes
+    void encode_bc5(const u8_t* texels, u8_t* out);                     // 16 bytes, red + green
+    void encode_bc7(const u8_t* texels, u8_t* out);                     // 16 bytes
+
+};
+
+namespace texture {
+
+    bool can_compress(TextureFormat format);
+
+    // Every level of an RGBA8 `source` into `format`, block rows go over the job
+    // workers. Edge blocks of sizes that aren't a multiple of 4 repeat the last texels
+    bool compress(const Image& source, TextureFormat format, Image& out);
+
+};
+};
+
+#endif
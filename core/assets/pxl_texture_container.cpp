@@ -0,0 +1,191 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_texture_container.h"
+#include "pxl_texture_compress.h"
+
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace pxl {
+namespace pxtex {
+
+    static u64_t align(u64_t offset) {
+        return (offset + 15) & ~(u64_t)15;
+    }
+
+    bool write(const char* path, const Image& image) {
+        if(image.levels.empty() || image.levels.size() > 0xFF || image.format >= TextureFormat::COUNT) {
+            ERR("Nothing to write to: %s", path);
+            return false;
+        }
+
+        PxtexHeader header = {};
+        header.magic = PXTEX_MAGIC;
+        header.version = PXTEX_VERSION;
+        header.format = (u8_t)image.format;
+        header.level_count = (u8_t)image.levels.size();
+        header.width = image.get_width();
+        header.height = image.get_height();
+
+        std::vector<PxtexLevel> levels(image.levels.size());
+        u64_t offset = align(sizeof(PxtexHeader) + sizeof(PxtexLevel) * levels.size());
+
+        for(size_t i = 0; i < levels.size(); i++) {
+            levels[i].width = image.levels[i].width;
+            levels[i].height = image.levels[i].height;
+            levels[i].offset = offset;
+            levels[i].size = image.levels[i].data.size();
+            offset = align(offset + levels[i].size);
+        }
+
+        FILE* file = fopen(path, "wb");
+        if(!file) {
+            ERR("Couldn't open for writing: %s", path);
+            return false;
+        }
+
+        static const u8_t padding[16] = {};
+
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(levels.data(), sizeof(PxtexLevel), levels.size(), file) == levels.size();
+
+        u64_t position = sizeof(PxtexHeader) + sizeof(PxtexLevel) * levels.size();
+        for(size_t i = 0; written && i < levels.size(); i++) {
+            written = fwrite(padding, 1, levels[i].offset - position, file) == levels[i].offset - position
+                && fwrite(image.levels[i].data.data(), 1, levels[i].size, file) == levels[i].size;
+            position = levels[i].offset + levels[i].size;
+        }
+
+        if(fclose(file) != 0) written = false;
+
+        if(!written) ERR("Couldn't write: %s", path);
+        return written;
+    }
+
+    bool map(const u8_t* file, size_t size, ImageView& out) {
+        if(size < sizeof(PxtexHeader)) return false;
+
+        PxtexHeader header;
+        std::memcpy(&header, file, sizeof(header));
+
+        if(header.magic != PXTEX_MAGIC || header.version != PXTEX_VERSION) return false;
+        if(header.format >= (u8_t)TextureFormat::COUNT || header.level_count == 0) return false;
+        if(header.width == 0 || header.height == 0) return false;
+
+        const TextureFormat format = (TextureFormat)header.format;
+        const size_t table = sizeof(PxtexHeader) + sizeof(PxtexLevel) * header.level_count;
+        if(table > size) return false;
+
+        ImageView view;
+        view.format = format;
+        view.levels.resize(header.level_count);
+
+        for(u8_t i = 0; i < header.level_count; i++) {
+            PxtexLevel level;
+            std::memcpy(&level, file + sizeof(PxtexHeader) + sizeof(PxtexLevel) * i, sizeof(level));
+
+            // Has to be the regular chain, the manager picks levels by their index
+            const u32_t width = std::max<u32_t>(header.width >> i, 1);
+            const u32_t height = std::max<u32_t>(header.height >> i, 1);
+
+            if(level.width != width || level.height != height) return false;
+            if(level.size != pxl::image::level_bytes(format, width, height)) return false;
+            if(level.offset < table || level.offset > size || level.size > size - level.offset) return false;
+
+            view.levels[i] = { width, height, file + level.offset, (size_t)level.size };
+        }
+
+        out = std::move(view);
+        return true;
+    }
+
+    bool decode(const u8_t* file, size_t size, Image& out) {
+        ImageView view;
+        if(!map(file, size, view)) return false;
+
+        Image image;
+        image.format = view.format;
+        image.levels.resize(view.levels.size());
+
+        for(size_t i = 0; i < view.levels.size(); i++) {
+            const ImageLevelView& level = view.levels[i];
+            image.levels[i].width = level.width;
+            image.levels[i].height = level.height;
+            image.levels[i].data.assign(level.data, level.data + level.size);
+        }
+
+        out = std::move(image);
+        return true;
+    }
+
+    bool cook(const char* source, const char* target, TextureFormat format, CookReport* report) {
+        auto start = std::chrono::steady_clock::now();
+
+        Image image;
+        if(!pxl::image::load(source, image)) return false;
+
+        if(image.format != TextureFormat::RGBA8) {
+            ERR("Cook sources have to decode to RGBA8: %s", source);
+            return false;
+        }
+
+        if(image.levels.size() == 1) pxl::image::generate_mips(image);
+
+        u64_t source_bytes = 0;
+        for(const ImageLevel& level : image.levels) source_bytes += level.data.size();
+
+        Image compressed;
+        if(!pxl::texture::compress(image, format, compressed)) return false;
+        if(!write(target, compressed)) return false;
+
+        u64_t output_bytes = sizeof(PxtexHeader) + sizeof(PxtexLevel) * compressed.levels.size();
+        for(const ImageLevel& level : compressed.levels) output_bytes = align(output_bytes) + level.data.size();
+
+        f64_t milliseconds = std::chrono::duration<f64_t, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        LOG("Cooked %s -> %s (%s, %ux%u, %u levels, %.1f KB -> %.1f KB) in %.1f ms",
+            source, target, pxl::image::format_name(format), compressed.get_width(), compressed.get_height(),
+            (u32_t)compressed.levels.size(), source_bytes / 1024.0, output_bytes / 1024.0, milliseconds);
+
+        if(report) {
+            report->source_bytes = source_bytes;
+            report->output_bytes = output_bytes;
+            report->milliseconds = milliseconds;
+        }
+
+        return true;
+    }
+
+};
+};
@@ -0,0 +1,95 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_TEXTURE_CONTAINER_H
+#define PXL_TEXTURE_CONTAINER_H
+
+#include "pxl_image.h"
+
+// .pxtex, textures as the GPU wants them: every level already in its final
+// (usually block compressed) format, so loading is a mapping plus a copy per
+// level, no decode and no mip generation. Cooked offline from any image the
+// decoders read, see cook().
+//
+// Little endian, laid out as:
+//   PxtexHeader
+//   PxtexLevel * level_count       finest first
+//   level data                     each one at a 16 byte aligned offset
+
+#define PXTEX_MAGIC     0x58545850  // "PXTX"
+#define PXTEX_VERSION   1
+
+struct PxtexHeader {
+    u32_t magic;
+    u16_t version;
+    u8_t format;                    // TextureFormat
+    u8_t level_count;
+    u32_t width;
+    u32_t height;
+    u32_t flags;                    // none yet
+    u32_t reserved[3];
+};
+
+struct PxtexLevel {
+    u32_t width;
+    u32_t height;
+    u64_t offset;                   // from the start of the file
+    u64_t size;
+};
+
+static_assert(sizeof(PxtexHeader) == 32, "PxtexHeader is stored as is");
+static_assert(sizeof(PxtexLevel) == 24, "PxtexLevel is stored as is");
+
+struct CookReport {
+    u64_t source_bytes = 0;         // RGBA8, every level
+    u64_t output_bytes = 0;         // the written file
+    f64_t milliseconds = 0.0;
+};
+
+namespace pxl {
+namespace pxtex {
+
+    bool write(const char* path, const Image& image);
+
+    // Validates the whole file like decode() but leaves the levels where they are,
+    // `out` points into `file`
+    bool map(const u8_t* file, size_t size, ImageView& out);
+
+    // The "pxtex" decoder, rejects anything that doesn't add up (sizes, offsets,
+    // level chain) instead of trusting the file
+    bool decode(const u8_t* file, size_t size, Image& out);
+
+    // Loads `source`, builds the mips if it has none, compresses to `format` and
+    // writes `target`
+    bool cook(const char* source, const char* target, TextureFormat format, CookReport* report = nullptr);
+
+};
+};
+
+#endif
@@ -0,0 +1,298 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_vertex_quantize.h"
+
+#include "core/renderer/pxl_culling.h"
+#include "core/debug/pxl_metrics.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace pxl {
+namespace vertex {
+
+    u16_t to_half(f32_t value) {
+        u32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        u32_t sign = (bits >> 16) & 0x8000;
+        u32_t raw_exponent = (bits >> 23) & 0xff;
+        u32_t mantissa = bits & 0x7fffff;
+
+        if(raw_exponent == 0xff)
+            return (u16_t)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+        s32_t exponent = (s32_t)raw_exponent - 127 + 15;
+        if(exponent >= 31) return (u16_t)(sign | 0x7c00);
+
+        // Denormal (or zero) halfs
+        if(exponent <= 0) {
+            if(exponent < -10) return (u16_t)sign;
+
+            mantissa |= 0x800000;
+            u32_t shift = (u32_t)(14 - exponent);
+            u32_t half = mantissa >> shift;
+            u32_t rest = mantissa & ((1u << shift) - 1);
+            u32_t middle = 1u << (shift - 1);
+
+            if(rest > middle || (rest == middle && (half & 1))) half++;
+            return (u16_t)(sign | half);
+        }
+
+        // A carry out of the mantissa bumps the exponent, which is still correct
+        u32_t half = sign | ((u32_t)exponent << 10) | (mantissa >> 13);
+        u32_t rest = mantissa & 0x1fff;
+        if(rest > 0x1000 || (rest == 0x1000 && (half & 1))) half++;
+
+        return (u16_t)half;
+    }
+
+    f32_t from_half(u16_t value) {
+        u32_t sign = (u32_t)(value & 0x8000) << 16;
+        u32_t exponent = (value >> 10) & 0x1f;
+        u32_t mantissa = value & 0x3ff;
+
+        if(exponent == 0) {
+            f32_t magnitude = std::ldexp((f32_t)mantissa, -24);
+            return sign ? -magnitude : magnitude;
+        }
+
+        u32_t bits = exponent == 31
+            ? sign | 0x7f800000 | (mantissa << 13)
+            : sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+
+        f32_t result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    static glm::vec2 sign_not_zero(const glm::vec2& v) {
+        return glm::vec2(v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    glm::vec2 encode_octahedral(const glm::vec3& normal) {
+        f32_t length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if(length <= 0.0f) return glm::vec2(0.0f);
+
+        glm::vec3 n = normal / length;
+        glm::vec2 encoded(n.x, n.y);
+
+        if(n.z < 0.0f)
+            encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * sign_not_zero(encoded);
+
+        return encoded;
+    }
+
+    glm::vec3 decode_octahedral(const glm::vec2& encoded) {
+        glm::vec3 n(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+
+        if(n.z < 0.0f) {
+            glm::vec2 folded = (1.0f - glm::abs(glm::vec2(n.y, n.x))) * sign_not_zero(glm::vec2(n));
+            n.x = folded.x;
+            n.y = folded.y;
+        }
+
+        return glm::normalize(n);
+    }
+
+    static void write_attribute(u8_t* out, VertexFormat format, const glm::vec4& value) {
+        switch(format) {
+            case VertexFormat::FLOAT2:
+            case VertexFormat::FLOAT3:
+            case VertexFormat::FLOAT4:
+                std::memcpy(out, &value, format_size(format));
+                break;
+
+            case VertexFormat::HALF2:
+            case VertexFormat::HALF4: {
+                u16_t* half = (u16_t*)out;
+                u32_t components = format == VertexFormat::HALF2 ? 2 : 4;
+                for(u32_t c = 0; c < components; c++) half[c] = to_half(value[c]);
+                break;
+            }
+
+            case VertexFormat::UNORM8X4:
+                for(u32_t c = 0; c < 4; c++)
+                    out[c] = (u8_t)std::lround(glm::clamp(value[c], 0.0f, 1.0f) * 255.0f);
+                break;
+
+            case VertexFormat::SNORM16X2: {
+                s16_t* snorm = (s16_t*)out;
+                for(u32_t c = 0; c < 2; c++)
+                    snorm[c] = (s16_t)std::lround(glm::clamp(value[c], -1.0f, 1.0f) * 32767.0f);
+                break;
+            }
+
+            case VertexFormat::UNORM16X2: {
+                u16_t* unorm = (u16_t*)out;
+                for(u32_t c = 0; c < 2; c++)
+                    unorm[c] = (u16_t)std::lround(glm::clamp(value[c], 0.0f, 1.0f) * 65535.0f);
+                break;
+            }
+        }
+    }
+
+    // Area weighted, the cross product's length already is twice the area
+    static std::vector<glm::vec3> compute_normals(const Mesh& mesh) {
+        std::vector<glm::vec3> normals(mesh.verticies.size(), glm::vec3(0.0f));
+
+        const size_t index_count = mesh.lod_count ? mesh.lods[0].index_count : mesh.indices.size();
+        for(size_t i = 0; i + 2 < index_count; i += 3) {
+            u32_t a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+            const Vertex& va = mesh.verticies[a];
+            const Vertex& vb = mesh.verticies[b];
+            const Vertex& vc = mesh.verticies[c];
+
+            glm::vec3 face = glm::cross(
+                glm::vec3(vb.x - va.x, vb.y - va.y, vb.z - va.z),
+                glm::vec3(vc.x - va.x, vc.y - va.y, vc.z - va.z));
+
+            normals[a] += face;
+            normals[b] += face;
+            normals[c] += face;
+        }
+
+        for(glm::vec3& normal : normals) {
+            f32_t length = glm::length(normal);
+            normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+        }
+
+        return normals;
+    }
+
+    bool quantize(Mesh& mesh, const VertexLayout& layout, QuantizeReport* report, const std::vector<glm::vec3>* normals) {
+        if(mesh.verticies.empty()) {
+            ERR("Nothing to quantize, the mesh has no f32 vertices");
+            return false;
+        }
+
+        const VertexAttribute* position = layout.find(VertexSemantic::POSITION);
+        if(!position || position->format == VertexFormat::FLOAT2
+            || position->format == VertexFormat::HALF2 || position->format == VertexFormat::UNORM8X4
+            || position->format == VertexFormat::SNORM16X2 || position->format == VertexFormat::UNORM16X2) {
+            ERR("Vertex layout needs a FLOAT3, FLOAT4 or HALF4 position");
+            return false;
+        }
+
+        if(normals && normals->size() != mesh.verticies.size()) {
+            ERR("Expected %llu normals, got %llu", (u64_t)mesh.verticies.size(), (u64_t)normals->size());
+            return false;
+        }
+
+        // Normals made up here weren't part of the source, they don't count as saved
+        const bool source_normals = normals != nullptr;
+
+        std::vector<glm::vec3> computed_normals;
+        if(layout.find(VertexSemantic::NORMAL) && !normals) {
+            computed_normals = compute_normals(mesh);
+            normals = &computed_normals;
+        }
+
+        if(mesh.bounds.radius < 0.0f)
+            mesh.bounds = pxl::culling::compute_bounds(mesh.verticies);
+
+        // Half floats are densest around 0, so center the box on the origin and scale to -1..1
+        const bool half_positions = position->format == VertexFormat::HALF4;
+        glm::vec3 scale(1.0f);
+        glm::vec3 offset(0.0f);
+
+        if(half_positions) {
+            offset = (mesh.bounds.min + mesh.bounds.max) * 0.5f;
+            scale = glm::max((mesh.bounds.max - mesh.bounds.min) * 0.5f, glm::vec3(1e-6f));
+        }
+
+        const size_t vertex_count = mesh.verticies.size();
+        std::vector<u8_t> data(vertex_count * layout.stride, 0);
+        f32_t max_error = 0.0f;
+
+        for(size_t v = 0; v < vertex_count; v++) {
+            const Vertex& source = mesh.verticies[v];
+            u8_t* out = data.data() + v * layout.stride;
+
+            for(u8_t a = 0; a < layout.count; a++) {
+                const VertexAttribute& attribute = layout.attributes[a];
+                glm::vec4 value(0.0f, 0.0f, 0.0f, 1.0f);
+
+                switch(attribute.semantic) {
+                    case VertexSemantic::POSITION:
+                        value = glm::vec4((glm::vec3(source.x, source.y, source.z) - offset) / scale, 1.0f);
+                        break;
+                    case VertexSemantic::COLOR:
+                        value = glm::vec4(source.r, source.g, source.b, 1.0f);
+                        break;
+                    case VertexSemantic::UV:
+                        value = glm::vec4(source.u, source.v, 0.0f, 0.0f);
+                        break;
+                    case VertexSemantic::NORMAL: {
+                        const glm::vec3& normal = (*normals)[v];
+                        value = attribute.format == VertexFormat::SNORM16X2
+                            ? glm::vec4(encode_octahedral(normal), 0.0f, 0.0f)
+                            : glm::vec4(normal, 0.0f);
+                        break;
+                    }
+                    default:
+                        break;
+                }
+
+                write_attribute(out + attribute.offset, attribute.format, value);
+            }
+
+            if(half_positions) {
+                const u16_t* half = (const u16_t*)(out + position->offset);
+                glm::vec3 decoded = glm::vec3(from_half(half[0]), from_half(half[1]), from_half(half[2])) * scale + offset;
+                max_error = std::max(max_error, glm::length(decoded - glm::vec3(source.x, source.y, source.z)));
+            }
+        }
+
+        mesh.layout = layout;
+        mesh.vertex_data = std::move(data);
+        mesh.position_scale = scale;
+        mesh.position_offset = offset;
+
+        QuantizeReport result;
+        result.source_bytes = vertex_count * sizeof(Vertex) + (source_normals ? vertex_count * sizeof(glm::vec3) : 0);
+        result.packed_bytes = mesh.vertex_data.size();
+        result.max_position_error = max_error;
+
+        LOG("Vertices packed: %llu -> %llu bytes (%u byte stride, %.1f%% saved, max position error %g)",
+            result.source_bytes, result.packed_bytes, (u32_t)layout.stride,
+            100.0 * (1.0 - (f64_t)result.packed_bytes / (f64_t)result.source_bytes),
+            (f64_t)max_error);
+
+        PXL_METRIC_ADD("assets.vertex_bytes_saved",
+            (f64_t)(result.source_bytes > result.packed_bytes ? result.source_bytes - result.packed_bytes : 0));
+
+        if(report) *report = result;
+        return true;
+    }
+
+};
+};
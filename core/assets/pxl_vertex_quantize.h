@@ -0,0 +1,67 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_VERTEX_QUANTIZE_H
+#define PXL_VERTEX_QUANTIZE_H
+
+#include "core/renderer/pxl_renderer_backend.h"
+
+// Import time vertex packing. Takes a mesh's f32 vertices, writes them into
+// mesh.vertex_data with any VertexLayout and sets up the position decode.
+// The f32 vertices are left alone, generate LODs / bounds from them first and
+// clear them afterwards if the CPU copy isn't needed
+
+struct QuantizeReport {
+    u64_t source_bytes = 0;
+    u64_t packed_bytes = 0;
+    f32_t max_position_error = 0.0f;    // object space, after decoding
+};
+
+namespace pxl {
+namespace vertex {
+
+    // Round to nearest even, overflow goes to infinity
+    u16_t to_half(f32_t value);
+    f32_t from_half(u16_t value);
+
+    // Unit vector -> square in -1..1 (Cigolle et al.), decode in the shader
+    glm::vec2 encode_octahedral(const glm::vec3& normal);
+    glm::vec3 decode_octahedral(const glm::vec2& encoded);
+
+    // Positions take FLOAT3 / FLOAT4 / HALF4, half positions get normalized to the
+    // mesh's box. Normals are taken from `normals` (one per vertex) or averaged from
+    // the triangles when the layout asks for them and none are given
+    bool quantize(
+        Mesh& mesh, const VertexLayout& layout,
+        QuantizeReport* report = nullptr,
+        const std::vector<glm::vec3>* normals = nullptr);
+
+};
+};
+
+#endif
@@ -30,9 +30,12 @@
 #define CONFIG_H
 
 // #define PIXL_LOGGER_ENABLED
+// #define PXL_PROFILER_ENABLED     // see core/debug/pxl_profiler.h
 
 #include "version.h"
 
+#include "misc/utility/types.h"
+
 #define PIXL_RENDERER_BACKEND_OPENGL
 #define PIXL_RENDERER_BACKEND_VULKAN
 #define PIXL_RENDERER_BACKEND_DX3D12
@@ -46,4 +49,51 @@ struct WindowConfig {
     const char* title = ENGINE_TITLE;
 };
 
+// HEADLESS skips the window / GL context entirely and renders into the NullRenderer,
+// so the tick path can run on servers and CI boxes without a display :)*
+enum class EngineMode {
+    WINDOWED,
+    HEADLESS
+};
+
+// POOLED sub-allocates every mesh from a few shared buffers with one VAO, so draws
+// between meshes don't switch VAOs and can be batched into multi draws
+enum class MeshStorage {
+    SEPARATE,
+    POOLED
+};
+
+// Mesh bytes the GL41Renderer copies to the GPU per frame, see gl41_upload_queue.h
+#ifndef PXL_UPLOAD_BUDGET_BYTES
+#define PXL_UPLOAD_BUDGET_BYTES (4 << 20)
+#endif
+
+// Bytes of resident texture mips before the least recently used ones get dropped,
+// see core/renderer/pxl_texture_manager.h
+#ifndef PXL_TEXTURE_BUDGET_BYTES
+#define PXL_TEXTURE_BUDGET_BYTES (256ull << 20)
+#endif
+
+// Linked program binaries (glGetProgramBinary) land here, relative to the working
+// directory. See core/renderer/gl41_program_cache.h
+#ifndef PXL_SHADER_CACHE_DIR
+#define PXL_SHADER_CACHE_DIR "cache/shaders"
+#endif
+
+struct EngineConfig {
+    EngineMode mode = EngineMode::WINDOWED;
+
+    f32_t tick_rate = 60.0f;    // fixed ticks per second, tick() always receives 1 / tick_rate
+    bool unlocked = false;      // headless only: tick back to back instead of pacing to the wall clock
+    u64_t max_ticks = 0;        // 0 = run until stop() or the window closes
+
+    MeshStorage mesh_storage = MeshStorage::SEPARATE;
+    u64_t upload_budget = PXL_UPLOAD_BUDGET_BYTES;     // 0 = upload inside add_mesh()
+    u64_t texture_budget = PXL_TEXTURE_BUDGET_BYTES;
+    bool hot_reload = false;    // reload shaders / textures when their files change, see PXLRenderer::set_hot_reload()
+    bool metrics_overlay = false;   // windowed only: ImGui window with the live metrics (core/debug/pxl_metrics.h)
+
+    struct WindowConfig window;
+};
+
 #endif
@@ -0,0 +1,557 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pxl {
+namespace logger {
+
+    std::atomic<u8_t> global_log_level{(u8_t)LogLevel::LOG};
+
+    static const char* level_name(LogLevel level) {
+        switch(level) {
+            case LogLevel::LOG: return "LOG";
+            case LogLevel::WRN: return "WRN";
+            case LogLevel::ERR: return "ERR";
+            default:            return "???";
+        }
+    }
+
+    static const char* short_file(const char* path) {
+        const char* src_pos;
+
+        src_pos = strstr(path, "src\\");
+        if (src_pos) return src_pos;
+
+        src_pos = strstr(path, "src/");
+        if (src_pos) return src_pos;
+
+        const char* slash = strrchr(path, '/');
+        const char* backslash = strrchr(path, '\\');
+        const char* last = (slash > backslash) ? slash : backslash;
+
+        return last ? last + 1 : path;
+    }
+
+    class FileSink {
+
+    private:
+        std::string path;
+        FILE* file = nullptr;
+        size_t written = 0;
+        size_t max_bytes;
+        u32_t max_files;
+
+    public:
+        FileSink(const char* path, size_t max_bytes, u32_t max_files) :
+            path(path), max_bytes(max_bytes), max_files(max_files ? max_files : 1) {}
+
+        ~FileSink() {
+            if(file) fclose(file);
+        }
+
+        bool open() {
+            file = fopen(path.c_str(), "ab");
+            if(!file) return false;
+
+            fseek(file, 0, SEEK_END);
+            long size = ftell(file);
+            written = size > 0 ? (size_t)size : 0;
+            return true;
+        }
+
+        void write(const char* data, size_t size) {
+            if(!file) return;
+
+            if(max_bytes && written + size > max_bytes && written > 0)
+                rotate();
+
+            if(!file) return;
+
+            fwrite(data, 1, size, file);
+            written += size;
+        }
+
+        void flush() {
+            if(file) fflush(file);
+        }
+
+    private:
+
+        // log.txt -> log.txt.1 -> log.txt.2 ... oldest one falls off the end
+        void rotate() {
+            fclose(file);
+            file = nullptr;
+
+            std::string oldest = path + "." + std::to_string(max_files - 1);
+            remove(oldest.c_str());
+
+            for(u32_t i = max_files - 1; i > 1; i--) {
+                std::string from = path + "." + std::to_string(i - 1);
+                std::string to = path + "." + std::to_string(i);
+                rename(from.c_str(), to.c_str());
+            }
+
+            if(max_files > 1) {
+                std::string to = path + ".1";
+                rename(path.c_str(), to.c_str());
+            } else {
+                remove(path.c_str());
+            }
+
+            file = fopen(path.c_str(), "wb");
+            written = 0;
+        }
+    };
+
+    struct FormattedRecord {
+        u64_t timestamp;
+        size_t offset;
+        size_t size;
+    };
+
+    struct LoggerState {
+        std::atomic<LogQueue*> queues{nullptr};
+        std::atomic<u32_t> thread_count{0};
+
+        std::atomic<bool> running{false};
+        std::thread worker;
+        std::mutex worker_mutex;
+        std::condition_variable wake;
+
+        std::mutex sink_mutex;
+        std::vector<FileSink*> file_sinks;
+        bool console_enabled = true;
+
+        std::atomic<u64_t> records{0};
+        std::atomic<u64_t> bytes_written{0};
+        std::atomic<u64_t> producer_stalls{0};
+
+        ~LoggerState();
+    };
+
+    static LoggerState& state() {
+        static LoggerState _state;
+        return _state;
+    }
+
+    static void stop_worker(LoggerState& s) {
+        {
+            std::lock_guard<std::mutex> lock(s.worker_mutex);
+            if(!s.running.load(std::memory_order_relaxed)) return;
+            s.running.store(false, std::memory_order_release);
+        }
+
+        s.wake.notify_one();
+        if(s.worker.joinable()) s.worker.join();
+    }
+
+    LoggerState::~LoggerState() {
+        stop_worker(*this);
+        for(FileSink* sink : file_sinks) delete sink;
+    }
+
+    // printf replay of one conversion spec against one decoded argument
+    struct Decoder {
+        const u8_t* cursor;
+        const u8_t* end;
+
+        bool next(ArgType& type, u64_t& value, const char*& text, u32_t& length) {
+            if(cursor >= end) return false;
+
+            type = (ArgType)*cursor++;
+            if(type == ArgType::STRING) {
+                memcpy(&length, cursor, sizeof(u32_t));
+                text = (const char*)cursor + sizeof(u32_t);
+                cursor += sizeof(u32_t) + length;
+            } else {
+                memcpy(&value, cursor, sizeof(u64_t));
+                cursor += sizeof(u64_t);
+            }
+            return true;
+        }
+
+        s64_t next_int() {
+            ArgType type; u64_t value = 0; const char* text; u32_t length;
+            if(!next(type, value, text, length) || type == ArgType::STRING) return 0;
+            if(type == ArgType::DOUBLE) { f64_t d; memcpy(&d, &value, sizeof(d)); return (s64_t)d; }
+            return (s64_t)value;
+        }
+    };
+
+    static void append_spec(std::string& out, const char* spec, Decoder& decoder) {
+        // spec is "%[flags][width][.precision][length]conversion", length modifiers
+        // are dropped since every integer was widened to 64 bits at the call site
+        char clean[64];
+        size_t clean_size = 0;
+        int star_values[2];
+        int star_count = 0;
+
+        const char* c = spec;
+        char conversion = 0;
+
+        for(; *c; c++) {
+            if(strchr("hlLqjzt", *c)) continue;
+
+            if(*c == '*') {
+                if(star_count < 2) star_values[star_count++] = (int)decoder.next_int();
+            }
+
+            if(clean_size < sizeof(clean) - 4) clean[clean_size++] = *c;
+
+            if(c != spec && strchr("diouxXeEfFgGaAcspn", *c)) {
+                conversion = *c;
+                break;
+            }
+        }
+
+        clean[clean_size] = 0;
+        if(!conversion) {
+            out += spec;
+            return;
+        }
+
+        ArgType type = ArgType::INT;
+        u64_t value = 0;
+        const char* text = "";
+        u32_t length = 0;
+
+        if(!decoder.next(type, value, text, length)) {
+            out += "<missing>";
+            return;
+        }
+
+        char buffer[512];
+        int written = 0;
+
+        auto format = [&](const char* fmt, auto arg) {
+            if(star_count == 2)
+                written = snprintf(buffer, sizeof(buffer), fmt, star_values[0], star_values[1], arg);
+            else if(star_count == 1)
+                written = snprintf(buffer, sizeof(buffer), fmt, star_values[0], arg);
+            else
+                written = snprintf(buffer, sizeof(buffer), fmt, arg);
+        };
+
+        switch(conversion) {
+            case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': {
+                // put a 64 bit length modifier back in front of the conversion
+                char wide[sizeof(clean) + 2];
+                memcpy(wide, clean, clean_size - 1);
+                wide[clean_size - 1] = 'l';
+                wide[clean_size] = 'l';
+                wide[clean_size + 1] = conversion;
+                wide[clean_size + 2] = 0;
+
+                if(type == ArgType::DOUBLE) { f64_t d; memcpy(&d, &value, sizeof(d)); value = (u64_t)(s64_t)d; }
+                if(conversion == 'd' || conversion == 'i') format(wide, (long long)(s64_t)value);
+                else format(wide, (unsigned long long)value);
+                break;
+            }
+
+            case 'c':
+                format(clean, (int)value);
+                break;
+
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A': {
+                f64_t d;
+                if(type == ArgType::DOUBLE) memcpy(&d, &value, sizeof(d));
+                else d = (f64_t)(s64_t)value;
+                format(clean, d);
+                break;
+            }
+
+            case 's': {
+                if(type != ArgType::STRING) { out += "<not a string>"; return; }
+                if(strcmp(clean, "%s") == 0) { out.append(text, length); return; }
+                std::string copy(text, length);
+                format(clean, copy.c_str());
+                break;
+            }
+
+            case 'p':
+                format(clean, (void*)(uintptr_t)value);
+                break;
+
+            default:
+                break;
+        }
+
+        if(written > 0)
+            out.append(buffer, std::min((size_t)written, sizeof(buffer) - 1));
+    }
+
+    static void format_record(std::string& out, const RecordHeader* header) {
+        const LogSite* site = header->site;
+
+        Decoder decoder;
+        decoder.cursor = (const u8_t*)(header + 1);
+        decoder.end = (const u8_t*)header + header->size;
+
+        char prefix[256];
+        snprintf(prefix, sizeof(prefix), "[%s][%s:%d][%s] ",
+            level_name(site->level),
+            short_file(site->file),
+            site->line,
+            site->function);
+        out += prefix;
+
+        const char* c = site->format;
+        while(*c) {
+            if(*c != '%') {
+                const char* run = c;
+                while(*c && *c != '%') c++;
+                out.append(run, c - run);
+                continue;
+            }
+
+            if(c[1] == '%') {
+                out += '%';
+                c += 2;
+                continue;
+            }
+
+            const char* spec_end = c + 1;
+            while(*spec_end && !strchr("diouxXeEfFgGaAcspn", *spec_end)) spec_end++;
+            if(*spec_end) spec_end++;
+
+            char spec[64];
+            size_t spec_size = std::min((size_t)(spec_end - c), sizeof(spec) - 1);
+            memcpy(spec, c, spec_size);
+            spec[spec_size] = 0;
+
+            append_spec(out, spec, decoder);
+            c = spec_end;
+        }
+
+        out += '\n';
+    }
+
+    // Drains every queue, orders the batch by timestamp across threads and hands
+    // it to the sinks in one write each. Read positions only move once the batch
+    // is written, flush() waits on them
+    static bool drain(LoggerState& s, std::string& text, std::vector<FormattedRecord>& records,
+        std::vector<std::pair<LogQueue*, u64_t>>& consumed) {
+        text.clear();
+        records.clear();
+        consumed.clear();
+
+        std::string line;
+
+        for(LogQueue* queue = s.queues.load(std::memory_order_acquire); queue; queue = queue->next) {
+            u64_t read = queue->read_pos.load(std::memory_order_relaxed);
+            u64_t write = queue->write_pos.load(std::memory_order_acquire);
+
+            while(read < write) {
+                const RecordHeader* header =
+                    (const RecordHeader*)(queue->buffer + (read & (PXL_LOG_QUEUE_SIZE - 1)));
+
+                if(header->kind == RECORD_LOG) {
+                    line.clear();
+                    format_record(line, header);
+                    records.push_back({ header->timestamp, text.size(), line.size() });
+                    text += line;
+                }
+
+                read += header->size;
+            }
+
+            consumed.push_back({ queue, read });
+        }
+
+        if(records.empty()) {
+            // Nothing but wrap markers
+            for(auto& queue : consumed)
+                queue.first->read_pos.store(queue.second, std::memory_order_release);
+            return false;
+        }
+
+        std::stable_sort(records.begin(), records.end(),
+            [](const FormattedRecord& a, const FormattedRecord& b) {
+                return a.timestamp < b.timestamp;
+            }
+        );
+
+        std::string ordered;
+        ordered.reserve(text.size());
+        for(const auto& record : records)
+            ordered.append(text, record.offset, record.size);
+
+        {
+            std::lock_guard<std::mutex> lock(s.sink_mutex);
+
+            if(s.console_enabled) {
+                fwrite(ordered.data(), 1, ordered.size(), stdout);
+                fflush(stdout);
+            }
+
+            for(FileSink* sink : s.file_sinks) {
+                sink->write(ordered.data(), ordered.size());
+                sink->flush();
+            }
+        }
+
+        s.records.fetch_add(records.size(), std::memory_order_relaxed);
+        s.bytes_written.fetch_add(ordered.size(), std::memory_order_relaxed);
+
+        for(auto& queue : consumed)
+            queue.first->read_pos.store(queue.second, std::memory_order_release);
+        return true;
+    }
+
+    static void worker_main() {
+        LoggerState& s = state();
+
+        std::string text;
+        std::vector<FormattedRecord> records;
+        std::vector<std::pair<LogQueue*, u64_t>> consumed;
+
+        while(s.running.load(std::memory_order_acquire)) {
+            if(drain(s, text, records, consumed)) continue;
+
+            std::unique_lock<std::mutex> lock(s.worker_mutex);
+            s.wake.wait_for(lock, std::chrono::milliseconds(2));
+        }
+
+        while(drain(s, text, records, consumed)) {}
+    }
+
+    static void start_worker(LoggerState& s) {
+        std::lock_guard<std::mutex> lock(s.worker_mutex);
+        if(s.running.load(std::memory_order_relaxed)) return;
+
+        s.running.store(true, std::memory_order_release);
+        s.worker = std::thread(worker_main);
+    }
+
+    LogQueue* register_thread() {
+        LoggerState& s = state();
+
+        LogQueue* queue = new LogQueue();
+        queue->buffer = new u8_t[PXL_LOG_QUEUE_SIZE];
+        queue->thread_id = s.thread_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        queue->write_pos.store(0, std::memory_order_relaxed);
+        queue->read_pos.store(0, std::memory_order_relaxed);
+
+        // Queues are never unlinked so the worker can walk the list without a lock
+        LogQueue* head = s.queues.load(std::memory_order_relaxed);
+        do {
+            queue->next = head;
+        } while(!s.queues.compare_exchange_weak(
+            head, queue, std::memory_order_release, std::memory_order_relaxed));
+
+        if(!s.running.load(std::memory_order_acquire))
+            start_worker(s);
+
+        return queue;
+    }
+
+    bool wait_for_space(LogQueue* queue, u64_t needed) {
+        LoggerState& s = state();
+        s.producer_stalls.fetch_add(1, std::memory_order_relaxed);
+
+        u64_t pos = queue->write_pos.load(std::memory_order_relaxed);
+        while(PXL_LOG_QUEUE_SIZE - (pos - queue->read_pos.load(std::memory_order_acquire)) < needed) {
+            // nobody left to drain it after shutdown(), drop instead of hanging
+            if(!s.running.load(std::memory_order_acquire)) return false;
+
+            s.wake.notify_one();
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    void set_level(LogLevel level) {
+        global_log_level.store((u8_t)level, std::memory_order_relaxed);
+    }
+
+    LogLevel get_level() {
+        return (LogLevel)global_log_level.load(std::memory_order_relaxed);
+    }
+
+    void set_console_enabled(bool enabled) {
+        LoggerState& s = state();
+        std::lock_guard<std::mutex> lock(s.sink_mutex);
+        s.console_enabled = enabled;
+    }
+
+    bool add_file_sink(const char* path, size_t max_bytes, u32_t max_files) {
+        FileSink* sink = new FileSink(path, max_bytes, max_files);
+        if(!sink->open()) {
+            delete sink;
+            return false;
+        }
+
+        LoggerState& s = state();
+        std::lock_guard<std::mutex> lock(s.sink_mutex);
+        s.file_sinks.push_back(sink);
+        return true;
+    }
+
+    void flush() {
+        LoggerState& s = state();
+
+        std::vector<std::pair<LogQueue*, u64_t>> targets;
+        for(LogQueue* queue = s.queues.load(std::memory_order_acquire); queue; queue = queue->next)
+            targets.push_back({ queue, queue->write_pos.load(std::memory_order_acquire) });
+
+        if(!s.running.load(std::memory_order_acquire)) return;
+
+        for(auto& target : targets) {
+            while(target.first->read_pos.load(std::memory_order_acquire) < target.second) {
+                s.wake.notify_one();
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void shutdown() {
+        stop_worker(state());
+    }
+
+    LoggerStats get_stats() {
+        LoggerState& s = state();
+
+        LoggerStats stats;
+        stats.records = s.records.load(std::memory_order_relaxed);
+        stats.bytes_written = s.bytes_written.load(std::memory_order_relaxed);
+        stats.producer_stalls = s.producer_stalls.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+} // namespace logger
+} // namespace pxl
@@ -0,0 +1,261 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_LOGGER_H
+#define PXL_LOGGER_H
+
+#include "misc/utility/types.h"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#else
+    #include <chrono>
+#endif
+
+// Async binary logger behind LOG / WRN / ERR (misc/utility/log.h) :D*
+//
+// A call site only copies a pointer to its static LogSite plus the raw arguments
+// into the calling thread's ring buffer. Formatting, file name trimming and the
+// actual writes happen in batches on the logger thread.
+
+#ifndef PXL_LOG_QUEUE_SIZE
+#define PXL_LOG_QUEUE_SIZE (1u << 20)       // bytes per thread, power of two
+#endif
+
+namespace pxl {
+namespace logger {
+
+    enum class LogLevel : u8_t {
+        LOG = 0,
+        WRN,
+        ERR,
+        OFF
+    };
+
+    // One static instance per call site, never copied
+    struct LogSite {
+        LogLevel level;
+        const char* format;
+        const char* file;
+        int line;
+        const char* function;
+    };
+
+    enum class ArgType : u8_t {
+        INT,
+        UINT,
+        DOUBLE,
+        STRING,
+        POINTER
+    };
+
+    struct RecordHeader {
+        u32_t size;         // whole record, 8 byte aligned
+        u32_t kind;         // RECORD_LOG or RECORD_WRAP
+        const LogSite* site;
+        u64_t timestamp;
+    };
+
+    constexpr u32_t RECORD_LOG = 0;
+    constexpr u32_t RECORD_WRAP = 1;
+
+    // Single producer (the owning thread) / single consumer (the logger thread)
+    struct LogQueue {
+        u8_t* buffer;
+        LogQueue* next;
+        u32_t thread_id;
+
+        alignas(64) std::atomic<u64_t> write_pos;
+        alignas(64) std::atomic<u64_t> read_pos;
+    };
+
+    struct LoggerStats {
+        u64_t records;
+        u64_t bytes_written;
+        u64_t producer_stalls;  // times a caller waited on a full queue
+    };
+
+    extern std::atomic<u8_t> global_log_level;
+
+    LogQueue* register_thread();
+    bool wait_for_space(LogQueue* queue, u64_t needed);
+
+    void set_level(LogLevel level);
+    LogLevel get_level();
+
+    void set_console_enabled(bool enabled);
+
+    // Rotates to path.1 .. path.(max_files - 1) once the file passes max_bytes
+    bool add_file_sink(const char* path, size_t max_bytes = 8 * 1024 * 1024, u32_t max_files = 5);
+
+    // Blocks until everything logged before the call has been written
+    void flush();
+    void shutdown();
+
+    LoggerStats get_stats();
+
+    inline LogQueue* thread_queue() {
+        static thread_local LogQueue* t_queue = nullptr;
+        if(!t_queue) t_queue = register_thread();
+        return t_queue;
+    }
+
+    inline u64_t now_ticks() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return (u64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    // Argument encoding: 1 byte ArgType + 8 byte value, strings as 4 byte length + bytes
+
+    template<typename T>
+    inline size_t encoded_size(const T&, size_t*& lengths) {
+        using D = std::decay_t<T>;
+        static_assert(std::is_arithmetic<D>::value || std::is_enum<D>::value || std::is_pointer<D>::value,
+            "log arguments have to be printf compatible (numbers, enums, pointers, C strings)");
+        (void)lengths;
+        return 1 + sizeof(u64_t);
+    }
+
+    inline size_t encoded_size(const char* value, size_t*& lengths) {
+        size_t length = value ? strlen(value) : 6;
+        *lengths++ = length;
+        return 1 + sizeof(u32_t) + length;
+    }
+
+    inline size_t encoded_size(char* value, size_t*& lengths) {
+        return encoded_size((const char*)value, lengths);
+    }
+
+    inline u8_t* encode_raw(u8_t* out, ArgType type, const void* value) {
+        *out = (u8_t)type;
+        memcpy(out + 1, value, sizeof(u64_t));
+        return out + 1 + sizeof(u64_t);
+    }
+
+    template<typename T>
+    inline u8_t* encode(u8_t* out, const T& value, const size_t*& lengths) {
+        using D = std::decay_t<T>;
+        (void)lengths;
+
+        if constexpr(std::is_floating_point<D>::value) {
+            f64_t v = (f64_t)value;
+            return encode_raw(out, ArgType::DOUBLE, &v);
+        } else if constexpr(std::is_pointer<D>::value) {
+            u64_t v = (u64_t)(uintptr_t)value;
+            return encode_raw(out, ArgType::POINTER, &v);
+        } else if constexpr(std::is_enum<D>::value) {
+            s64_t v = (s64_t)value;
+            return encode_raw(out, ArgType::INT, &v);
+        } else if constexpr(std::is_signed<D>::value) {
+            s64_t v = (s64_t)value;
+            return encode_raw(out, ArgType::INT, &v);
+        } else {
+            u64_t v = (u64_t)value;
+            return encode_raw(out, ArgType::UINT, &v);
+        }
+    }
+
+    inline u8_t* encode(u8_t* out, const char* value, const size_t*& lengths) {
+        u32_t length = (u32_t)*lengths++;
+        *out = (u8_t)ArgType::STRING;
+        memcpy(out + 1, &length, sizeof(u32_t));
+        memcpy(out + 1 + sizeof(u32_t), value ? value : "(null)", length);
+        return out + 1 + sizeof(u32_t) + length;
+    }
+
+    inline u8_t* encode(u8_t* out, char* value, const size_t*& lengths) {
+        return encode(out, (const char*)value, lengths);
+    }
+
+    template<typename... Args>
+    inline void write(const LogSite* site, const Args&... args) {
+        if((u8_t)site->level < global_log_level.load(std::memory_order_relaxed)) return;
+
+        size_t lengths[sizeof...(Args) + 1];
+        size_t* length_out = lengths;
+
+        size_t size = sizeof(RecordHeader);
+        ((size += encoded_size(args, length_out)), ...);
+        (void)length_out;
+        size = (size + 7) & ~(size_t)7;
+
+        if(size > PXL_LOG_QUEUE_SIZE / 2) return;
+
+        LogQueue* queue = thread_queue();
+
+        u64_t pos = queue->write_pos.load(std::memory_order_relaxed);
+        u64_t offset = pos & (PXL_LOG_QUEUE_SIZE - 1);
+        u64_t to_end = PXL_LOG_QUEUE_SIZE - offset;
+        u64_t needed = size + (to_end < size ? to_end : 0);
+
+        if(PXL_LOG_QUEUE_SIZE - (pos - queue->read_pos.load(std::memory_order_acquire)) < needed &&
+           !wait_for_space(queue, needed))
+            return;
+
+        // Records never straddle the end of the ring, skip the tail instead
+        if(to_end < size) {
+            RecordHeader* wrap = (RecordHeader*)(queue->buffer + offset);
+            wrap->size = (u32_t)to_end;
+            wrap->kind = RECORD_WRAP;
+            pos += to_end;
+            offset = 0;
+        }
+
+        u8_t* out = queue->buffer + offset;
+
+        RecordHeader* header = (RecordHeader*)out;
+        header->size = (u32_t)size;
+        header->kind = RECORD_LOG;
+        header->site = site;
+        header->timestamp = now_ticks();
+
+        out += sizeof(RecordHeader);
+
+        const size_t* length_in = lengths;
+        ((out = encode(out, args, length_in)), ...);
+        (void)out;
+        (void)length_in;
+
+        queue->write_pos.store(pos + size, std::memory_order_release);
+    }
+
+} // namespace logger
+} // namespace pxl
+
+#endif
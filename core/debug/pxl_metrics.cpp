@@ -0,0 +1,387 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_metrics.h"
+
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pxl {
+namespace metrics {
+
+    std::atomic<u64_t> global_gauges[PXL_MAX_METRICS] = {};
+
+    struct Metric {
+        std::string name;
+        MetricType type;
+        u16_t histogram;
+
+        s64_t last_total = 0;               // counters: total at the previous end_frame
+        u64_t last_count = 0;               // histograms
+        f64_t last_sum = 0.0;
+
+        f64_t frame_value = 0.0;
+        f64_t total = 0.0;
+
+        u64_t buckets[PXL_HISTOGRAM_BUCKETS] = {};
+
+        std::vector<f32_t> history;
+    };
+
+    struct Registry {
+        std::mutex mutex;
+
+        std::vector<Metric> metrics;
+        u32_t histogram_count = 0;
+
+        std::atomic<MetricShard*> shards{nullptr};
+
+        u32_t history_frames = 600;
+        u32_t history_head = 0;             // next slot to write
+        u32_t history_filled = 0;           // slots written since the last resize
+        u64_t frame = 0;
+    };
+
+    static Registry& registry() {
+        static Registry _registry;
+        return _registry;
+    }
+
+    static const char* type_name(MetricType type) {
+        switch(type) {
+            case MetricType::COUNTER:   return "counter";
+            case MetricType::GAUGE:     return "gauge";
+            case MetricType::HISTOGRAM: return "histogram";
+        }
+        return "unknown";
+    }
+
+    static f64_t bucket_upper_bound(u32_t bucket) {
+        return std::pow(2.0, (f64_t)(bucket + 1) * 0.5 - 8.0);
+    }
+
+    MetricShard* register_thread() {
+        MetricShard* shard = new MetricShard();
+
+        for(auto& counter : shard->counters) counter.store(0, std::memory_order_relaxed);
+        for(auto& histogram : shard->buckets)
+            for(auto& bucket : histogram) bucket.store(0, std::memory_order_relaxed);
+        for(auto& sum : shard->sums) sum.store(0.0, std::memory_order_relaxed);
+
+        // Never unlinked, a finished thread's totals still count
+        Registry& r = registry();
+        MetricShard* head = r.shards.load(std::memory_order_relaxed);
+        do {
+            shard->next = head;
+        } while(!r.shards.compare_exchange_weak(
+            head, shard, std::memory_order_release, std::memory_order_relaxed));
+
+        return shard;
+    }
+
+    MetricId register_metric(const char* name, MetricType type) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        for(size_t i = 0; i < r.metrics.size(); i++) {
+            if(r.metrics[i].name == name) {
+                if(r.metrics[i].type != type) {
+                    ERR("Metric %s registered as %s and %s", name,
+                        type_name(r.metrics[i].type), type_name(type));
+                    return MetricId();
+                }
+
+                MetricId id;
+                id.index = (u16_t)i;
+                id.histogram = r.metrics[i].histogram;
+                return id;
+            }
+        }
+
+        if(r.metrics.size() >= PXL_MAX_METRICS) {
+            ERR("Out of metric slots (PXL_MAX_METRICS = %d): %s", PXL_MAX_METRICS, name);
+            return MetricId();
+        }
+
+        if(type == MetricType::HISTOGRAM && r.histogram_count >= PXL_MAX_HISTOGRAMS) {
+            ERR("Out of histogram slots (PXL_MAX_HISTOGRAMS = %d): %s", PXL_MAX_HISTOGRAMS, name);
+            return MetricId();
+        }
+
+        Metric metric;
+        metric.name = name;
+        metric.type = type;
+        metric.histogram = type == MetricType::HISTOGRAM ? (u16_t)r.histogram_count++ : 0xFFFF;
+        metric.history.assign(r.history_frames, 0.0f);
+
+        r.metrics.push_back(std::move(metric));
+
+        MetricId id;
+        id.index = (u16_t)(r.metrics.size() - 1);
+        id.histogram = r.metrics.back().histogram;
+        return id;
+    }
+
+    void end_frame() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        MetricShard* shards = r.shards.load(std::memory_order_acquire);
+
+        for(size_t i = 0; i < r.metrics.size(); i++) {
+            Metric& metric = r.metrics[i];
+
+            switch(metric.type) {
+                case MetricType::COUNTER: {
+                    s64_t total = 0;
+                    for(MetricShard* shard = shards; shard; shard = shard->next)
+                        total += shard->counters[i].load(std::memory_order_relaxed);
+
+                    metric.frame_value = (f64_t)(total - metric.last_total);
+                    metric.total = (f64_t)total;
+                    metric.last_total = total;
+                    break;
+                }
+
+                case MetricType::GAUGE: {
+                    u64_t bits = global_gauges[i].load(std::memory_order_relaxed);
+                    memcpy(&metric.frame_value, &bits, sizeof(f64_t));
+                    metric.total = metric.frame_value;
+                    break;
+                }
+
+                case MetricType::HISTOGRAM: {
+                    u64_t count = 0;
+                    f64_t sum = 0.0;
+
+                    for(u32_t b = 0; b < PXL_HISTOGRAM_BUCKETS; b++) {
+                        u64_t bucket = 0;
+                        for(MetricShard* shard = shards; shard; shard = shard->next)
+                            bucket += shard->buckets[metric.histogram][b].load(std::memory_order_relaxed);
+                        metric.buckets[b] = bucket;
+                        count += bucket;
+                    }
+
+                    for(MetricShard* shard = shards; shard; shard = shard->next)
+                        sum += shard->sums[metric.histogram].load(std::memory_order_relaxed);
+
+                    u64_t frame_count = count - metric.last_count;
+                    metric.frame_value = frame_count ? (sum - metric.last_sum) / (f64_t)frame_count : 0.0;
+                    metric.total = count ? sum / (f64_t)count : 0.0;
+                    metric.last_count = count;
+                    metric.last_sum = sum;
+                    break;
+                }
+            }
+
+            metric.history[r.history_head] = (f32_t)metric.frame_value;
+        }
+
+        r.history_head = (r.history_head + 1) % r.history_frames;
+        if(r.history_filled < r.history_frames) r.history_filled++;
+        r.frame++;
+    }
+
+    void set_history_frames(u32_t frames) {
+        if(frames == 0) frames = 1;
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        r.history_frames = frames;
+        r.history_head = 0;
+        r.history_filled = 0;
+
+        for(Metric& metric : r.metrics)
+            metric.history.assign(frames, 0.0f);
+    }
+
+    f64_t get_frame_value(MetricId id) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        return id.index < r.metrics.size() ? r.metrics[id.index].frame_value : 0.0;
+    }
+
+    f64_t get_total(MetricId id) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        return id.index < r.metrics.size() ? r.metrics[id.index].total : 0.0;
+    }
+
+    static f64_t percentile_of(const Metric& metric, f64_t percentile) {
+        u64_t count = 0;
+        for(u64_t bucket : metric.buckets) count += bucket;
+        if(!count) return 0.0;
+
+        u64_t target = (u64_t)(percentile * (f64_t)count);
+        u64_t seen = 0;
+        for(u32_t b = 0; b < PXL_HISTOGRAM_BUCKETS; b++) {
+            seen += metric.buckets[b];
+            if(seen > target) return bucket_upper_bound(b);
+        }
+        return bucket_upper_bound(PXL_HISTOGRAM_BUCKETS - 1);
+    }
+
+    f64_t get_percentile(MetricId id, f64_t percentile) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        if(id.index >= r.metrics.size() || r.metrics[id.index].type != MetricType::HISTOGRAM)
+            return 0.0;
+
+        return percentile_of(r.metrics[id.index], percentile);
+    }
+
+    // Oldest frame first
+    static u32_t history_count(const Registry& r) {
+        return r.history_filled;
+    }
+
+    static u32_t history_slot(const Registry& r, u32_t i) {
+        u32_t count = history_count(r);
+        return (r.history_head + r.history_frames - count + i) % r.history_frames;
+    }
+
+    bool dump_csv(const char* path) {
+        FILE* file = fopen(path, "wb");
+        if(!file) {
+            ERR("Failed to open metrics file: %s", path);
+            return false;
+        }
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        fprintf(file, "frame");
+        for(const Metric& metric : r.metrics)
+            fprintf(file, ",%s", metric.name.c_str());
+        fprintf(file, "\n");
+
+        u32_t count = history_count(r);
+        u64_t first_frame = r.frame - count;
+
+        for(u32_t i = 0; i < count; i++) {
+            u32_t slot = history_slot(r, i);
+
+            fprintf(file, "%llu", (unsigned long long)(first_frame + i));
+            for(const Metric& metric : r.metrics)
+                fprintf(file, ",%g", (f64_t)metric.history[slot]);
+            fprintf(file, "\n");
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    bool dump_json(const char* path) {
+        FILE* file = fopen(path, "wb");
+        if(!file) {
+            ERR("Failed to open metrics file: %s", path);
+            return false;
+        }
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        u32_t count = history_count(r);
+
+        fprintf(file, "{\"frame\":%llu,\"history_frames\":%u,\"metrics\":[",
+            (unsigned long long)r.frame, count);
+
+        for(size_t m = 0; m < r.metrics.size(); m++) {
+            const Metric& metric = r.metrics[m];
+
+            fprintf(file, "%s\n{\"name\":\"%s\",\"type\":\"%s\",\"value\":%g,\"total\":%g",
+                m ? "," : "", metric.name.c_str(), type_name(metric.type),
+                metric.frame_value, metric.total);
+
+            if(metric.type == MetricType::HISTOGRAM) {
+                fprintf(file, ",\"p50\":%g,\"p95\":%g,\"p99\":%g",
+                    percentile_of(metric, 0.50),
+                    percentile_of(metric, 0.95),
+                    percentile_of(metric, 0.99));
+            }
+
+            fprintf(file, ",\"history\":[");
+            for(u32_t i = 0; i < count; i++)
+                fprintf(file, "%s%g", i ? "," : "", (f64_t)metric.history[history_slot(r, i)]);
+            fprintf(file, "]}");
+        }
+
+        fprintf(file, "\n]}\n");
+        fclose(file);
+        return true;
+    }
+
+    void for_each_overlay_row(void (*callback)(const OverlayRow& row, void* user), void* user) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        u32_t count = history_count(r);
+
+        for(const Metric& metric : r.metrics) {
+            OverlayRow row;
+            row.name = metric.name.c_str();
+            row.type = metric.type;
+            row.value = metric.frame_value;
+            row.total = metric.total;
+            row.p50 = metric.type == MetricType::HISTOGRAM ? percentile_of(metric, 0.50) : 0.0;
+            row.p99 = metric.type == MetricType::HISTOGRAM ? percentile_of(metric, 0.99) : 0.0;
+            // Until the ring wraps the filled slots start at 0
+            row.history = metric.history.data();
+            row.history_size = count;
+            row.history_offset = count < r.history_frames ? 0 : r.history_head;
+
+            row.min = 0.0f;
+            row.max = 0.0f;
+            row.average = 0.0f;
+
+            if(count) {
+                f64_t sum = 0.0;
+                row.min = metric.history[history_slot(r, 0)];
+                row.max = row.min;
+                for(u32_t i = 0; i < count; i++) {
+                    f32_t value = metric.history[history_slot(r, i)];
+                    row.min = std::min(row.min, value);
+                    row.max = std::max(row.max, value);
+                    sum += value;
+                }
+                row.average = (f32_t)(sum / count);
+            }
+
+            callback(row, user);
+        }
+    }
+
+} // namespace metrics
+} // namespace pxl
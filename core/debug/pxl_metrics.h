@@ -0,0 +1,174 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_METRICS_H
+#define PXL_METRICS_H
+
+#include "misc/utility/types.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+// Live counters / gauges / histograms with per-frame history :)*
+//
+// Names are interned once (cache the id, the PXL_METRIC_* macros do that for you).
+// Counters and histograms write into the calling thread's shard with relaxed
+// atomics, the main thread folds every shard together in end_frame().
+
+#ifndef PXL_MAX_METRICS
+#define PXL_MAX_METRICS 256
+#endif
+
+#ifndef PXL_MAX_HISTOGRAMS
+#define PXL_MAX_HISTOGRAMS 32
+#endif
+
+#define PXL_HISTOGRAM_BUCKETS 64
+
+namespace pxl {
+namespace metrics {
+
+    enum class MetricType : u8_t {
+        COUNTER,        // monotonic, history keeps the per-frame delta
+        GAUGE,          // last value set
+        HISTOGRAM       // samples, history keeps the per-frame mean
+    };
+
+    struct MetricId {
+        u16_t index = 0xFFFF;
+        u16_t histogram = 0xFFFF;
+
+        bool valid() const { return index != 0xFFFF; }
+    };
+
+    // Owned by one thread, read by end_frame()
+    struct MetricShard {
+        std::atomic<s64_t> counters[PXL_MAX_METRICS];
+        std::atomic<u64_t> buckets[PXL_MAX_HISTOGRAMS][PXL_HISTOGRAM_BUCKETS];
+        std::atomic<f64_t> sums[PXL_MAX_HISTOGRAMS];
+        MetricShard* next;
+    };
+
+    extern std::atomic<u64_t> global_gauges[PXL_MAX_METRICS];
+
+    MetricShard* register_thread();
+
+    inline MetricShard* thread_shard() {
+        static thread_local MetricShard* t_shard = nullptr;
+        if(!t_shard) t_shard = register_thread();
+        return t_shard;
+    }
+
+    // Same name always gives back the same id, asserts if the type differs
+    MetricId register_metric(const char* name, MetricType type);
+
+    inline u32_t histogram_bucket(f64_t value) {
+        // half octave buckets from 2^-8 up to 2^23.5
+        if(value <= 0.00390625) return 0;
+
+        int exponent;
+        f64_t mantissa = frexp(value, &exponent);    // value = mantissa * 2^exponent, mantissa in [0.5, 1)
+        s32_t bucket = (exponent + 7) * 2 + (mantissa >= 0.70710678 ? 1 : 0);
+
+        if(bucket < 0) return 0;
+        if(bucket >= PXL_HISTOGRAM_BUCKETS) return PXL_HISTOGRAM_BUCKETS - 1;
+        return (u32_t)bucket;
+    }
+
+    // Single writer per shard so a relaxed load + store is enough, no lock prefix
+    inline void add(MetricId id, s64_t value = 1) {
+        if(!id.valid()) return;
+        std::atomic<s64_t>& counter = thread_shard()->counters[id.index];
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    inline void set(MetricId id, f64_t value) {
+        if(!id.valid()) return;
+        u64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        global_gauges[id.index].store(bits, std::memory_order_relaxed);
+    }
+
+    inline void record(MetricId id, f64_t value) {
+        if(!id.valid() || id.histogram == 0xFFFF) return;
+
+        MetricShard* shard = thread_shard();
+
+        std::atomic<u64_t>& bucket = shard->buckets[id.histogram][histogram_bucket(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        std::atomic<f64_t>& sum = shard->sums[id.histogram];
+        sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    // Call once per frame from the main thread (Engine::run does)
+    void end_frame();
+
+    // Frames of history kept per metric, 600 = 10 seconds at 60 fps
+    void set_history_frames(u32_t frames);
+
+    f64_t get_frame_value(MetricId id);
+    f64_t get_total(MetricId id);
+    f64_t get_percentile(MetricId id, f64_t percentile);
+
+    bool dump_csv(const char* path);
+    bool dump_json(const char* path);
+
+    // ImGui window, call between ImGui::NewFrame() and ImGui::Render()
+    void draw_overlay(bool* open = nullptr);
+
+    // Snapshot handed to the overlay (pxl_metrics_overlay.cpp) under the registry lock
+    struct OverlayRow {
+        const char* name;
+        MetricType type;
+        f64_t value;
+        f64_t total;
+        f64_t p50;
+        f64_t p99;
+        f32_t min;
+        f32_t max;
+        f32_t average;
+        const f32_t* history;
+        u32_t history_size;
+        u32_t history_offset;
+    };
+
+    void for_each_overlay_row(void (*callback)(const OverlayRow& row, void* user), void* user);
+
+} // namespace metrics
+} // namespace pxl
+
+#define PXL_METRIC_ID(name, type) \
+    ([]() { static const pxl::metrics::MetricId _id = pxl::metrics::register_metric(name, type); return _id; }())
+
+#define PXL_METRIC_ADD(name, value)     pxl::metrics::add(PXL_METRIC_ID(name, pxl::metrics::MetricType::COUNTER), value)
+#define PXL_METRIC_SET(name, value)     pxl::metrics::set(PXL_METRIC_ID(name, pxl::metrics::MetricType::GAUGE), value)
+#define PXL_METRIC_RECORD(name, value)  pxl::metrics::record(PXL_METRIC_ID(name, pxl::metrics::MetricType::HISTOGRAM), value)
+
+#endif
@@ -0,0 +1,89 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_metrics.h"
+
+#include <imgui.h>
+
+namespace pxl {
+namespace metrics {
+
+    static void draw_row(const OverlayRow& row, void*) {
+        ImGui::TableNextRow();
+
+        ImGui::TableSetColumnIndex(0);
+        ImGui::TextUnformatted(row.name);
+
+        ImGui::TableSetColumnIndex(1);
+        ImGui::Text("%.3f", row.value);
+
+        ImGui::TableSetColumnIndex(2);
+        ImGui::Text("%.3f / %.3f / %.3f", row.min, row.average, row.max);
+
+        ImGui::TableSetColumnIndex(3);
+        if(row.type == MetricType::HISTOGRAM)
+            ImGui::Text("p50 %.3f  p99 %.3f", row.p50, row.p99);
+        else if(row.type == MetricType::COUNTER)
+            ImGui::Text("total %.0f", row.total);
+
+        ImGui::TableSetColumnIndex(4);
+        ImGui::PushID(row.name);
+        ImGui::PlotLines("##history", row.history, (int)row.history_size, (int)row.history_offset,
+            nullptr, row.min, row.max > row.min ? row.max : row.min + 1.0f, ImVec2(-1.0f, 24.0f));
+        ImGui::PopID();
+    }
+
+    void draw_overlay(bool* open) {
+        ImGui::SetNextWindowSize(ImVec2(720.0f, 420.0f), ImGuiCond_FirstUseEver);
+        if(!ImGui::Begin("Pixl Metrics", open)) {
+            ImGui::End();
+            return;
+        }
+
+        ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                                ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+        if(ImGui::BeginTable("metrics", 5, flags)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Metric");
+            ImGui::TableSetupColumn("Frame");
+            ImGui::TableSetupColumn("Min / Avg / Max");
+            ImGui::TableSetupColumn("Summary");
+            ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+
+            for_each_overlay_row(draw_row, nullptr);
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+
+} // namespace metrics
+} // namespace pxl
@@ -0,0 +1,208 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_profiler.h"
+
+#if defined(PXL_PROFILER_ENABLED) && !defined(PXL_PROFILER_TRACY)
+
+#include "misc/utility/log.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace pxl {
+namespace profiler {
+
+    constexpr u32_t FRAME_HISTORY = 4096;
+
+    std::atomic<bool> global_profiler_enabled{true};
+    std::atomic<u32_t> global_profiler_frame{0};
+
+    static std::atomic<ThreadBuffer*> global_thread_buffers{nullptr};
+    static std::atomic<u32_t> global_thread_count{0};
+
+    static u64_t global_frame_ticks[FRAME_HISTORY] = {};
+
+    struct Calibration {
+        u64_t ticks;
+        u64_t ns;
+    };
+
+    static u64_t steady_ns() {
+        return (u64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Taken on first use, the export takes a second sample to get ticks -> ns
+    static const Calibration global_calibration = { now_ticks(), steady_ns() };
+
+    ThreadBuffer* register_thread() {
+        ThreadBuffer* buffer = new ThreadBuffer();
+        buffer->events = new ProfileEvent[PXL_PROFILER_EVENTS_PER_THREAD];
+        buffer->write_index.store(0, std::memory_order_relaxed);
+        buffer->depth = 0;
+        buffer->thread_id = global_thread_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        snprintf(buffer->thread_name, sizeof(buffer->thread_name), "thread %u", buffer->thread_id);
+
+        // Lock-free push, buffers live until exit so the export can still see
+        // threads that already finished
+        ThreadBuffer* head = global_thread_buffers.load(std::memory_order_relaxed);
+        do {
+            buffer->next = head;
+        } while(!global_thread_buffers.compare_exchange_weak(
+            head, buffer, std::memory_order_release, std::memory_order_relaxed));
+
+        return buffer;
+    }
+
+    void set_enabled(bool enabled) {
+        global_profiler_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool is_enabled() {
+        return global_profiler_enabled.load(std::memory_order_relaxed);
+    }
+
+    void set_thread_name(const char* name) {
+        ThreadBuffer* buffer = thread_buffer();
+        snprintf(buffer->thread_name, sizeof(buffer->thread_name), "%s", name);
+    }
+
+    void mark_frame() {
+        u32_t frame = global_profiler_frame.fetch_add(1, std::memory_order_relaxed) + 1;
+        global_frame_ticks[frame % FRAME_HISTORY] = now_ticks();
+    }
+
+    void clear() {
+        for(ThreadBuffer* buffer = global_thread_buffers.load(std::memory_order_acquire);
+            buffer; buffer = buffer->next) {
+            buffer->write_index.store(0, std::memory_order_release);
+        }
+    }
+
+    static f64_t ns_per_tick() {
+#if PXL_PROFILER_RDTSC
+        u64_t ticks = now_ticks();
+        u64_t ns = steady_ns();
+
+        // Too short of a window gives a garbage ratio
+        if(ns - global_calibration.ns < 10000000) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            ticks = now_ticks();
+            ns = steady_ns();
+        }
+
+        return (f64_t)(ns - global_calibration.ns) / (f64_t)(ticks - global_calibration.ticks);
+#else
+        return 1.0;
+#endif
+    }
+
+    static void write_json_string(FILE* file, const char* text) {
+        fputc('"', file);
+        for(const char* c = text; *c; c++) {
+            if(*c == '"' || *c == '\\') fputc('\\', file);
+            if((unsigned char)*c < 0x20) continue;
+            fputc(*c, file);
+        }
+        fputc('"', file);
+    }
+
+    bool export_chrome_trace(const char* path) {
+        FILE* file = fopen(path, "wb");
+        if(!file) {
+            ERR("Failed to open trace file: %s", path);
+            return false;
+        }
+
+        const f64_t tick_to_us = ns_per_tick() / 1000.0;
+        const u64_t base = global_calibration.ticks;
+
+        auto to_us = [&](u64_t ticks) {
+            return ticks > base ? (f64_t)(ticks - base) * tick_to_us : 0.0;
+        };
+
+        fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}");
+
+        size_t event_count = 0;
+
+        for(ThreadBuffer* buffer = global_thread_buffers.load(std::memory_order_acquire);
+            buffer; buffer = buffer->next) {
+
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                buffer->thread_id);
+            write_json_string(file, buffer->thread_name);
+            fprintf(file, "}}");
+
+            u64_t end = buffer->write_index.load(std::memory_order_acquire);
+            u64_t begin = end > PXL_PROFILER_EVENTS_PER_THREAD ? end - PXL_PROFILER_EVENTS_PER_THREAD : 0;
+
+            for(u64_t i = begin; i < end; i++) {
+                const ProfileEvent& event = buffer->events[i & (PXL_PROFILER_EVENTS_PER_THREAD - 1)];
+
+                fprintf(file, ",\n{\"name\":");
+                write_json_string(file, event.name);
+                fprintf(file, ",\"cat\":\"pxl\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                              "\"args\":{\"depth\":%u,\"frame\":%u}}",
+                    buffer->thread_id,
+                    to_us(event.start),
+                    to_us(event.end) - to_us(event.start),
+                    event.depth,
+                    event.frame);
+
+                event_count++;
+            }
+        }
+
+        // Frames as back to back zones on their own track
+        u32_t last_frame = global_profiler_frame.load(std::memory_order_relaxed);
+        u32_t first_frame = last_frame > FRAME_HISTORY - 1 ? last_frame - (FRAME_HISTORY - 1) : 1;
+
+        for(u32_t frame = first_frame; frame < last_frame; frame++) {
+            u64_t start = global_frame_ticks[frame % FRAME_HISTORY];
+            u64_t end = global_frame_ticks[(frame + 1) % FRAME_HISTORY];
+
+            fprintf(file, ",\n{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+                          "\"ts\":%.3f,\"dur\":%.3f}",
+                frame, to_us(start), to_us(end) - to_us(start));
+        }
+
+        fprintf(file, "\n]}\n");
+        fclose(file);
+
+        LOG("Exported %zu profile events to %s", event_count, path);
+        return true;
+    }
+
+} // namespace profiler
+} // namespace pxl
+
+#endif
@@ -0,0 +1,184 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_PROFILER_H
+#define PXL_PROFILER_H
+
+#include "core/config.h"
+#include "misc/utility/types.h"
+
+#include <atomic>
+
+// Hierarchical CPU profiler :)*
+//
+//  -DPXL_PROFILER_ENABLED      record zones into per-thread ring buffers, export with
+//                              pxl::profiler::export_chrome_trace() (chrome://tracing, perfetto)
+//  -DPXL_PROFILER_TRACY        forward the same macros to Tracy instead (needs tracy on the include path)
+//
+// With neither defined every macro below is ((void)0) and nothing is linked in.
+// Zone names must be string literals (only the pointer is stored).
+
+#define PXL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PXL_PROFILE_CONCAT(a, b) PXL_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(PXL_PROFILER_TRACY)
+    #include <tracy/Tracy.hpp>
+
+    #define PXL_PROFILE_SCOPE(name)         ZoneScopedN(name)
+    #define PXL_PROFILE_FUNCTION()          ZoneScoped
+    #define PXL_PROFILE_FRAME()             FrameMark
+    #define PXL_PROFILE_THREAD(name)        tracy::SetThreadName(name)
+#elif defined(PXL_PROFILER_ENABLED)
+    #define PXL_PROFILE_SCOPE(name) \
+        pxl::profiler::Scope PXL_PROFILE_CONCAT(_pxl_profile_scope_, __LINE__)(name)
+    #define PXL_PROFILE_FUNCTION()          PXL_PROFILE_SCOPE(__func__)
+    #define PXL_PROFILE_FRAME()             pxl::profiler::mark_frame()
+    #define PXL_PROFILE_THREAD(name)        pxl::profiler::set_thread_name(name)
+#else
+    #define PXL_PROFILE_SCOPE(name)         ((void)0)
+    #define PXL_PROFILE_FUNCTION()          ((void)0)
+    #define PXL_PROFILE_FRAME()             ((void)0)
+    #define PXL_PROFILE_THREAD(name)        ((void)0)
+#endif
+
+#if defined(PXL_PROFILER_ENABLED) && !defined(PXL_PROFILER_TRACY)
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define PXL_PROFILER_RDTSC 1
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#else
+    #define PXL_PROFILER_RDTSC 0
+    #include <chrono>
+#endif
+
+#ifndef PXL_PROFILER_EVENTS_PER_THREAD
+#define PXL_PROFILER_EVENTS_PER_THREAD (1u << 16)     // power of two, 32 bytes each
+#endif
+
+namespace pxl {
+namespace profiler {
+
+    struct ProfileEvent {
+        const char* name;
+        u64_t start;        // raw ticks, converted to ns on export
+        u64_t end;
+        u32_t depth;
+        u32_t frame;
+    };
+
+    // One per thread, only the owning thread writes. Export reads everything below
+    // write_index (acquire) so no locks on the hot path :D*
+    struct ThreadBuffer {
+        ProfileEvent* events;
+        std::atomic<u64_t> write_index;
+        u32_t depth;
+        u32_t thread_id;
+        char thread_name[32];
+        ThreadBuffer* next;
+    };
+
+    extern std::atomic<bool> global_profiler_enabled;
+    extern std::atomic<u32_t> global_profiler_frame;
+
+    ThreadBuffer* register_thread();
+
+    inline ThreadBuffer* thread_buffer() {
+        static thread_local ThreadBuffer* t_buffer = nullptr;
+        if(!t_buffer) t_buffer = register_thread();
+        return t_buffer;
+    }
+
+    inline u64_t now_ticks() {
+#if PXL_PROFILER_RDTSC
+        return __rdtsc();
+#else
+        return (u64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    class Scope {
+
+    private:
+        const char* name;
+        ThreadBuffer* buffer;
+        u64_t start;
+
+    public:
+        explicit Scope(const char* name) : name(name), buffer(nullptr), start(0) {
+            if(!global_profiler_enabled.load(std::memory_order_relaxed)) return;
+
+            buffer = thread_buffer();
+            buffer->depth++;
+            start = now_ticks();
+        }
+
+        ~Scope() {
+            if(!buffer) return;
+
+            u64_t end = now_ticks();
+            buffer->depth--;
+
+            u64_t index = buffer->write_index.load(std::memory_order_relaxed);
+            ProfileEvent& event = buffer->events[index & (PXL_PROFILER_EVENTS_PER_THREAD - 1)];
+            event.name = name;
+            event.start = start;
+            event.end = end;
+            event.depth = buffer->depth;
+            event.frame = global_profiler_frame.load(std::memory_order_relaxed);
+
+            buffer->write_index.store(index + 1, std::memory_order_release);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    void set_enabled(bool enabled);
+    bool is_enabled();
+
+    void set_thread_name(const char* name);
+    void mark_frame();
+
+    // Drops everything recorded so far, call it with zones quiet (between frames)
+    void clear();
+
+    // Chrome trace event JSON, open in chrome://tracing or ui.perfetto.dev.
+    // Stop recording first (set_enabled(false)) or the newest events may be torn
+    bool export_chrome_trace(const char* path);
+
+} // namespace profiler
+} // namespace pxl
+
+#endif
+
+#endif
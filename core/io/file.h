@@ -33,8 +33,10 @@
 #include <fstream>
 #include <string>
 #include <cstring>
+#include <vector>
 
 #include "misc/utility/log.h"
+#include "misc/utility/types.h"
 
 namespace file{
     inline const char* load_shader(const char* shaderFile) {
@@ -50,6 +52,19 @@ namespace file{
         std::memcpy(buffer, content.c_str(), content.size() + 1);
         return buffer; 
     }
+
+    // Whole file into `out`, false if it can't be opened
+    inline bool read_binary(const char* path, std::vector<u8_t>& out) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if(!file) return false;
+
+        std::streamsize size = file.tellg();
+        if(size < 0) return false;
+        file.seekg(0);
+
+        out.resize((size_t)size);
+        return size == 0 || (bool)file.read((char*)out.data(), size);
+    }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,272 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_file_watcher.h"
+
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+static f64_t now_ms() {
+    return std::chrono::duration<f64_t, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Missing files (halfway through a rename) read as 0 / 0 and count as changed
+// once they're back
+static void stat_file(const std::string& path, s64_t& write_time, u64_t& size) {
+    std::error_code error;
+
+    auto time = std::filesystem::last_write_time(path, error);
+    write_time = error ? 0 : (s64_t)time.time_since_epoch().count();
+
+    u64_t bytes = (u64_t)std::filesystem::file_size(path, error);
+    size = error ? 0 : bytes;
+}
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+void FileWatcher::watch(const char* path) {
+    std::lock_guard<std::mutex> guard(lock);
+    if(!known.insert(path).second) return;
+
+    paths.emplace_back(path);
+}
+
+void FileWatcher::start() {
+    if(running.exchange(true)) return;
+    worker = std::thread(&FileWatcher::run, this);
+}
+
+void FileWatcher::stop() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(!running.exchange(false)) return;
+    }
+
+    wake.notify_all();
+    worker.join();
+
+    // A restart begins from what's on disk then
+    files.clear();
+    settling.clear();
+
+    std::lock_guard<std::mutex> guard(lock);
+    handed_over = 0;
+}
+
+void FileWatcher::poll(std::vector<std::string>& out) {
+    if(!has_changes.load(std::memory_order_acquire)) return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    out.insert(out.end(), changed.begin(), changed.end());
+    changed.clear();
+    has_changes.store(false, std::memory_order_relaxed);
+}
+
+void FileWatcher::run() {
+    open_native();
+
+    f64_t next_scan = now_ms() + PXL_FILE_WATCH_POLL_MS;
+
+    while(running.load(std::memory_order_relaxed)) {
+        add_files();
+        wait_for_events();
+
+        f64_t now = now_ms();
+        if(now >= next_scan) {
+            scan(now);
+            next_scan = now + PXL_FILE_WATCH_POLL_MS;
+        }
+
+        publish(now);
+    }
+
+    close_native();
+}
+
+void FileWatcher::add_files() {
+    std::vector<std::string> added;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        added.assign(paths.begin() + handed_over, paths.end());
+        handed_over = paths.size();
+    }
+
+    for(std::string& path : added) {
+        File file;
+        file.path = std::move(path);
+
+        size_t slash = file.path.find_last_of("/\\");
+        if(slash == std::string::npos) {
+            file.directory = ".";
+            file.name = file.path;
+        } else {
+            file.directory = slash ? file.path.substr(0, slash) : "/";
+            file.name = file.path.substr(slash + 1);
+        }
+
+        stat_file(file.path, file.write_time, file.size);
+
+#ifdef __linux__
+        // The directory, editors replace files by renaming over them and a watch
+        // on the file itself would stay on the old inode. The same directory twice
+        // gives the same watch
+        if(inotify >= 0) {
+            file.watch = inotify_add_watch(inotify, file.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if(file.watch < 0) WRN("Couldn't watch %s, polling it instead", file.directory.c_str());
+        }
+#endif
+
+        files.push_back(std::move(file));
+    }
+}
+
+void FileWatcher::wait_for_events() {
+#ifdef __linux__
+    if(inotify >= 0) {
+        pollfd descriptor = { inotify, POLLIN, 0 };
+        if(::poll(&descriptor, 1, PXL_FILE_WATCH_SETTLE_MS) <= 0) return;
+
+        f64_t now = now_ms();
+
+        alignas(inotify_event) char buffer[16 * 1024];
+        ssize_t length;
+
+        while((length = read(inotify, buffer, sizeof(buffer))) > 0) {
+            for(char* at = buffer; at < buffer + length;) {
+                const inotify_event* event = (const inotify_event*)at;
+                at += sizeof(inotify_event) + event->len;
+
+                // Lost events, anything could have changed
+                if(event->mask & IN_Q_OVERFLOW) {
+                    WRN("File watch queue overflowed, reloading everything");
+                    for(const File& file : files) touch(file.path, now);
+                    continue;
+                }
+
+                // Directory gone, its files are polled from now on
+                if(event->mask & IN_IGNORED) {
+                    for(File& file : files) {
+                        if(file.watch != event->wd) continue;
+                        file.watch = -1;
+                        stat_file(file.path, file.write_time, file.size);
+                    }
+                    continue;
+                }
+
+                if(!event->len) continue;
+
+                for(const File& file : files)
+                    if(file.watch == event->wd && file.name == event->name) touch(file.path, now);
+            }
+        }
+        return;
+    }
+#endif
+
+    std::unique_lock<std::mutex> guard(lock);
+    wake.wait_for(guard, std::chrono::milliseconds(PXL_FILE_WATCH_SETTLE_MS), [this] {
+        return !running.load(std::memory_order_relaxed);
+    });
+}
+
+void FileWatcher::scan(f64_t now) {
+    for(File& file : files) {
+        if(file.watch >= 0) continue;
+
+        s64_t write_time;
+        u64_t size;
+        stat_file(file.path, write_time, size);
+
+        if(write_time == file.write_time && size == file.size) continue;
+
+        file.write_time = write_time;
+        file.size = size;
+        touch(file.path, now);
+    }
+}
+
+void FileWatcher::touch(const std::string& path, f64_t now) {
+    for(auto& pair : settling) {
+        if(pair.first != path) continue;
+        pair.second = now;
+        return;
+    }
+
+    settling.emplace_back(path, now);
+}
+
+void FileWatcher::publish(f64_t now) {
+    std::vector<std::string> settled;
+
+    for(size_t i = 0; i < settling.size();) {
+        if(now - settling[i].second < PXL_FILE_WATCH_SETTLE_MS) {
+            i++;
+            continue;
+        }
+
+        settled.push_back(std::move(settling[i].first));
+        settling[i] = std::move(settling.back());
+        settling.pop_back();
+    }
+
+    if(settled.empty()) return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    for(std::string& path : settled)
+        if(std::find(changed.begin(), changed.end(), path) == changed.end())
+            changed.push_back(std::move(path));
+
+    has_changes.store(true, std::memory_order_release);
+}
+
+void FileWatcher::open_native() {
+#ifdef __linux__
+    inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(inotify < 0) WRN("inotify isn't available, polling watched files instead");
+#endif
+}
+
+void FileWatcher::close_native() {
+#ifdef __linux__
+    if(inotify >= 0) close(inotify);
+    inotify = -1;
+#endif
+}
@@ -0,0 +1,122 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_FILE_WATCHER_H
+#define PXL_FILE_WATCHER_H
+
+#include "misc/utility/types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// Files without a native watch get stat()ed this often
+#ifndef PXL_FILE_WATCH_POLL_MS
+#define PXL_FILE_WATCH_POLL_MS 250
+#endif
+
+// A file has to be quiet this long before it's reported. Editors and cook tools
+// write in bursts (truncate, write, close, rename), one change comes out of them
+#ifndef PXL_FILE_WATCH_SETTLE_MS
+#define PXL_FILE_WATCH_SETTLE_MS 50
+#endif
+
+// Watches single files for changes on its own thread. On Linux the directories
+// holding them get an inotify watch, files that can't have one (and everything
+// on other platforms) fall back to comparing their write time / size every
+// PXL_FILE_WATCH_POLL_MS.
+//
+// Paths come back out of poll() spelled exactly the way they went into watch(),
+// so whoever loaded a file by that path can look it up again :)*
+class FileWatcher {
+
+private:
+    struct File {
+        std::string path;
+        std::string directory;
+        std::string name;
+        s32_t watch = -1;                   // inotify watch of the directory, -1 = polled
+        s64_t write_time = 0;
+        u64_t size = 0;
+    };
+
+    // Worker only
+    std::vector<File> files;
+    std::vector<std::pair<std::string, f64_t>> settling;    // path, ms of the last event
+    s32_t inotify = -1;
+
+    std::thread worker;
+    std::atomic<bool> running { false };
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::unordered_set<std::string> known;  // guarded by lock, like everything below
+    std::vector<std::string> paths;         // every watch() so far
+    size_t handed_over = 0;                 // how many of them the worker has
+    std::vector<std::string> changed;       // settled, waiting for poll()
+    std::atomic<bool> has_changes { false };
+
+public:
+    FileWatcher() = default;
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Paths can be added before start(), the same path twice is ignored
+    void watch(const char* path);
+
+    // Starts / stops the worker. Changes while it's stopped aren't reported
+    void start();
+    void stop();
+    bool is_running() const { return running.load(std::memory_order_relaxed); }
+
+    // Appends every path that changed since the last call, once each. Cheap when
+    // nothing did, fine to call every frame
+    void poll(std::vector<std::string>& out);
+
+private:
+
+    void run();
+    void add_files();
+    void wait_for_events();
+    void scan(f64_t now);
+    void touch(const std::string& path, f64_t now);
+    void publish(f64_t now);
+
+    void open_native();
+    void close_native();
+
+};
+
+#endif
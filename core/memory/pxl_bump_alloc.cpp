@@ -28,6 +28,8 @@
 
 #include "pxl_memory.h"
 
+#include "core/debug/pxl_metrics.h"
+
 struct Arena {
     u8_t*     memory;
     size_t  offset;
@@ -42,6 +44,29 @@ static thread_local u32_t t_thread_id = [] {
     return counter++;
 }();
 
+static const char* TAG_METRIC_NAMES[(size_t)MemoryTag::COUNT] = {
+    "memory.arena.unknown_bytes",
+    "memory.arena.temp_bytes",
+    "memory.arena.ecs_bytes",
+    "memory.arena.renderer_bytes",
+    "memory.arena.physics_bytes",
+    "memory.arena.audio_bytes",
+    "memory.arena.ui_bytes"
+};
+
+static pxl::metrics::MetricId __pxl_tag_metric(MemoryTag tag) {
+    static const struct TagMetrics {
+        pxl::metrics::MetricId ids[(size_t)MemoryTag::COUNT];
+
+        TagMetrics() {
+            for(size_t i = 0; i < (size_t)MemoryTag::COUNT; i++)
+                ids[i] = pxl::metrics::register_metric(TAG_METRIC_NAMES[i], pxl::metrics::MetricType::COUNTER);
+        }
+    } tag_metrics;
+
+    return tag < MemoryTag::COUNT ? tag_metrics.ids[(size_t)tag] : pxl::metrics::MetricId();
+}
+
 static void __pxl_arena_init() {
     if(!t_arena.memory) {
         t_arena.memory = (u8_t*)os_alloc(ARENA_SIZE);
@@ -89,6 +114,8 @@ void __pxl_arena_reset() {
 }
 
 void* __pxl_arena_alloc(size_t size, MemoryTag tag) {
+    pxl::metrics::add(__pxl_tag_metric(tag), (s64_t)size);
+
     void* ptr = __pxl_internal_arena_alloc(size, tag);
     if(ptr) return ptr;
 
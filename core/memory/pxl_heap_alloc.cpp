@@ -32,10 +32,6 @@
 #define PXL_MIN_SPLIT 32
 #endif 
 
-#ifndef PXL_ENABLE_STATS
-#define PXL_ENABLE_STATS 1
-#endif
-
 struct Block {
     size_t  size;
     bool    free;
@@ -320,11 +316,12 @@ void __pxl_free(void* ptr) {
     Block* block = ((Block*)ptr) - 1;
     assert(!block->free && "double free");
 
+    lock_heap();
+
 #if PXL_ENABLE_STATS
     global_bytes_allocated -= block->size;
 #endif
 
-    lock_heap();
     block->free = true;
     block = coalesce(block);
 
@@ -50,6 +50,10 @@ inline static void os_free(void* ptr, size_t size) {
 #endif
 }
 
+#ifndef PXL_ENABLE_STATS
+#define PXL_ENABLE_STATS 1
+#endif
+
 #define PXL_ENABLE_DEBUG    0x001
 #define PXL_ENABLE_NUMA     0x001
 #define PXL_MAX_THREADS     0x0040
@@ -100,6 +104,12 @@ void    __pxl_free(void* ptr);
 void*   __pxl_arena_alloc(size_t size, MemoryTag tag);
 void    __pxl_arena_reset();
 
+#if PXL_ENABLE_STATS
+size_t  pxl_allocated_bytes();
+size_t  pxl_peak_bytes();
+size_t  pxl_alloc_count();
+#endif
+
 #define pmalloc(size)               __pxl_malloc(size)
 #define prealloc(ptr, new_size)     __pxl_realloc(ptr, new_size)
 #define pcalloc(num, size)          __pxl_calloc(num, size)
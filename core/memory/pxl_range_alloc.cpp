@@ -0,0 +1,129 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_range_alloc.h"
+
+RangeAllocator::RangeAllocator(u64_t capacity) {
+    reset(capacity);
+}
+
+void RangeAllocator::reset(u64_t capacity) {
+    free_by_offset.clear();
+    free_by_size.clear();
+
+    this->capacity = capacity;
+    used = 0;
+
+    if(capacity) insert_free(0, capacity);
+}
+
+u64_t RangeAllocator::allocate(u64_t size, u64_t alignment) {
+    if(size == 0) return INVALID;
+
+    // Smallest range that still fits once aligned, alignment padding is given back
+    for(auto it = free_by_size.lower_bound(size); it != free_by_size.end(); ++it) {
+        u64_t range_offset = it->second;
+        u64_t range_size = it->first;
+
+        u64_t offset = (range_offset + alignment - 1) / alignment * alignment;
+        u64_t padding = offset - range_offset;
+
+        if(padding + size > range_size) continue;
+
+        erase_free(free_by_offset.find(range_offset));
+
+        if(padding)
+            insert_free(range_offset, padding);
+
+        u64_t tail = range_size - padding - size;
+        if(tail)
+            insert_free(offset + size, tail);
+
+        used += size;
+        return offset;
+    }
+
+    return INVALID;
+}
+
+void RangeAllocator::free(u64_t offset, u64_t size) {
+    if(offset == INVALID || size == 0) return;
+
+    used -= size;
+
+    // Merge with the free neighbours on both sides
+    auto next = free_by_offset.lower_bound(offset);
+
+    if(next != free_by_offset.begin()) {
+        auto previous = std::prev(next);
+        if(previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            erase_free(previous);
+        }
+    }
+
+    if(next != free_by_offset.end() && offset + size == next->first) {
+        size += next->second;
+        erase_free(next);
+    }
+
+    insert_free(offset, size);
+}
+
+void RangeAllocator::grow(u64_t new_capacity) {
+    if(new_capacity <= capacity) return;
+
+    u64_t old_capacity = capacity;
+    capacity = new_capacity;
+
+    // free() merges with a trailing free range, used gets its size back right away
+    used += new_capacity - old_capacity;
+    free(old_capacity, new_capacity - old_capacity);
+}
+
+u64_t RangeAllocator::get_largest_free() const {
+    return free_by_size.empty() ? 0 : free_by_size.rbegin()->first;
+}
+
+void RangeAllocator::insert_free(u64_t offset, u64_t size) {
+    free_by_offset.emplace(offset, size);
+    free_by_size.emplace(size, offset);
+}
+
+void RangeAllocator::erase_free(std::map<u64_t, u64_t>::iterator it) {
+    auto range = free_by_size.equal_range(it->second);
+    for(auto size_it = range.first; size_it != range.second; ++size_it) {
+        if(size_it->second == it->first) {
+            free_by_size.erase(size_it);
+            break;
+        }
+    }
+
+    free_by_offset.erase(it);
+}
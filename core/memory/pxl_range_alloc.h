@@ -0,0 +1,76 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_RANGE_ALLOC_H
+#define PXL_RANGE_ALLOC_H
+
+#include "misc/utility/types.h"
+
+#include <map>
+
+// Hands out [offset, offset + size) ranges of something that isn't CPU memory,
+// like a GPU buffer. Free ranges live in two maps (by offset to merge neighbours on
+// free, by size for best fit) so both directions are O(log n) :)*
+class RangeAllocator {
+
+public:
+    static constexpr u64_t INVALID = ~0ull;
+
+private:
+    u64_t capacity = 0;
+    u64_t used = 0;
+
+    std::map<u64_t, u64_t> free_by_offset;              // offset -> size
+    std::multimap<u64_t, u64_t> free_by_size;           // size -> offset
+
+public:
+    RangeAllocator() = default;
+    explicit RangeAllocator(u64_t capacity);
+
+    void reset(u64_t capacity);
+
+    // Best fit, INVALID when nothing is large enough (grow() and try again)
+    u64_t allocate(u64_t size, u64_t alignment = 1);
+    void free(u64_t offset, u64_t size);
+
+    // Appends [capacity, new_capacity) as free space
+    void grow(u64_t new_capacity);
+
+    u64_t get_capacity() const { return capacity; }
+    u64_t get_used() const { return used; }
+    u64_t get_free_ranges() const { return free_by_offset.size(); }
+    u64_t get_largest_free() const;
+
+private:
+
+    void insert_free(u64_t offset, u64_t size);
+    void erase_free(std::map<u64_t, u64_t>::iterator it);
+
+};
+
+#endif
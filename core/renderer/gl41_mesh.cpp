@@ -34,36 +34,72 @@
 
 GL41Mesh::GL41Mesh() {}
 
-void GL41Mesh::create(struct Mesh& mesh) {
+void GL41Mesh::create(GL41StateCache& state, struct Mesh& mesh, bool upload) {
 
-    if(mesh.verticies.empty()) {
+    if(mesh.get_vertex_count() == 0) {
         WRN("Vertices are empty: %lld", 
-            mesh.verticies.size());
+            (s64_t)mesh.get_vertex_count());
         return;
     }
 
+    const VertexLayout& layout = mesh.get_layout();
+
     glGenVertexArrays(1,&mesh.vao);
-    glBindVertexArray(mesh.vao);
+    state.bind_vao(mesh.vao);
 
     glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, mesh.verticies.size() * sizeof(Vertex), mesh.verticies.data(), GL_STATIC_DRAW);
+    state.bind_buffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, mesh.get_vertex_count() * layout.stride,
+        upload ? mesh.get_vertex_data() : nullptr, GL_STATIC_DRAW);
 
     glGenBuffers(1, &mesh.ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(u32_t), mesh.indices.data(), GL_STATIC_DRAW);
+    state.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    std::vector<u16_t> scratch;
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * mesh.get_index_size(),
+        upload ? get_index_data(mesh, scratch) : nullptr, GL_STATIC_DRAW);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-    glEnableVertexAttribArray(0);
+    setup_vertex_attributes(layout);
 
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) (3 * sizeof(f32_t)));
-    glEnableVertexAttribArray(1);
+    mesh.size = mesh.indices.size();
+    mesh.gpu_vertex_count = (u32_t)mesh.get_vertex_count();
+}
 
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) (6 * sizeof(f32_t)));
-    glEnableVertexAttribArray(2);
+const void* GL41Mesh::get_index_data(const struct Mesh& mesh, std::vector<u16_t>& scratch) {
+    if(mesh.index_type == IndexType::U32) return mesh.indices.data();
 
-    mesh.size = mesh.indices.size();
+    scratch.resize(mesh.indices.size());
+    for(size_t i = 0; i < mesh.indices.size(); i++) scratch[i] = (u16_t)mesh.indices[i];
+    return scratch.data();
 }
 
+struct GL41VertexFormat {
+    s32_t components;
+    GLenum type;
+    GLboolean normalized;
+};
+
+static GL41VertexFormat gl41_vertex_format(VertexFormat format) {
+    switch(format) {
+        case VertexFormat::FLOAT2:      return { 2, GL_FLOAT, GL_FALSE };
+        case VertexFormat::FLOAT3:      return { 3, GL_FLOAT, GL_FALSE };
+        case VertexFormat::FLOAT4:      return { 4, GL_FLOAT, GL_FALSE };
+        case VertexFormat::HALF2:       return { 2, GL_HALF_FLOAT, GL_FALSE };
+        case VertexFormat::HALF4:       return { 4, GL_HALF_FLOAT, GL_FALSE };
+        case VertexFormat::UNORM8X4:    return { 4, GL_UNSIGNED_BYTE, GL_TRUE };
+        case VertexFormat::SNORM16X2:   return { 2, GL_SHORT, GL_TRUE };
+        case VertexFormat::UNORM16X2:   return { 2, GL_UNSIGNED_SHORT, GL_TRUE };
+    }
+    return { 4, GL_FLOAT, GL_FALSE };
+}
 
+// Attribute setup for the VAO and GL_ARRAY_BUFFER currently bound, straight from the layout
+void GL41Mesh::setup_vertex_attributes(const VertexLayout& layout) {
+    for(u8_t i = 0; i < layout.count; i++) {
+        const VertexAttribute& attribute = layout.attributes[i];
+        GL41VertexFormat format = gl41_vertex_format(attribute.format);
 
+        glVertexAttribPointer(attribute.location, format.components, format.type, format.normalized,
+            layout.stride, (void*)(size_t)attribute.offset);
+        glEnableVertexAttribArray(attribute.location);
+    }
+}
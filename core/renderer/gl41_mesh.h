@@ -30,13 +30,20 @@
 #define GL41_MESH_LOADER_H
 
 #include "pxL_renderer_backend.h"
+#include "gl41_state_cache.h"
 
 class GL41Mesh {
 
 public:
     GL41Mesh();
 
-    static void create(struct Mesh& mesh);
+    // With `upload` off the buffers are only allocated, the GL41UploadQueue fills them.
+    // Leaves the new VAO bound, through the state cache
+    static void create(GL41StateCache& state, struct Mesh& mesh, bool upload = true);
+    static void setup_vertex_attributes(const VertexLayout& layout);
+
+    // The mesh's indices in its index_type, narrowed into `scratch` for u16
+    static const void* get_index_data(const struct Mesh& mesh, std::vector<u16_t>& scratch);
 
 };
 
@@ -0,0 +1,208 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "gl41_mesh_pool.h"
+#include "gl41_mesh.h"
+
+#include "misc/utility/log.h"
+
+GL41MeshPool::GL41MeshPool(GL41StateCache& state, const VertexLayout& layout, IndexType index_type) :
+    state(state),
+    layout(layout),
+    index_type(index_type),
+    index_size(index_type == IndexType::U16 ? 2 : 4) {
+
+}
+
+GL41MeshPool::~GL41MeshPool() {
+    cleanup();
+}
+
+void GL41MeshPool::init(u64_t vertex_capacity, u64_t index_capacity) {
+    vertex_ranges.reset(vertex_capacity);
+    index_ranges.reset(index_capacity);
+
+    glGenVertexArrays(1, &vao);
+
+    glGenBuffers(1, &vbo);
+    state.bind_buffer(GL_COPY_WRITE_BUFFER, vbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, vertex_capacity * layout.stride, nullptr, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &ebo);
+    state.bind_buffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, index_capacity * index_size, nullptr, GL_STATIC_DRAW);
+
+    bind_buffers();
+}
+
+void GL41MeshPool::cleanup() {
+    if(!vao) return;
+
+    state.forget_vao(vao);
+    state.forget_buffer(vbo);
+    state.forget_buffer(ebo);
+    state.forget_buffer(indirect_buffer);
+
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    glDeleteBuffers(1, &ebo);
+
+    if(indirect_buffer)
+        glDeleteBuffers(1, &indirect_buffer);
+
+    vao = vbo = ebo = indirect_buffer = 0;
+    indirect_capacity = indirect_offset = 0;
+
+    vertex_ranges.reset(0);
+    index_ranges.reset(0);
+}
+
+// (Re)points the VAO at the current buffers, after init and after growing
+void GL41MeshPool::bind_buffers() {
+    state.bind_vao(vao);
+    state.bind_buffer(GL_ARRAY_BUFFER, vbo);
+    state.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    GL41Mesh::setup_vertex_attributes(layout);
+
+    // So a later ELEMENT_ARRAY_BUFFER bind can't land in the pool's VAO
+    state.bind_vao(0);
+}
+
+void GL41MeshPool::grow(u32_t& buffer, RangeAllocator& ranges, size_t element_size, u64_t needed) {
+    u64_t old_capacity = ranges.get_capacity();
+    u64_t new_capacity = old_capacity ? old_capacity : 1;
+    while(new_capacity - old_capacity < needed)
+        new_capacity *= 2;
+
+    u32_t new_buffer = 0;
+    glGenBuffers(1, &new_buffer);
+
+    state.bind_buffer(GL_COPY_READ_BUFFER, buffer);
+    state.bind_buffer(GL_COPY_WRITE_BUFFER, new_buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, new_capacity * element_size, nullptr, GL_STATIC_DRAW);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, old_capacity * element_size);
+
+    state.forget_buffer(buffer);
+    glDeleteBuffers(1, &buffer);
+    buffer = new_buffer;
+
+    ranges.grow(new_capacity);
+
+    LOG("Mesh pool grown to %llu KB", (u64_t)(new_capacity * element_size / 1024));
+
+    bind_buffers();
+}
+
+bool GL41MeshPool::add(struct Mesh& mesh, bool upload) {
+    if(mesh.get_vertex_count() == 0 || mesh.indices.empty()) {
+        WRN("Vertices or indices are empty: %llu, %llu",
+            (u64_t)mesh.get_vertex_count(), (u64_t)mesh.indices.size());
+        return false;
+    }
+
+    if(mesh.get_layout() != layout || mesh.index_type != index_type) {
+        ERR("Mesh vertex layout or index type doesn't match the pool");
+        return false;
+    }
+
+    if(!vao) init();
+
+    u64_t vertex_count = mesh.get_vertex_count();
+    u64_t index_count = mesh.indices.size();
+
+    u64_t base_vertex = vertex_ranges.allocate(vertex_count);
+    if(base_vertex == RangeAllocator::INVALID) {
+        grow(vbo, vertex_ranges, layout.stride, vertex_count);
+        base_vertex = vertex_ranges.allocate(vertex_count);
+    }
+
+    u64_t first_index = index_ranges.allocate(index_count);
+    if(first_index == RangeAllocator::INVALID) {
+        grow(ebo, index_ranges, index_size, index_count);
+        first_index = index_ranges.allocate(index_count);
+    }
+
+    if(upload) {
+        // Copy targets so no VAO state gets touched
+        state.bind_buffer(GL_COPY_WRITE_BUFFER, vbo);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, base_vertex * layout.stride,
+            vertex_count * layout.stride, mesh.get_vertex_data());
+
+        state.bind_buffer(GL_COPY_WRITE_BUFFER, ebo);
+        std::vector<u16_t> scratch;
+        glBufferSubData(GL_COPY_WRITE_BUFFER, first_index * index_size,
+            index_count * index_size, GL41Mesh::get_index_data(mesh, scratch));
+    }
+
+    mesh.vao = vao;
+    mesh.vbo = 0;
+    mesh.ebo = 0;
+    mesh.pooled = true;
+    mesh.base_vertex = (u32_t)base_vertex;
+    mesh.first_index = (u32_t)first_index;
+    mesh.size = index_count;
+    mesh.gpu_vertex_count = (u32_t)vertex_count;
+
+    return true;
+}
+
+void GL41MeshPool::release(struct Mesh& mesh) {
+    if(!mesh.pooled) return;
+
+    vertex_ranges.free(mesh.base_vertex, mesh.gpu_vertex_count);
+    index_ranges.free(mesh.first_index, mesh.size);
+
+    mesh.pooled = false;
+    mesh.vao = 0;
+}
+
+void GL41MeshPool::draw_indirect(const GL41DrawIndirect* commands, u32_t count) {
+    size_t bytes = count * sizeof(GL41DrawIndirect);
+
+    if(!indirect_buffer)
+        glGenBuffers(1, &indirect_buffer);
+
+    state.bind_buffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer);
+
+    // Orphan instead of waiting on draws that still read the old contents
+    if(indirect_offset + bytes > indirect_capacity) {
+        while(indirect_capacity < bytes)
+            indirect_capacity = indirect_capacity ? indirect_capacity * 2 : 64 * 1024;
+
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, indirect_capacity, nullptr, GL_STREAM_DRAW);
+        indirect_offset = 0;
+    }
+
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, indirect_offset, bytes, commands);
+    glMultiDrawElementsIndirect(GL_TRIANGLES,
+        index_type == IndexType::U16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+        (void*)indirect_offset, count, 0);
+
+    indirect_offset += bytes;
+}
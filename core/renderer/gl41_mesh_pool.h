@@ -0,0 +1,117 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef GL41_MESH_POOL_H
+#define GL41_MESH_POOL_H
+
+#include "pxl_renderer_backend.h"
+#include "gl41_state_cache.h"
+#include "core/memory/pxl_range_alloc.h"
+
+#include <glad/glad.h>
+
+#ifndef PXL_MESH_POOL_VERTICES
+#define PXL_MESH_POOL_VERTICES (1 << 20)
+#endif
+
+#ifndef PXL_MESH_POOL_INDICES
+#define PXL_MESH_POOL_INDICES (1 << 22)
+#endif
+
+// Same layout as glMultiDrawElementsIndirect expects
+struct GL41DrawIndirect {
+    u32_t count;
+    u32_t instance_count;
+    u32_t first_index;
+    s32_t base_vertex;
+    u32_t base_instance;
+};
+
+// Every mesh with one vertex layout and index type in one VBO + one EBO behind a
+// single VAO, the renderer keeps a pool per combination.
+// Ranges come from RangeAllocators (in vertices / indices, not bytes) and the
+// buffers double with glCopyBufferSubData when they run out. Uploads run between
+// frames and bind directly, only drawing goes through the state cache
+class GL41MeshPool {
+
+private:
+    GL41StateCache& state;
+    const VertexLayout layout;
+    const IndexType index_type;
+    const u32_t index_size;
+
+    u32_t vao = 0;
+    u32_t vbo = 0;
+    u32_t ebo = 0;
+
+    RangeAllocator vertex_ranges;
+    RangeAllocator index_ranges;
+
+    // Streamed indirect commands, orphaned when full
+    u32_t indirect_buffer = 0;
+    size_t indirect_capacity = 0;
+    size_t indirect_offset = 0;
+
+public:
+    GL41MeshPool(
+        GL41StateCache& state,
+        const VertexLayout& layout = VertexLayout::standard(),
+        IndexType index_type = IndexType::U32);
+    ~GL41MeshPool();
+
+    GL41MeshPool(const GL41MeshPool&) = delete;
+    GL41MeshPool& operator=(const GL41MeshPool&) = delete;
+
+    // Needs a current context, add() calls it on first use
+    void init(u64_t vertex_capacity = PXL_MESH_POOL_VERTICES, u64_t index_capacity = PXL_MESH_POOL_INDICES);
+    void cleanup();
+
+    // Uploads into the pool and fills vao / base_vertex / first_index / size. The
+    // mesh has to have the pool's layout and index type. With `upload` off only the
+    // ranges get allocated, the GL41UploadQueue fills them later
+    bool add(struct Mesh& mesh, bool upload = true);
+    void release(struct Mesh& mesh);
+
+    // One glMultiDrawElementsIndirect, needs GL 4.3 and the pool's VAO bound
+    void draw_indirect(const GL41DrawIndirect* commands, u32_t count);
+
+    u32_t get_vao() const { return vao; }
+    u32_t get_vbo() const { return vbo; }
+    u32_t get_ebo() const { return ebo; }
+    const VertexLayout& get_layout() const { return layout; }
+    u64_t get_vertex_bytes() const { return vertex_ranges.get_used() * layout.stride; }
+    u64_t get_index_bytes() const { return index_ranges.get_used() * index_size; }
+
+private:
+
+    void grow(u32_t& buffer, RangeAllocator& ranges, size_t element_size, u64_t needed);
+    void bind_buffers();
+
+};
+
+#endif
@@ -0,0 +1,327 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "gl41_program_cache.h"
+
+#include "core/io/pxl_mapped_file.h"
+#include "misc/utility/log.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+// KHR_parallel_shader_compile, same value as the ARB one. GLAD wasn't generated
+// with either
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+using program_clock = std::chrono::steady_clock;
+
+static f64_t elapsed_ms(program_clock::time_point start) {
+    return std::chrono::duration<f64_t, std::milli>(program_clock::now() - start).count();
+}
+
+// FNV-1a, a string's terminator goes in too so "ab" + "c" != "a" + "bc"
+static inline u64_t hash_string(u64_t hash, const char* text) {
+    const u8_t* bytes = (const u8_t*)(text ? text : "");
+    do {
+        hash ^= *bytes;
+        hash *= 0x100000001b3ull;
+    } while(*bytes++);
+    return hash;
+}
+
+// Only read by ERR, which compiles out without the logger
+[[maybe_unused]] static std::string info_log(u32_t object, bool program) {
+    GLint length = 0;
+    if(program) glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length);
+    else glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+
+    if(length <= 1) return "(no log)";
+
+    std::string log((size_t)length, '\0');
+    if(program) glGetProgramInfoLog(object, length, nullptr, &log[0]);
+    else glGetShaderInfoLog(object, length, nullptr, &log[0]);
+
+    log.resize(std::strlen(log.c_str()));
+    return log;
+}
+
+static u32_t compile_stage(const char* source, GLenum type) {
+    u32_t shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+// Only asked once the link failed, so the compile itself never waits on it
+static void log_stage(u32_t shader, const char* stage, const std::string& name) {
+    (void)stage; (void)name;    // logs only
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+
+    if(!compiled)
+        ERR("%s shader failed to compile (%s):\n%s", stage, name.c_str(), info_log(shader, false).c_str());
+}
+
+GL41ProgramCache::GL41ProgramCache(const char* directory) : directory(directory ? directory : "") {
+    if(this->directory.empty()) enabled = false;
+}
+
+void GL41ProgramCache::query() {
+    queried = true;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    supported = formats > 0;
+
+    u64_t hash = 0xcbf29ce484222325ull;
+    hash = hash_string(hash, (const char*)glGetString(GL_VENDOR));
+    hash = hash_string(hash, (const char*)glGetString(GL_RENDERER));
+    hash = hash_string(hash, (const char*)glGetString(GL_VERSION));
+    hash = hash_string(hash, (const char*)glGetString(GL_SHADING_LANGUAGE_VERSION));
+    driver_hash = hash;
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    for(GLint i = 0; i < count; i++) {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if(extension && (!std::strcmp(extension, "GL_KHR_parallel_shader_compile")
+            || !std::strcmp(extension, "GL_ARB_parallel_shader_compile")))
+            parallel = true;
+    }
+
+    if(!supported) WRN("No program binary formats, shaders compile on every start");
+}
+
+u64_t GL41ProgramCache::program_key(const char* vertex_source, const char* fragment_source) const {
+    u64_t hash = driver_hash;
+    hash ^= GL41_PROGRAM_CACHE_VERSION;
+    hash = hash_string(hash, vertex_source);
+    hash = hash_string(hash, fragment_source);
+    return hash;
+}
+
+std::string GL41ProgramCache::file_path(u64_t key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return directory + "/" + name;
+}
+
+u32_t GL41ProgramCache::build(const char* vertex_source, const char* fragment_source, const char* name) {
+    GL41PendingProgram pending;
+    if(!begin(vertex_source, fragment_source, name, pending)) return 0;
+    return finish(pending);
+}
+
+bool GL41ProgramCache::begin(const char* vertex_source, const char* fragment_source, const char* name, GL41PendingProgram& pending) {
+    if(!queried) query();
+
+    auto start = program_clock::now();
+
+    pending = GL41PendingProgram();
+    pending.name = name ? name : "";
+
+    if(is_active()) {
+        pending.key = program_key(vertex_source, fragment_source);
+        pending.program = load(pending.key, file_path(pending.key));
+
+        if(pending.program) {
+            pending.loaded = true;
+            stats.hits++;
+            stats.load_ms += elapsed_ms(start);
+            return true;
+        }
+
+        pending.store = true;
+    }
+
+    pending.vertex = compile_stage(vertex_source, GL_VERTEX_SHADER);
+    pending.fragment = compile_stage(fragment_source, GL_FRAGMENT_SHADER);
+
+    pending.program = glCreateProgram();
+    if(pending.store) glProgramParameteri(pending.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    // A stage that failed to compile fails the link, finish() sorts out which
+    glAttachShader(pending.program, pending.vertex);
+    glAttachShader(pending.program, pending.fragment);
+    glLinkProgram(pending.program);
+
+    stats.compile_ms += elapsed_ms(start);
+    return true;
+}
+
+bool GL41ProgramCache::is_ready(const GL41PendingProgram& pending) const {
+    if(pending.loaded || !parallel) return true;
+
+    GLint done = GL_FALSE;
+    glGetProgramiv(pending.program, GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
+
+u32_t GL41ProgramCache::finish(GL41PendingProgram& pending) {
+    if(pending.loaded) {
+        u32_t program = pending.program;
+        pending = GL41PendingProgram();
+        return program;
+    }
+
+    auto start = program_clock::now();
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(pending.program, GL_LINK_STATUS, &linked);
+
+    u32_t program = pending.program;
+
+    if(!linked) {
+        log_stage(pending.vertex, "Vertex", pending.name);
+        log_stage(pending.fragment, "Fragment", pending.name);
+        ERR("Program failed to link (%s):\n%s", pending.name.c_str(), info_log(program, true).c_str());
+    }
+
+    release_stages(pending);
+
+    if(!linked) {
+        glDeleteProgram(program);
+        program = 0;
+        stats.failures++;
+    }
+
+    if(program && pending.store) {
+        store(program, pending.key, file_path(pending.key));
+        stats.misses++;
+    }
+
+    stats.compile_ms += elapsed_ms(start);
+
+    pending = GL41PendingProgram();
+    return program;
+}
+
+void GL41ProgramCache::discard(GL41PendingProgram& pending) {
+    release_stages(pending);
+    if(pending.program) glDeleteProgram(pending.program);
+    pending = GL41PendingProgram();
+}
+
+void GL41ProgramCache::release_stages(GL41PendingProgram& pending) {
+    if(pending.vertex) {
+        if(pending.program) glDetachShader(pending.program, pending.vertex);
+        glDeleteShader(pending.vertex);
+        pending.vertex = 0;
+    }
+
+    if(pending.fragment) {
+        if(pending.program) glDetachShader(pending.program, pending.fragment);
+        glDeleteShader(pending.fragment);
+        pending.fragment = 0;
+    }
+}
+
+u32_t GL41ProgramCache::load(u64_t key, const std::string& path) {
+    MappedFile file;
+    if(!file.open(path.c_str())) return 0;
+
+    GL41ProgramBinaryHeader header;
+    if(file.size() < sizeof(header)) {
+        stats.rejected++;
+        return 0;
+    }
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if(header.magic != GL41_PROGRAM_CACHE_MAGIC || header.version != GL41_PROGRAM_CACHE_VERSION
+        || header.key != key || header.length != file.size() - sizeof(header)) {
+        stats.rejected++;
+        return 0;
+    }
+
+    u32_t program = glCreateProgram();
+    glProgramBinary(program, header.format, file.data() + sizeof(header), (GLsizei)header.length);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    if(!linked) {
+        WRN("Cached program refused by the driver, compiling: %s", path.c_str());
+        glDeleteProgram(program);
+        stats.rejected++;
+        return 0;
+    }
+
+    return program;
+}
+
+void GL41ProgramCache::store(u32_t program, u64_t key, const std::string& path) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0) return;
+
+    std::vector<u8_t> data(sizeof(GL41ProgramBinaryHeader) + (size_t)length);
+
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, data.data() + sizeof(GL41ProgramBinaryHeader));
+    if(written <= 0) return;
+
+    GL41ProgramBinaryHeader header = {};
+    header.magic = GL41_PROGRAM_CACHE_MAGIC;
+    header.version = GL41_PROGRAM_CACHE_VERSION;
+    header.key = key;
+    header.format = format;
+    header.length = (u32_t)written;
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    // Written aside and renamed over, a crash or a second instance never leaves a
+    // half written binary under the real name
+    const std::string temporary = path + ".tmp";
+
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if(!file) {
+        WRN("Couldn't write the program cache: %s", temporary.c_str());
+        return;
+    }
+
+    const size_t size = sizeof(header) + (size_t)written;
+    bool complete = fwrite(data.data(), 1, size, file) == size;
+    if(fclose(file) != 0) complete = false;
+
+    if(complete) std::filesystem::rename(temporary, path, error);
+
+    if(!complete || error) {
+        WRN("Couldn't write the program cache: %s", path.c_str());
+        std::filesystem::remove(temporary, error);
+    }
+}
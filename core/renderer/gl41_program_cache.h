@@ -0,0 +1,134 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef GL41_PROGRAM_CACHE_H
+#define GL41_PROGRAM_CACHE_H
+
+#include "misc/utility/types.h"
+#include "core/config.h"
+
+#include <glad/glad.h>
+
+#include <string>
+
+// On disk cache of linked programs. Files are named after a hash of both final
+// sources (defines included) and the driver (vendor, renderer, version strings),
+// so a driver update or an edited shader simply misses and compiles again. A
+// binary the driver refuses anyway (it may, any time) falls back to compiling
+// and gets overwritten.
+//
+// Drivers that expose no binary formats (GL_NUM_PROGRAM_BINARY_FORMATS = 0)
+// always compile, nothing gets written then.
+//
+// build() blocks. begin() / is_ready() / finish() split it for background
+// compiles: with KHR / ARB_parallel_shader_compile the driver links on its own
+// threads and is_ready() polls GL_COMPLETION_STATUS_KHR, without it is_ready()
+// is always true and finish() blocks until the link is done
+
+#define GL41_PROGRAM_CACHE_MAGIC    0x42505850  // "PXPB"
+#define GL41_PROGRAM_CACHE_VERSION  1
+
+struct GL41ProgramBinaryHeader {
+    u32_t magic;
+    u32_t version;
+    u64_t key;                  // checked against the name, renamed files miss
+    u32_t format;               // GLenum from glGetProgramBinary
+    u32_t length;               // bytes following the header
+};
+
+// A program between begin() and finish()
+struct GL41PendingProgram {
+    u32_t program = 0;
+    u32_t vertex = 0;
+    u32_t fragment = 0;
+    bool loaded = false;        // came from the cache, nothing to wait for
+    bool store = false;         // goes to the cache once it linked
+    u64_t key = 0;
+    std::string name;
+};
+
+struct GL41ProgramCacheStats {
+    u64_t hits = 0;
+    u64_t misses = 0;           // compiled and stored
+    u64_t rejected = 0;         // on disk but refused (driver, stale, truncated)
+    u64_t failures = 0;         // compile / link errors
+    f64_t load_ms = 0.0;        // glProgramBinary, hits only
+    f64_t compile_ms = 0.0;     // compile + link (+ store)
+};
+
+class GL41ProgramCache {
+
+private:
+    std::string directory;
+    bool enabled = true;
+
+    // Asked on the first build(), the context isn't there at construction
+    bool queried = false;
+    bool supported = false;
+    bool parallel = false;      // KHR / ARB_parallel_shader_compile
+    u64_t driver_hash = 0;
+
+    GL41ProgramCacheStats stats;
+
+public:
+    GL41ProgramCache(const char* directory = PXL_SHADER_CACHE_DIR);
+
+    // Links a program from the final sources, 0 on errors (logged with their info
+    // logs). `name` only shows up in those logs
+    u32_t build(const char* vertex_source, const char* fragment_source, const char* name = "");
+
+    // Loads from the cache or hands both stages and the link to the driver without
+    // waiting. False when there's nothing to wait for because it already failed
+    bool begin(const char* vertex_source, const char* fragment_source, const char* name, GL41PendingProgram& pending);
+    bool is_ready(const GL41PendingProgram& pending) const;
+    // The linked program, or 0 with the stage / link logs printed
+    u32_t finish(GL41PendingProgram& pending);
+    // Drops a pending program without looking at it (shutdown)
+    void discard(GL41PendingProgram& pending);
+
+    // Disabled still compiles, it just never reads or writes files
+    void set_enabled(bool enable) { enabled = enable; }
+    bool is_active() const { return enabled && supported; }
+    bool is_parallel() const { return parallel; }
+
+    const GL41ProgramCacheStats& get_stats() const { return stats; }
+
+private:
+
+    void query();
+    u64_t program_key(const char* vertex_source, const char* fragment_source) const;
+    std::string file_path(u64_t key) const;
+
+    u32_t load(u64_t key, const std::string& path);
+    void store(u32_t program, u64_t key, const std::string& path);
+    void release_stages(GL41PendingProgram& pending);
+
+};
+
+#endif
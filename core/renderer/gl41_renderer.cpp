@@ -27,14 +27,25 @@
 **********************************************************************************/
 
 #include "gl41_renderer.h"
+#include "pxl_culling.h"
 
+#include "core/debug/pxl_metrics.h"
+#include "core/debug/pxl_profiler.h"
 #include "misc/utility/generator.h"
 #include "misc/utility/log.h"
 
-#include <algorithm>
+#include <chrono>
 
-GL41Renderer::GL41Renderer() {
+GL41Renderer::GL41Renderer(MeshStorage mesh_storage, u64_t upload_budget) :
+    shader_compiler(program_cache),
+    uniform_ring(state_cache),
+    mesh_storage(mesh_storage),
+    upload_queue(state_cache),
+    upload_budget(upload_budget),
+    texture_backend(state_cache),
+    texture_manager(texture_backend) {
 
+    render_queue.set_texture_manager(&texture_manager);
 }
 
 GL41Renderer::~GL41Renderer() {
@@ -42,125 +53,433 @@ GL41Renderer::~GL41Renderer() {
 }
 
 u64_t GL41Renderer::add_mesh(struct Mesh& mesh) {
-    if(mesh.verticies.empty()) return -1;
+    if(mesh.get_vertex_count() == 0) return -1;
+
+    // Callers can bring their own (animated meshes, ...), quantize() fills them too
+    if(mesh.bounds.radius < 0.0f && !mesh.verticies.empty())
+        mesh.bounds = pxl::culling::compute_bounds(mesh.verticies);
+
+    // Most assets fit, halves their index memory and upload
+    mesh.index_type = mesh.fit_index_type();
+
+    // Streaming only allocates here, the data goes up over the next frames
+    bool stream = upload_budget > 0;
+    GL41MeshPool* pool = nullptr;
+
+    if(mesh_storage == MeshStorage::POOLED) {
+        pool = &get_pool(mesh.get_layout(), mesh.index_type);
+        if(!pool->add(mesh, !stream)) return -1;
+    } else {
+        GL41Mesh::create(state_cache, mesh, !stream);
+    }
+
+    if(mesh.index_type == IndexType::U16)
+        PXL_METRIC_ADD("assets.index_bytes_saved", (f64_t)(mesh.indices.size() * 2));
 
-    GL41Mesh::create(mesh);
     u64_t mesh_id = Generator::generate_id();
 
-    gl41_meshes.emplace(mesh_id, std::move(mesh));
+    auto it = gl41_meshes.emplace(mesh_id, std::move(mesh)).first;
+    Mesh& stored = it->second;
+
+    if(stream)
+        upload_queue.queue(stored, pool);
+    else if(!stored.keep_cpu_data)
+        stored.release_cpu_data();
+
+    render_queue.register_mesh(mesh_id, &stored);
 
     return mesh_id;
 }   
 
+void GL41Renderer::remove_mesh(u64_t mesh_id) {
+    auto it = gl41_meshes.find(mesh_id);
+    if(it == gl41_meshes.end()) return;
+
+    Mesh& mesh = it->second;
+
+    render_queue.unregister_mesh(mesh_id);
+    upload_queue.cancel(mesh);
+
+    // GL orders later writes into the freed range after the draws still reading it
+    if(mesh.pooled) {
+        get_pool(mesh.get_layout(), mesh.index_type).release(mesh);
+    } else {
+        state_cache.forget_vao(mesh.vao);
+        state_cache.forget_buffer(mesh.vbo);
+        state_cache.forget_buffer(mesh.ebo);
+        glDeleteVertexArrays(1, &mesh.vao);
+        glDeleteBuffers(1, &mesh.vbo);
+        glDeleteBuffers(1, &mesh.ebo);
+    }
+
+    if(bound_mesh == &mesh) bound_mesh = nullptr;
+    gl41_meshes.erase(it);
+}
+
+GL41MeshPool& GL41Renderer::get_pool(const VertexLayout& layout, IndexType index_type) {
+    auto& pool = mesh_pools[layout.hash() * 31 + (u64_t)index_type];
+    if(!pool) pool = std::make_unique<GL41MeshPool>(state_cache, layout, index_type);
+    return *pool;
+}
+
 u64_t GL41Renderer::add_shader(struct Shader& shader) {
     if(!shader.vertex || !shader.fragment) return -1;
 
-    GL41Shader gl41_shader(shader);
+    GL41Shader gl41_shader(shader, program_cache);
+    if(!gl41_shader.is_valid()) return -1;
 
     u64_t shader_id = Generator::generate_id();
 
     gl41_shaders.emplace(shader_id, std::move(gl41_shader));
+    render_queue.register_shader(shader_id);
+    shader_compiler.add_base(shader_id, shader);
+
+    file_watcher.watch(shader.vertex);
+    file_watcher.watch(shader.fragment);
 
     return shader_id;
 }
 
-void GL41Renderer::draw_mesh(const u64_t& mesh_id) {
-    auto it =  gl41_meshes.find(mesh_id);
-    if(it == gl41_meshes.end()) {
-        ERR("Mesh Not Found: %llu", mesh_id);
-        return;    
-    }   
+u64_t GL41Renderer::add_shader_variant(u64_t shader_id, const char* keywords, bool precompile) {
+    bool created = false;
+    u64_t variant_id = shader_compiler.add_variant(shader_id, keywords, precompile, created);
 
-    Mesh& mesh = it->second;
-
-    for (size_t i = 0; i < mesh.textures.size(); ++i) {
-        u32_t texture = mesh.textures[i];
+    if(!variant_id) {
+        ERR("Variants need a shader from add_shader(): %llu", shader_id);
+        return -1;
+    }
 
-        if (i < bound_textures.size() && bound_textures[i] == texture)
-            continue;
+    if(created) render_queue.register_shader(variant_id);
+    return variant_id;
+}
 
-        glActiveTexture(GL_TEXTURE0 + i);
-        glBindTexture(GL_TEXTURE_2D, texture);
+u64_t GL41Renderer::add_material(const struct Material& material) {
+    u64_t existing = render_queue.find_material(material);
+    if(existing) return existing;
 
-        if (i < bound_textures.size())
-            bound_textures[i] = texture;
-        else
-            bound_textures.push_back(texture);
+    if(material.render_state >= pxl::render_state::count()) {
+        ERR("Material render state not found: %u", material.render_state);
+        return -1;
     }
 
-    if(bound_vao != mesh.vao) {
-        glBindVertexArray(mesh.vao);
-        bound_vao = mesh.vao;
-    }
+    u64_t material_id = Generator::generate_id();
+    if(!render_queue.register_material(material_id, material)) return -1;
 
-    glDrawElements(GL_TRIANGLES, mesh.size, GL_UNSIGNED_INT, 0);
+    return material_id;
 }
 
 void GL41Renderer::use_shader(const u64_t& shader_id) {
     auto it = gl41_shaders.find(shader_id);
-    if(it != gl41_shaders.end()) {
-        if(current_shader != shader_id) {
-            current_shader = shader_id;
-            it->second.use();
+
+    // Variants draw with their base shader until they're linked
+    if(it == gl41_shaders.end()) {
+        u64_t fallback = shader_compiler.fallback(shader_id);
+        if(fallback) {
+            it = gl41_shaders.find(fallback);
+            frame_stats.shader_fallbacks++;
         }
+    }
+
+    if(it != gl41_shaders.end()) {
+        current_shader = &it->second;
+        state_cache.use_program(current_shader->get_program());
     } else {
+        current_shader = nullptr;
         ERR("Shader not found: %llu", shader_id);
         return;
     }
 }
 
+void GL41Renderer::set_camera(const struct Camera& camera) {
+    render_queue.set_camera(camera);
+}
+
+u32_t GL41Renderer::load_texture(const char* path, const SamplerDesc& sampler) {
+    u32_t texture = texture_manager.load(path, sampler);
+    if(texture) file_watcher.watch(path);
+
+    return texture;
+}
+
+void GL41Renderer::set_hot_reload(bool enabled) {
+    if(enabled) file_watcher.start();
+    else file_watcher.stop();
+}
+
+void GL41Renderer::reload(const char* path) {
+    u32_t shaders = shader_compiler.reload(path);
+    u32_t textures = texture_manager.reload(path);
+
+    if(shaders || textures) LOG("Reloading %s (%u shaders, %u textures)", path, shaders, textures);
+}
+
 void GL41Renderer::submit_draw_call(const struct DrawCall& draw_call) {
-    draw_queue.push_back(draw_call);
+    render_queue.submit(draw_call);
 }
 
 void GL41Renderer::draw() {
-    if(draw_queue.empty()) return;
+    frame_stats = {};
+    frame_stats.frames = 1;
+
+    // Before building, so meshes that turn resident here draw this frame. Textures
+    // work off last frame's usage, build() reports this one's
+    reload_changed();
+    compile_shaders();
+    stream_uploads();
+    stream_textures();
+
+    if(render_queue.empty()) return;
 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    render_queue.build(frame_log, frame_stats);
+    render_queue.clear();
 
-    bound_vao = 0;
-    bound_textures.clear();
-    current_shader = 0;
+    auto execute_start = std::chrono::steady_clock::now();
 
-    std::sort(draw_queue.begin(), draw_queue.end(),
-        [](const DrawCall& a, const DrawCall& b) {
-            if(a.shader_id == b.shader_id)
-                return a.mesh_id < b.mesh_id;
-            return a.shader_id < b.shader_id;
+    submit(frame_log);
+
+    frame_stats.execute_ms = std::chrono::duration<f64_t, std::milli>(
+        std::chrono::steady_clock::now() - execute_start).count();
+}
+
+void GL41Renderer::reload_changed() {
+    changed_files.clear();
+    file_watcher.poll(changed_files);
+
+    for(const std::string& path : changed_files) reload(path.c_str());
+}
+
+void GL41Renderer::compile_shaders() {
+    compiled_variants.clear();
+    shader_compiler.update(compiled_variants);
+
+    for(const auto& compiled : compiled_variants) {
+        auto it = gl41_shaders.find(compiled.first);
+        if(it == gl41_shaders.end()) {
+            gl41_shaders.emplace(compiled.first, GL41Shader(compiled.second));
+            continue;
         }
-    );
-
-    for(const auto& call : draw_queue) {
-        use_shader(call.shader_id);
-
-        auto it_shader = gl41_shaders.find(call.shader_id);
-        if(it_shader != gl41_shaders.end()) {
-            // it_shader->second.set_mat4("fuck ass shit transform :D*", call.transform); <--- do this if you're stupid :D*
-            
-            // Much better :D* 
-            for(const auto& pair : call.mat4_uniform) {
-                it_shader->second.set_mat4(pair.first.c_str(), pair.second); 
+
+        // Reloaded, the id keeps its slot and gets the new program (and a fresh
+        // reflection / uniform cache). GL keeps the old one alive while it's current
+        state_cache.forget_program(it->second.get_program());
+        glDeleteProgram(it->second.get_program());
+        it->second = GL41Shader(compiled.second);
+    }
+
+    frame_stats.shaders_compiling = shader_compiler.get_pending();
+}
+
+void GL41Renderer::stream_uploads() {
+    if(upload_queue.empty()) return;
+
+    GL41UploadStats upload_stats = upload_queue.update(upload_budget);
+
+    frame_stats.upload_bytes = upload_stats.bytes;
+    frame_stats.uploads_completed = upload_stats.completed;
+    frame_stats.uploads_pending = upload_stats.pending;
+}
+
+void GL41Renderer::stream_textures() {
+    TextureStats texture_stats = texture_manager.update();
+
+    frame_stats.texture_bytes = texture_stats.resident_bytes;
+    frame_stats.texture_upload_bytes = texture_stats.upload_bytes;
+    frame_stats.texture_evicted_bytes = texture_stats.evicted_bytes;
+    frame_stats.textures_streaming = texture_stats.streaming;
+}
+
+void GL41Renderer::replay(const RenderCommandLog& log) {
+    reload_changed();
+    compile_shaders();
+    stream_textures();
+    submit(log);
+}
+
+// Constants first (one write into the ring), then the commands
+void GL41Renderer::submit(const RenderCommandLog& log) {
+    // Window callbacks, ImGui and uploads may have touched GL since the last frame
+    state_cache.reset();
+    state_cache.reset_stats();
+
+    frame_stats.uniform_bytes += uniform_ring.upload(log);
+    uniform_ring.bind_frame();
+
+    execute(log);
+
+    uniform_ring.end_frame();
+
+    frame_stats.gl_state_calls += state_cache.get_stats().issued;
+    frame_stats.gl_state_calls_avoided += state_cache.get_stats().avoided;
+}
+
+void GL41Renderer::execute(const RenderCommandLog& log) {
+    PXL_PROFILE_SCOPE("GL41Renderer::execute");
+
+    current_shader = nullptr;
+    bound_mesh = nullptr;
+    bound_pool = nullptr;
+    multi_draw = mesh_storage == MeshStorage::POOLED && GLAD_GL_VERSION_4_3;
+
+    u32_t first_object = 0;
+    u32_t object_count = 1;
+
+    for(const RenderCommand& command : log.commands) {
+        switch(command.type) {
+            case RenderCommandType::CLEAR:
+                flush_multi_draw();
+                state_cache.prepare_clear();
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                break;
+
+            case RenderCommandType::SET_STATE:
+                flush_multi_draw();
+                state_cache.apply(pxl::render_state::get_state((u32_t)command.id));
+                break;
+
+            case RenderCommandType::USE_SHADER:
+                flush_multi_draw();
+                use_shader(command.id);
+                break;
+
+            case RenderCommandType::BIND_MATERIAL:
+                // Bound no matter the shader, the binding point outlives program switches
+                flush_multi_draw();
+                uniform_ring.bind_material(command.payload);
+                break;
+
+            case RenderCommandType::SET_MAT4:
+                if(!current_shader) break;
+                flush_multi_draw();
+
+                if(current_shader->set_mat4((u32_t)command.id, log.matrices[command.payload]))
+                    frame_stats.uniforms_uploaded++;
+                else
+                    frame_stats.uniforms_skipped++;
+                break;
+
+            case RenderCommandType::BIND_OBJECT:
+                first_object = command.payload;
+                object_count = (u32_t)command.id;
+                break;
+
+            case RenderCommandType::BIND_TEXTURE:
+                flush_multi_draw();
+                state_cache.bind_texture(command.slot, GL_TEXTURE_2D, (u32_t)command.id);
+                state_cache.bind_sampler(command.slot, texture_manager.get_sampler((u32_t)command.id));
+                break;
+
+            case RenderCommandType::BIND_MESH: {
+                auto it = gl41_meshes.find(command.id);
+                if(it == gl41_meshes.end()) {
+                    ERR("Mesh Not Found: %llu", command.id);
+                    bound_mesh = nullptr;
+                    break;
+                }
+
+                bound_mesh = &it->second;
+
+                // Pooled meshes of a layout share a VAO, switching between them is free
+                if(bound_mesh->vao != state_cache.get_vao()) {
+                    flush_multi_draw();
+                    state_cache.bind_vao(bound_mesh->vao);
+                    bound_pool = bound_mesh->pooled ? &get_pool(bound_mesh->get_layout(), bound_mesh->index_type) : nullptr;
+                }
+                break;
             }
+
+            case RenderCommandType::DRAW_MESH:
+            case RenderCommandType::DRAW_INSTANCED:
+                draw_mesh(command.slot, command.payload, first_object, object_count);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    flush_multi_draw();
+}
+
+void GL41Renderer::draw_mesh(u8_t lod, u32_t index_count, u32_t first_object, u32_t instances) {
+    if(!current_shader || !bound_mesh) return;
+
+    const Mesh& mesh = *bound_mesh;
+    const u32_t first_index = mesh.first_index + mesh.get_lod_first(lod);
+    const void* indices = (const void*)(size_t)(first_index * mesh.get_index_size());
+    const GLenum index_type = mesh.index_type == IndexType::U16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    s32_t location = current_shader->get_instance_location();
+    if(location >= 0) {
+        // baseInstance offsets into the packed models, so a whole run of pooled
+        // draws can go out as one multi draw
+        if(multi_draw && mesh.pooled && bound_pool) {
+            pending_draws.push_back({
+                index_count, instances, first_index,
+                (s32_t)mesh.base_vertex, first_object });
+            multi_draw_location = location;
+            return;
         }
 
-        draw_mesh(call.mesh_id);
+        uniform_ring.bind_instances(first_object, location);
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, index_count, index_type,
+            indices, instances, mesh.base_vertex);
+        return;
+    }
+
+    // Shader doesn't read pxl_instance_model, draw the run one by one
+    bool object_block = current_shader->uses_object_block();
+    for(u32_t i = 0; i < instances; i++) {
+        if(object_block) uniform_ring.bind_object(first_object + i);
+        glDrawElementsBaseVertex(GL_TRIANGLES, index_count, index_type,
+            indices, mesh.base_vertex);
     }
+}
+
+void GL41Renderer::flush_multi_draw() {
+    if(pending_draws.empty()) return;
+
+    uniform_ring.bind_instances(0, multi_draw_location);
+    bound_pool->draw_indirect(pending_draws.data(), (u32_t)pending_draws.size());
 
-    draw_queue.clear();
+    frame_stats.multi_draws++;
+    pending_draws.clear();
 }
 
 void GL41Renderer::cleanup() {
+    current_shader = nullptr;
+    render_queue.reset();
+    frame_log.reset();
+    upload_queue.cleanup();
+    uniform_ring.cleanup();
+    pending_draws.clear();
+
+    file_watcher.stop();
+    shader_compiler.cleanup();
+    for(auto& pair : gl41_shaders) glDeleteProgram(pair.second.get_program());
     gl41_shaders.clear();
+    state_cache.reset();
 
     for(auto& pair : gl41_meshes) {
         Mesh& mesh = pair.second;
-        glDeleteVertexArrays(1, &mesh.vao);
-        glDeleteBuffers(1, &mesh.vbo);
-        glDeleteBuffers(1, &mesh.ebo);
+        if(!mesh.pooled) {
+            state_cache.forget_vao(mesh.vao);
+            state_cache.forget_buffer(mesh.vbo);
+            state_cache.forget_buffer(mesh.ebo);
+            glDeleteVertexArrays(1, &mesh.vao);
+            glDeleteBuffers(1, &mesh.vbo);
+            glDeleteBuffers(1, &mesh.ebo);
+        }
         for(u32_t tex : mesh.textures) {
+            if(texture_manager.owns(tex)) continue;
+            state_cache.forget_texture(tex);
             glDeleteTextures(1, &tex);
         }
     }
 
     gl41_meshes.clear();
+    texture_manager.cleanup();
+
+    for(auto& pair : mesh_pools) pair.second->cleanup();
+    mesh_pools.clear();
+    bound_pool = nullptr;
 }
\ No newline at end of file
@@ -30,37 +30,106 @@
 #define GL41_RENDERER_H
 
 #include "pxl_renderer.h"
+#include "pxl_render_queue.h"
 
 #include "gl41_shader.h"
 #include "gl41_mesh.h"
+#include "gl41_state_cache.h"
+#include "gl41_uniform_ring.h"
+#include "gl41_mesh_pool.h"
+#include "gl41_upload_queue.h"
+#include "gl41_texture_backend.h"
+#include "gl41_program_cache.h"
+#include "gl41_shader_compiler.h"
+
+#include "core/config.h"
+#include "core/io/pxl_file_watcher.h"
+
+#include <memory>
 
 class GL41Renderer : public PXLRenderer {
 
 private:
     
+    GL41ProgramCache program_cache;
+    GL41ShaderCompiler shader_compiler;
+    std::vector<std::pair<u64_t, u32_t>> compiled_variants;
     std::unordered_map<u64_t, GL41Shader> gl41_shaders;
     std::unordered_map<u64_t, Mesh> gl41_meshes;
 
-    u32_t bound_vao = 0;
-    std::vector<u32_t> bound_textures;
-    u64_t current_shader = 0;
+    GL41Shader* current_shader = nullptr;
+
+    RenderQueue render_queue;
+    RenderCommandLog frame_log;
+    RenderStats frame_stats;
+
+    // Declared before everything that keeps a reference to it
+    GL41StateCache state_cache;
+    GL41UniformRing uniform_ring;
+
+    // One pool per vertex layout + index type
+    MeshStorage mesh_storage;
+    std::unordered_map<u64_t, std::unique_ptr<GL41MeshPool>> mesh_pools;
+
+    // Mesh data streams in over the next frames, 0 = straight in add_mesh()
+    GL41UploadQueue upload_queue;
+    u64_t upload_budget;
 
-    std::vector<struct DrawCall> draw_queue;
+    GL41TextureBackend texture_backend;
+    TextureManager texture_manager;
+
+    // Every shader / texture file gets watched, the watcher only runs with hot reload on
+    FileWatcher file_watcher;
+    std::vector<std::string> changed_files;
+
+    // Execute state
+    const Mesh* bound_mesh = nullptr;
+    GL41MeshPool* bound_pool = nullptr;
+    bool multi_draw = false;
+    s32_t multi_draw_location = -1;
+    std::vector<GL41DrawIndirect> pending_draws;
 
 public:
-    GL41Renderer();
+    GL41Renderer(
+        MeshStorage mesh_storage = MeshStorage::SEPARATE,
+        u64_t upload_budget = PXL_UPLOAD_BUDGET_BYTES);
     ~GL41Renderer();
 
     u64_t add_mesh(struct Mesh& mesh) override;
+    void remove_mesh(u64_t mesh_id) override;
     u64_t add_shader(struct Shader& shader) override;
+    u64_t add_shader_variant(u64_t shader_id, const char* keywords, bool precompile = true) override;
+    u64_t add_material(const struct Material& material) override;
+    void set_camera(const struct Camera& camera) override;
+    u32_t load_texture(const char* path, const SamplerDesc& sampler = SamplerDesc()) override;
+    TextureManager& get_texture_manager() override { return texture_manager; }
+    void set_hot_reload(bool enabled) override;
+    void reload(const char* path) override;
     void submit_draw_call(const struct DrawCall& draw_call) override;
     void draw() override;
     void cleanup() override;
 
+    const RenderStats& get_frame_stats() const override { return frame_stats; }
+    const GL41StateStats& get_state_stats() const { return state_cache.get_stats(); }
+    GL41ProgramCache& get_program_cache() { return program_cache; }
+
+    // Executes a log recorded by the NullRenderer (or an earlier frame), ids have to
+    // refer to meshes and shaders that were added to this renderer
+    void replay(const RenderCommandLog& log);
+
 private:
 
-    void draw_mesh(const u64_t& mesh_id);
+    void submit(const RenderCommandLog& log);
+    void reload_changed();
+    void compile_shaders();
+    void stream_uploads();
+    void stream_textures();
+    void execute(const RenderCommandLog& log);
     void use_shader(const u64_t& shader_id);
+    void draw_mesh(u8_t lod, u32_t index_count, u32_t first_object, u32_t instances);
+    void flush_multi_draw();
+
+    GL41MeshPool& get_pool(const VertexLayout& layout, IndexType index_type);
 
 };
 
@@ -30,55 +30,110 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstring>
+
 #include "core/io/file.h"
+#include "pxl_shader_source.h"
+#include "pxl_std140.h"
 
-/**
- *      @param Shader
- *  
- * 
- *      
- */
-GL41Shader::GL41Shader(struct Shader& shader) {
-    program = create_program(
-        compile(
-            shader.vertex,
-            GL_VERTEX_SHADER),
-        compile(
-            shader.fragment,
-            GL_FRAGMENT_SHADER)
-    );
-}
+GL41Shader::GL41Shader(struct Shader& shader, GL41ProgramCache& programs) {
+    const char* vertex_file = file::load_shader(shader.vertex);
+    const char* fragment_file = file::load_shader(shader.fragment);
 
-u32_t GL41Shader::compile(
-    const char* source,
-    GLenum type
-) {
-    const char* _source = file::load_shader(source);
+    const std::string vertex_source = pxl::shader::with_defines(vertex_file, shader.defines);
+    const std::string fragment_source = pxl::shader::with_defines(fragment_file, shader.defines);
 
-    u32_t _shader = 0;
-    _shader = glCreateShader(type);
-    glShaderSource(_shader, 1, &_source, NULL);
-    glCompileShader(_shader);
+    delete[] vertex_file;
+    delete[] fragment_file;
 
-    delete[] _source;
-    return _shader;
+    program = programs.build(vertex_source.c_str(), fragment_source.c_str(), shader.vertex);
+    if(program) reflect();
 }
 
-u32_t GL41Shader::create_program(
-    const u32_t& vertex,
-    const u32_t& fragment
-) {
-    u32_t _program = 0;
+GL41Shader::GL41Shader(u32_t program) : program(program) {
+    if(program) reflect();
+}
+
+void GL41Shader::reflect() {
+    uniforms.clear();
+    uniform_blocks.clear();
+    uniform_lookup.clear();
+    value_cache.clear();
+    object_block = false;
+    instance_location = glGetAttribLocation(program, PXL_INSTANCE_ATTRIBUTE);
+
+    s32_t uniform_count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniform_count);
+
+    char name[256];
+
+    for(s32_t i = 0; i < uniform_count; i++) {
+        GLsizei length = 0;
+        GLint count = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, (u32_t)i, sizeof(name), &length, &count, &type, name);
+
+        // Block members have no location, they're handled per block
+        s32_t location = glGetUniformLocation(program, name);
+        if(location < 0) continue;
+
+        char* bracket = strchr(name, '[');
+        if(bracket) *bracket = 0;
 
-    _program = glCreateProgram();
-    glAttachShader(_program, vertex);
-    glAttachShader(_program, fragment);
-    glLinkProgram(_program);
+        u32_t size = 0;
+        switch(type) {
+            case GL_FLOAT: case GL_INT: case GL_UNSIGNED_INT: case GL_BOOL:
+            case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_ARRAY: case GL_SAMPLER_2D_SHADOW:
+                size = 4; break;
+            case GL_FLOAT_VEC2: case GL_INT_VEC2: size = 8; break;
+            case GL_FLOAT_VEC3: case GL_INT_VEC3: size = 12; break;
+            case GL_FLOAT_VEC4: case GL_INT_VEC4: size = 16; break;
+            case GL_FLOAT_MAT3: size = 36; break;
+            case GL_FLOAT_MAT4: size = 64; break;
+            default: size = 0; break;
+        }
 
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+        GL41Uniform uniform;
+        uniform.id = Interner::intern(name);
+        uniform.location = location;
+        uniform.type = type;
+        uniform.count = count;
+        uniform.cache_offset = (u32_t)value_cache.size();
+        uniform.cache_size = count == 1 ? size : 0;     // arrays aren't cached
+        uniform.cached = false;
 
-    return _program;
+        value_cache.resize(value_cache.size() + uniform.cache_size);
+
+        if(uniform.id >= uniform_lookup.size())
+            uniform_lookup.resize(uniform.id + 1, -1);
+        uniform_lookup[uniform.id] = (s32_t)uniforms.size();
+
+        uniforms.push_back(uniform);
+    }
+
+    s32_t block_count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+
+    for(s32_t i = 0; i < block_count; i++) {
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(program, (u32_t)i, sizeof(name), &length, name);
+
+        GLint size = 0;
+        glGetActiveUniformBlockiv(program, (u32_t)i, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+
+        uniform_blocks.push_back({ Interner::intern(name), (u32_t)i, size });
+
+        // Engine blocks get fixed binding points, the uniform ring binds ranges there
+        if(strcmp(name, PXL_FRAME_BLOCK_NAME) == 0) {
+            glUniformBlockBinding(program, (u32_t)i, PXL_FRAME_BINDING);
+        } else if(strcmp(name, PXL_MATERIAL_BLOCK_NAME) == 0) {
+            glUniformBlockBinding(program, (u32_t)i, PXL_MATERIAL_BINDING);
+        } else if(strcmp(name, PXL_OBJECT_BLOCK_NAME) == 0) {
+            glUniformBlockBinding(program, (u32_t)i, PXL_OBJECT_BINDING);
+            object_block = true;
+        }
+    }
 }
 
 void GL41Shader::use() {
@@ -89,12 +144,78 @@ void GL41Shader::clear() {
     glUseProgram(0);
 }
 
+GL41Uniform* GL41Shader::find_uniform(u32_t uniform_id) {
+    if(uniform_id >= uniform_lookup.size()) return nullptr;
+
+    s32_t index = uniform_lookup[uniform_id];
+    return index < 0 ? nullptr : &uniforms[index];
+}
+
+bool GL41Shader::has_uniform(u32_t uniform_id) const {
+    return uniform_id < uniform_lookup.size() && uniform_lookup[uniform_id] >= 0;
+}
+
+const GL41UniformBlock* GL41Shader::find_uniform_block(u32_t block_id) const {
+    for(const auto& block : uniform_blocks)
+        if(block.id == block_id) return &block;
+    return nullptr;
+}
+
+// true when the value changed and has to be uploaded
+bool GL41Shader::update_cache(GL41Uniform& uniform, const void* value, u32_t size) {
+    if(uniform.cache_size != size) return true;
+
+    u8_t* cached_value = value_cache.data() + uniform.cache_offset;
+    if(uniform.cached && memcmp(cached_value, value, size) == 0)
+        return false;
+
+    memcpy(cached_value, value, size);
+    uniform.cached = true;
+    return true;
+}
+
+#define GL41_UNIFORM_SETTER(function, type, call)                           \
+    bool GL41Shader::function(u32_t uniform_id, type value) {              \
+        GL41Uniform* uniform = find_uniform(uniform_id);                    \
+        if(!uniform || !update_cache(*uniform, &value, sizeof(value)))      \
+            return false;                                                   \
+        call;                                                               \
+        return true;                                                        \
+    }
+
+GL41_UNIFORM_SETTER(set_int, s32_t, glUniform1i(uniform->location, value))
+GL41_UNIFORM_SETTER(set_uint, u32_t, glUniform1ui(uniform->location, value))
+GL41_UNIFORM_SETTER(set_float, f32_t, glUniform1f(uniform->location, value))
+GL41_UNIFORM_SETTER(set_vec2, const glm::vec2&, glUniform2fv(uniform->location, 1, glm::value_ptr(value)))
+GL41_UNIFORM_SETTER(set_vec3, const glm::vec3&, glUniform3fv(uniform->location, 1, glm::value_ptr(value)))
+GL41_UNIFORM_SETTER(set_vec4, const glm::vec4&, glUniform4fv(uniform->location, 1, glm::value_ptr(value)))
+GL41_UNIFORM_SETTER(set_ivec2, const glm::ivec2&, glUniform2iv(uniform->location, 1, glm::value_ptr(value)))
+GL41_UNIFORM_SETTER(set_ivec3, const glm::ivec3&, glUniform3iv(uniform->location, 1, glm::value_ptr(value)))
+GL41_UNIFORM_SETTER(set_ivec4, const glm::ivec4&, glUniform4iv(uniform->location, 1, glm::value_ptr(value)))
+GL41_UNIFORM_SETTER(set_mat3, const glm::mat3&, glUniformMatrix3fv(uniform->location, 1, GL_FALSE, glm::value_ptr(value)))
+GL41_UNIFORM_SETTER(set_mat4, const glm::mat4&, glUniformMatrix4fv(uniform->location, 1, GL_FALSE, glm::value_ptr(value)))
+
+#undef GL41_UNIFORM_SETTER
+
+bool GL41Shader::set_int(const char* uniform, s32_t value) {
+    return set_int(Interner::intern(uniform), value);
+}
+
+bool GL41Shader::set_float(const char* uniform, f32_t value) {
+    return set_float(Interner::intern(uniform), value);
+}
+
+bool GL41Shader::set_vec3(const char* uniform, const glm::vec3& value) {
+    return set_vec3(Interner::intern(uniform), value);
+}
+
+bool GL41Shader::set_vec4(const char* uniform, const glm::vec4& value) {
+    return set_vec4(Interner::intern(uniform), value);
+}
+
 void GL41Shader::set_mat4(
     const char* uniform,
     const glm::mat4& mat
 ) {
-    u32_t loc = glGetUniformLocation(program, uniform);
-    if(loc != -1) {
-        glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(mat));
-    }
+    set_mat4(Interner::intern(uniform), mat);
 }
\ No newline at end of file
@@ -31,28 +31,91 @@
 
 #include "misc/utility/types.h"
 #include "pxL_renderer_backend.h"
+#include "gl41_program_cache.h"
 
 #include <glad/glad.h>
 
+// Reflected once after linking, every setter goes through these instead of
+// glGetUniformLocation. Values are cached per program so re-setting the same value
+// is a memcmp and no driver call :)*
+struct GL41Uniform {
+    u32_t id;               // Interner id, array uniforms drop their "[0]"
+    s32_t location;
+    GLenum type;
+    s32_t count;
+    u32_t cache_offset;     // into value_cache
+    u32_t cache_size;
+    bool cached;
+};
+
+struct GL41UniformBlock {
+    u32_t id;
+    u32_t index;
+    s32_t size;
+};
+
 class GL41Shader {
 
 private:
-    u32_t vertex;
-    u32_t fragment;
-    u32_t program;
+    u32_t program = 0;
+
+    std::vector<GL41Uniform> uniforms;
+    std::vector<GL41UniformBlock> uniform_blocks;
+    std::vector<s32_t> uniform_lookup;  // Interner id -> index into uniforms, -1 if inactive
+    std::vector<u8_t> value_cache;
+
+    bool object_block = false;          // declares PxlObject
+    s32_t instance_location = -1;       // of pxl_instance_model, -1 if not instanced
 
 public:
-    GL41Shader(struct Shader& shader);
+    // Reads both files, adds the shader's defines and links through the cache. A
+    // shader that failed to compile or link has no program (is_valid())
+    GL41Shader(struct Shader& shader, GL41ProgramCache& programs);
+    // Takes over an already linked program (shader variants)
+    explicit GL41Shader(u32_t program);
+
+    bool is_valid() const { return program != 0; }
 
     void use();
     void clear();
+
+    // All setters expect the program to be bound (use()). They return false when
+    // the uniform is inactive or the value was already set
+    bool set_int(u32_t uniform_id, s32_t value);
+    bool set_uint(u32_t uniform_id, u32_t value);
+    bool set_float(u32_t uniform_id, f32_t value);
+    bool set_vec2(u32_t uniform_id, const glm::vec2& value);
+    bool set_vec3(u32_t uniform_id, const glm::vec3& value);
+    bool set_vec4(u32_t uniform_id, const glm::vec4& value);
+    bool set_ivec2(u32_t uniform_id, const glm::ivec2& value);
+    bool set_ivec3(u32_t uniform_id, const glm::ivec3& value);
+    bool set_ivec4(u32_t uniform_id, const glm::ivec4& value);
+    bool set_mat3(u32_t uniform_id, const glm::mat3& value);
+    bool set_mat4(u32_t uniform_id, const glm::mat4& value);
+
+    // Name overloads intern on every call, fine outside of the draw loop
+    bool set_int(const char* uniform, s32_t value);
+    bool set_float(const char* uniform, f32_t value);
+    bool set_vec3(const char* uniform, const glm::vec3& value);
+    bool set_vec4(const char* uniform, const glm::vec4& value);
     void set_mat4(const char* uniform, const glm::mat4& mat);
 
+    bool has_uniform(u32_t uniform_id) const;
+    const GL41UniformBlock* find_uniform_block(u32_t block_id) const;
+
+    bool uses_object_block() const { return object_block; }
+    s32_t get_instance_location() const { return instance_location; }
+
+    u32_t get_program() const { return program; }
+    const std::vector<GL41Uniform>& get_uniforms() const { return uniforms; }
+
 private:
 
-    u32_t compile(const char* source, GLenum type);
-    u32_t create_program(const u32_t& vertex, const u32_t& fragment);
+    void reflect();
+
+    GL41Uniform* find_uniform(u32_t uniform_id);
+    bool update_cache(GL41Uniform& uniform, const void* value, u32_t size);
 
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,267 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "gl41_shader_compiler.h"
+#include "pxl_shader_source.h"
+
+#include "core/io/pxl_mapped_file.h"
+#include "core/thread/pxl_job_system.h"
+#include "misc/utility/generator.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+GL41ShaderCompiler::GL41ShaderCompiler(GL41ProgramCache& programs) : programs(programs) {
+
+}
+
+GL41ShaderCompiler::~GL41ShaderCompiler() {
+    cleanup();
+}
+
+void GL41ShaderCompiler::add_base(u64_t id, const Shader& shader) {
+    auto base = std::make_unique<Base>();
+    base->vertex_path = shader.vertex;
+    base->fragment_path = shader.fragment;
+    base->defines = shader.defines ? shader.defines : "";
+
+    // Only there to be reloaded, the renderer linked it already
+    auto variant = std::make_unique<Variant>();
+    variant->id = id;
+    variant->base = id;
+    variant->name = base->vertex_path;
+    variant->state.store(DONE, std::memory_order_relaxed);
+    variant->linked = true;
+
+    lookup[std::to_string(id) + ':'] = id;
+    variants[id] = std::move(variant);
+    bases[id] = std::move(base);
+}
+
+u64_t GL41ShaderCompiler::add_variant(u64_t base, const char* keywords, bool precompile, bool& created) {
+    created = false;
+
+    auto it = bases.find(base);
+    if(it == bases.end()) return 0;
+
+    std::vector<std::string> list = pxl::shader::split_keywords(keywords);
+
+    std::string joined;
+    for(const std::string& keyword : list) {
+        if(!joined.empty()) joined += ' ';
+        joined += keyword;
+    }
+
+    const std::string key = std::to_string(base) + ':' + joined;
+
+    auto existing = lookup.find(key);
+    if(existing != lookup.end()) {
+        if(precompile) fallback(existing->second);
+        return existing->second;
+    }
+
+    auto variant = std::make_unique<Variant>();
+    variant->id = Generator::generate_id();
+    variant->base = base;
+    variant->keywords = std::move(list);
+    variant->name = it->second->vertex_path + " [" + joined + "]";
+
+    Variant& added = *variant;
+    variants[added.id] = std::move(variant);
+    lookup[key] = added.id;
+    created = true;
+
+    if(precompile) start(added);
+    return added.id;
+}
+
+u64_t GL41ShaderCompiler::fallback(u64_t id) {
+    auto it = variants.find(id);
+    if(it == variants.end()) return 0;
+
+    Variant& variant = *it->second;
+    if(variant.state.load(std::memory_order_relaxed) == IDLE) start(variant);
+
+    return variant.base;
+}
+
+void GL41ShaderCompiler::start(Variant& variant) {
+    variant.state.store(PREPROCESSING, std::memory_order_relaxed);
+    preprocessing.push_back(&variant);
+
+    // Bases are never removed before cleanup(), which waits for this
+    const Base* base = bases[variant.base].get();
+    Variant* target = &variant;
+
+    pxl::jobs::submit([base, target] {
+        MappedFile vertex, fragment;
+
+        // The files are read again, not kept from the base: an edited shader
+        // compiles its variants from what's on disk now
+        if(!vertex.open(base->vertex_path.c_str()) || !fragment.open(base->fragment_path.c_str())) {
+            ERR("Couldn't read shader sources for: %s", target->name.c_str());
+            target->state.store(FAILED, std::memory_order_release);
+            return;
+        }
+
+        std::string vertex_source((const char*)vertex.data(), vertex.size());
+        std::string fragment_source((const char*)fragment.data(), fragment.size());
+
+        std::vector<std::string> declared;
+        pxl::shader::declared_keywords(vertex_source.c_str(), declared);
+        pxl::shader::declared_keywords(fragment_source.c_str(), declared);
+
+        std::string defines = base->defines;
+        for(const std::string& keyword : target->keywords) {
+            if(std::find(declared.begin(), declared.end(), keyword) == declared.end()) {
+                WRN("Keyword %s isn't declared by the shader, ignored: %s", keyword.c_str(), target->name.c_str());
+                continue;
+            }
+
+            defines += '\n';
+            defines += keyword;
+        }
+
+        target->vertex_source = pxl::shader::with_defines(vertex_source.c_str(), defines.c_str());
+        target->fragment_source = pxl::shader::with_defines(fragment_source.c_str(), defines.c_str());
+        target->state.store(PREPROCESSED, std::memory_order_release);
+    });
+}
+
+u32_t GL41ShaderCompiler::reload(const char* path) {
+    u32_t reloaded = 0;
+
+    for(auto& pair : variants) {
+        Variant& variant = *pair.second;
+        const Base& base = *bases[variant.base];
+
+        if(base.vertex_path != path && base.fragment_path != path) continue;
+
+        u8_t state = variant.state.load(std::memory_order_relaxed);
+        if(state == IDLE) continue;
+
+        // Whatever's in flight may have read the old file, it goes again once it's done
+        if(state == DONE || state == FAILED) start(variant);
+        else variant.stale = true;
+
+        reloaded++;
+    }
+
+    return reloaded;
+}
+
+void GL41ShaderCompiler::update(std::vector<std::pair<u64_t, u32_t>>& finished) {
+    auto update_start = std::chrono::steady_clock::now();
+    auto elapsed_ms = [&update_start] {
+        return std::chrono::duration<f64_t, std::milli>(std::chrono::steady_clock::now() - update_start).count();
+    };
+
+    // Reloaded while in flight, they go again after this
+    std::vector<Variant*> restart;
+
+    // Done ones first, anything begun below gets at least until the next frame
+    for(size_t i = 0; i < compiling.size();) {
+        Variant& variant = *compiling[i];
+
+        if(!programs.is_ready(variant.pending)) {
+            i++;
+            continue;
+        }
+
+        compiling[i] = compiling.back();
+        compiling.pop_back();
+
+        u32_t program = programs.finish(variant.pending);
+
+        if(program) {
+            variant.state.store(DONE, std::memory_order_relaxed);
+            variant.linked = true;
+            finished.emplace_back(variant.id, program);
+        } else {
+            variant.state.store(FAILED, std::memory_order_relaxed);
+
+            if(variant.linked) WRN("Shader reload failed, keeping the previous program: %s", variant.name.c_str());
+            else WRN("Shader variant failed, it keeps drawing with its base shader: %s", variant.name.c_str());
+        }
+
+        if(variant.stale) restart.push_back(&variant);
+    }
+
+    bool started = false;
+
+    for(size_t i = 0; i < preprocessing.size();) {
+        Variant& variant = *preprocessing[i];
+        u8_t state = variant.state.load(std::memory_order_acquire);
+
+        if(state == PREPROCESSING) {
+            i++;
+            continue;
+        }
+
+        if(state == PREPROCESSED) {
+            if(started && elapsed_ms() >= PXL_SHADER_COMPILE_BUDGET_MS) break;
+
+            programs.begin(variant.vertex_source.c_str(), variant.fragment_source.c_str(),
+                variant.name.c_str(), variant.pending);
+
+            std::string().swap(variant.vertex_source);
+            std::string().swap(variant.fragment_source);
+
+            variant.state.store(COMPILING, std::memory_order_relaxed);
+            compiling.push_back(&variant);
+            started = true;
+        } else if(variant.stale) {
+            restart.push_back(&variant);
+        }
+
+        preprocessing[i] = preprocessing.back();
+        preprocessing.pop_back();
+    }
+
+    for(Variant* variant : restart) {
+        variant->stale = false;
+        start(*variant);
+    }
+}
+
+void GL41ShaderCompiler::cleanup() {
+    for(Variant* variant : preprocessing)
+        while(variant->state.load(std::memory_order_acquire) == PREPROCESSING)
+            std::this_thread::yield();
+
+    for(Variant* variant : compiling) programs.discard(variant->pending);
+
+    preprocessing.clear();
+    compiling.clear();
+    lookup.clear();
+    variants.clear();
+    bases.clear();
+}
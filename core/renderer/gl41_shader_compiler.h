@@ -0,0 +1,144 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef GL41_SHADER_COMPILER_H
+#define GL41_SHADER_COMPILER_H
+
+#include "pxl_renderer_backend.h"
+#include "gl41_program_cache.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Context thread time per frame for starting / finishing variants, at least one
+// starts every frame. Even with parallel shader compile some drivers (Mesa) parse
+// the GLSL inside glCompileShader, a burst of variants would eat whole frames
+#ifndef PXL_SHADER_COMPILE_BUDGET_MS
+#define PXL_SHADER_COMPILE_BUDGET_MS 2.0
+#endif
+
+// Shader variants for the GL41Renderer. A variant id is handed out right away and
+// draws with its plain (base) shader until the real program is linked:
+//
+//      worker:     read both files, pick the declared keywords, inject the defines
+//      context:    begin() the compile + link within the frame's time budget, the
+//                  driver links in the background (KHR_parallel_shader_compile)
+//      context:    finish() once the driver says it's done, update() hands the
+//                  program to the renderer which swaps it in
+//
+// Precompiled variants start when they're added, lazy ones on their first draw.
+//
+// reload() runs base shaders and their started variants through the same steps
+// again after their files changed. They keep drawing with the program they have
+// until the new one links, one that fails to compile keeps the old one for good
+class GL41ShaderCompiler {
+
+private:
+    enum : u8_t {
+        IDLE,
+        PREPROCESSING,
+        PREPROCESSED,
+        COMPILING,
+        DONE,
+        FAILED
+    };
+
+    struct Base {
+        std::string vertex_path;
+        std::string fragment_path;
+        std::string defines;
+    };
+
+    struct Variant {
+        u64_t id = 0;
+        u64_t base = 0;
+        std::vector<std::string> keywords;
+        std::string name;                   // for logs, "path [KEYWORDS]"
+
+        std::atomic<u8_t> state { IDLE };
+        bool linked = false;                // the renderer has a program for it
+        bool stale = false;                 // files changed while it was compiling
+        std::string vertex_source;          // worker output, valid on PREPROCESSED
+        std::string fragment_source;
+        GL41PendingProgram pending;
+    };
+
+    GL41ProgramCache& programs;
+
+    std::unordered_map<u64_t, std::unique_ptr<Base>> bases;
+    std::unordered_map<u64_t, std::unique_ptr<Variant>> variants;      // bases too, without keywords
+    std::unordered_map<std::string, u64_t> lookup;     // base id + keywords -> variant
+
+    std::vector<Variant*> preprocessing;
+    std::vector<Variant*> compiling;
+
+public:
+    GL41ShaderCompiler(GL41ProgramCache& programs);
+    ~GL41ShaderCompiler();
+
+    GL41ShaderCompiler(const GL41ShaderCompiler&) = delete;
+    GL41ShaderCompiler& operator=(const GL41ShaderCompiler&) = delete;
+
+    // Remembers the files of a shader the renderer linked, variants start from them.
+    // No keywords is the base itself
+    void add_base(u64_t id, const Shader& shader);
+
+    // 0 when `base` isn't a base shader. `created` is false for keywords the base
+    // already has a variant with
+    u64_t add_variant(u64_t base, const char* keywords, bool precompile, bool& created);
+
+    // Base shader to draw `id` with while it's compiling (starts lazy ones), 0 when
+    // `id` isn't a variant
+    u64_t fallback(u64_t id);
+
+    // Rebuilds every shader reading `path` (spelled like in add_base()), variants
+    // nobody drew yet pick the new file up when they start. Returns how many
+    u32_t reload(const char* path);
+
+    // Context thread, once per frame. Variants that linked land in `finished` as
+    // (id, program), the caller owns the programs from then on. Reloaded ones come
+    // out the same way, the caller swaps them for the program it has
+    void update(std::vector<std::pair<u64_t, u32_t>>& finished);
+
+    // Variants started and not linked (or failed) yet
+    u64_t get_pending() const { return preprocessing.size() + compiling.size(); }
+
+    // Waits for the workers and drops everything, programs still linking included
+    void cleanup();
+
+private:
+
+    void start(Variant& variant);
+
+};
+
+#endif
@@ -0,0 +1,313 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "gl41_state_cache.h"
+
+static const GLenum gl_blend_factors[] = {
+    GL_ZERO,
+    GL_ONE,
+    GL_SRC_COLOR,
+    GL_ONE_MINUS_SRC_COLOR,
+    GL_DST_COLOR,
+    GL_ONE_MINUS_DST_COLOR,
+    GL_SRC_ALPHA,
+    GL_ONE_MINUS_SRC_ALPHA,
+    GL_DST_ALPHA,
+    GL_ONE_MINUS_DST_ALPHA,
+};
+
+static const GLenum gl_blend_ops[] = {
+    GL_FUNC_ADD,
+    GL_FUNC_SUBTRACT,
+    GL_FUNC_REVERSE_SUBTRACT,
+    GL_MIN,
+    GL_MAX,
+};
+
+static const GLenum gl_compare_funcs[] = {
+    GL_NEVER,
+    GL_LESS,
+    GL_EQUAL,
+    GL_LEQUAL,
+    GL_GREATER,
+    GL_NOTEQUAL,
+    GL_GEQUAL,
+    GL_ALWAYS,
+};
+
+GL41StateCache::GL41StateCache() {
+    reset();
+}
+
+void GL41StateCache::reset() {
+    state_known = false;
+
+    program = UNKNOWN;
+    vao = UNKNOWN;
+    framebuffer = UNKNOWN;
+    active_unit = UNKNOWN;
+
+    for(auto& buffer : buffers) buffer = UNKNOWN;
+    for(auto& range : uniform_ranges) range = BufferRange();
+
+    for(u32_t i = 0; i < PXL_GL_TEXTURE_UNITS; i++) {
+        textures[i] = UNKNOWN;
+        texture_targets[i] = 0;
+        samplers[i] = UNKNOWN;
+    }
+
+    viewport = glm::ivec4(-1);
+    scissor_rect = glm::ivec4(-1);
+    clear_color = glm::vec4(-1.0f);
+}
+
+void GL41StateCache::set_capability(GLenum capability, bool enabled) {
+    if(enabled) glEnable(capability);
+    else glDisable(capability);
+}
+
+void GL41StateCache::apply(const RenderState& next) {
+    // Nothing known yet, send all of it once
+    const bool force = !state_known;
+    const RenderState& current = state;
+
+    // Blend factors / op and the depth func only matter while enabled, while
+    // disabled they're left alone and the cache keeps what GL really has
+    RenderState applied = next;
+
+    if(changed(force || current.blend != next.blend))
+        set_capability(GL_BLEND, next.blend);
+
+    if(next.blend || force) {
+        bool factors_differ = force
+            || current.blend_src_color != next.blend_src_color
+            || current.blend_dst_color != next.blend_dst_color
+            || current.blend_src_alpha != next.blend_src_alpha
+            || current.blend_dst_alpha != next.blend_dst_alpha;
+
+        if(changed(factors_differ)) {
+            glBlendFuncSeparate(
+                gl_blend_factors[(u8_t)next.blend_src_color],
+                gl_blend_factors[(u8_t)next.blend_dst_color],
+                gl_blend_factors[(u8_t)next.blend_src_alpha],
+                gl_blend_factors[(u8_t)next.blend_dst_alpha]);
+        }
+
+        if(changed(force || current.blend_op != next.blend_op))
+            glBlendEquation(gl_blend_ops[(u8_t)next.blend_op]);
+    } else {
+        applied.blend_src_color = current.blend_src_color;
+        applied.blend_dst_color = current.blend_dst_color;
+        applied.blend_src_alpha = current.blend_src_alpha;
+        applied.blend_dst_alpha = current.blend_dst_alpha;
+        applied.blend_op = current.blend_op;
+    }
+
+    if(changed(force || current.depth_test != next.depth_test))
+        set_capability(GL_DEPTH_TEST, next.depth_test);
+
+    if(changed(force || current.depth_write != next.depth_write))
+        glDepthMask(next.depth_write ? GL_TRUE : GL_FALSE);
+
+    if(next.depth_test || force) {
+        if(changed(force || current.depth_func != next.depth_func))
+            glDepthFunc(gl_compare_funcs[(u8_t)next.depth_func]);
+    } else {
+        applied.depth_func = current.depth_func;
+    }
+
+    if(changed(force || current.cull != next.cull)) {
+        set_capability(GL_CULL_FACE, next.cull != CullMode::NONE);
+        if(next.cull != CullMode::NONE)
+            glCullFace(next.cull == CullMode::FRONT ? GL_FRONT : GL_BACK);
+    }
+
+    if(changed(force || current.front_ccw != next.front_ccw))
+        glFrontFace(next.front_ccw ? GL_CCW : GL_CW);
+
+    if(changed(force || current.color_mask != next.color_mask)) {
+        glColorMask(
+            (next.color_mask & 1) != 0, (next.color_mask & 2) != 0,
+            (next.color_mask & 4) != 0, (next.color_mask & 8) != 0);
+    }
+
+    if(changed(force || current.scissor != next.scissor))
+        set_capability(GL_SCISSOR_TEST, next.scissor);
+
+    state = applied;
+    state_known = true;
+}
+
+void GL41StateCache::prepare_clear() {
+    RenderState clear_state = state_known ? state : RenderState();
+    clear_state.depth_write = true;
+    clear_state.color_mask = 0xF;
+    clear_state.scissor = false;
+    apply(clear_state);
+}
+
+void GL41StateCache::use_program(u32_t next) {
+    if(!changed(program != next)) return;
+    glUseProgram(next);
+    program = next;
+}
+
+void GL41StateCache::bind_vao(u32_t next) {
+    if(!changed(vao != next)) return;
+    glBindVertexArray(next);
+    vao = next;
+}
+
+void GL41StateCache::bind_framebuffer(u32_t next) {
+    if(!changed(framebuffer != next)) return;
+    glBindFramebuffer(GL_FRAMEBUFFER, next);
+    framebuffer = next;
+}
+
+s32_t GL41StateCache::buffer_target_index(GLenum target) {
+    switch(target) {
+        case GL_ARRAY_BUFFER:           return ARRAY_BUFFER;
+        case GL_UNIFORM_BUFFER:         return UNIFORM_BUFFER;
+        case GL_DRAW_INDIRECT_BUFFER:   return DRAW_INDIRECT_BUFFER;
+        case GL_COPY_READ_BUFFER:       return COPY_READ_BUFFER;
+        case GL_COPY_WRITE_BUFFER:      return COPY_WRITE_BUFFER;
+        default:                        return -1;
+    }
+}
+
+void GL41StateCache::bind_buffer(GLenum target, u32_t buffer) {
+    s32_t index = buffer_target_index(target);
+    if(index < 0) {
+        stats.issued++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+
+    if(!changed(buffers[index] != buffer)) return;
+    glBindBuffer(target, buffer);
+    buffers[index] = buffer;
+}
+
+void GL41StateCache::bind_buffer_range(u32_t index, u32_t buffer, GLintptr offset, GLsizeiptr size) {
+    if(index >= PXL_GL_UNIFORM_BINDINGS) {
+        stats.issued++;
+        glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, offset, size);
+        buffers[UNIFORM_BUFFER] = buffer;
+        return;
+    }
+
+    BufferRange& range = uniform_ranges[index];
+    if(!changed(range.buffer != buffer || range.offset != offset || range.size != size))
+        return;
+
+    // Also binds the generic GL_UNIFORM_BUFFER point
+    glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, offset, size);
+    range = { buffer, offset, size };
+    buffers[UNIFORM_BUFFER] = buffer;
+}
+
+void GL41StateCache::bind_texture(u32_t unit, GLenum target, u32_t texture) {
+    if(unit >= PXL_GL_TEXTURE_UNITS) {
+        stats.issued += 2;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        active_unit = unit;
+        return;
+    }
+
+    if(!changed(textures[unit] != texture || texture_targets[unit] != target)) return;
+
+    if(changed(active_unit != unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        active_unit = unit;
+    }
+
+    glBindTexture(target, texture);
+    textures[unit] = texture;
+    texture_targets[unit] = target;
+}
+
+void GL41StateCache::bind_sampler(u32_t unit, u32_t sampler) {
+    // Sampler binds take the unit directly, no glActiveTexture
+    if(unit >= PXL_GL_TEXTURE_UNITS) {
+        stats.issued++;
+        glBindSampler(unit, sampler);
+        return;
+    }
+
+    if(!changed(samplers[unit] != sampler)) return;
+
+    glBindSampler(unit, sampler);
+    samplers[unit] = sampler;
+}
+
+void GL41StateCache::set_viewport(s32_t x, s32_t y, s32_t width, s32_t height) {
+    glm::ivec4 next(x, y, width, height);
+    if(!changed(viewport != next)) return;
+    glViewport(x, y, width, height);
+    viewport = next;
+}
+
+void GL41StateCache::set_scissor(s32_t x, s32_t y, s32_t width, s32_t height) {
+    glm::ivec4 next(x, y, width, height);
+    if(!changed(scissor_rect != next)) return;
+    glScissor(x, y, width, height);
+    scissor_rect = next;
+}
+
+void GL41StateCache::set_clear_color(const glm::vec4& color) {
+    if(!changed(clear_color != color)) return;
+    glClearColor(color.r, color.g, color.b, color.a);
+    clear_color = color;
+}
+
+void GL41StateCache::forget_program(u32_t forgotten) {
+    if(program == forgotten) program = UNKNOWN;
+}
+
+void GL41StateCache::forget_vao(u32_t forgotten) {
+    if(vao == forgotten) vao = UNKNOWN;
+}
+
+void GL41StateCache::forget_buffer(u32_t forgotten) {
+    for(auto& buffer : buffers)
+        if(buffer == forgotten) buffer = UNKNOWN;
+
+    for(auto& range : uniform_ranges)
+        if(range.buffer == forgotten) range = BufferRange();
+}
+
+void GL41StateCache::forget_texture(u32_t forgotten) {
+    for(u32_t i = 0; i < PXL_GL_TEXTURE_UNITS; i++)
+        if(textures[i] == forgotten) textures[i] = UNKNOWN;
+}
+
+void GL41StateCache::forget_sampler(u32_t forgotten) {
+    for(u32_t i = 0; i < PXL_GL_TEXTURE_UNITS; i++)
+        if(samplers[i] == forgotten) samplers[i] = UNKNOWN;
+}
@@ -0,0 +1,149 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef GL41_STATE_CACHE_H
+#define GL41_STATE_CACHE_H
+
+#include "misc/utility/types.h"
+#include "pxl_render_state.h"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#ifndef PXL_GL_TEXTURE_UNITS
+#define PXL_GL_TEXTURE_UNITS 32
+#endif
+
+#ifndef PXL_GL_UNIFORM_BINDINGS
+#define PXL_GL_UNIFORM_BINDINGS 16
+#endif
+
+struct GL41StateStats {
+    u64_t issued = 0;       // GL calls that went through to the driver
+    u64_t avoided = 0;      // calls dropped because the state was already set
+};
+
+// Shadow copy of the GL state the renderer touches. Every setter compares against
+// what is known to be bound and only calls GL when it differs.
+//
+// Every bind the renderer does goes through here, mesh creation, the mesh pools and
+// the upload queue included, so the copy targets stay bound between uses instead of
+// being reset to 0. Code outside the renderer (window resize, ImGui) still calls GL
+// directly, so GL41Renderer calls reset() at the start of every draw(). Deleting an
+// object that might still be cached has to go through forget_*(), GL reuses names
+class GL41StateCache {
+
+private:
+    static constexpr u32_t UNKNOWN = ~0u;
+
+    struct BufferRange {
+        u32_t buffer = UNKNOWN;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+    };
+
+    enum BufferTarget : u8_t {
+        ARRAY_BUFFER,
+        UNIFORM_BUFFER,
+        DRAW_INDIRECT_BUFFER,
+        COPY_READ_BUFFER,
+        COPY_WRITE_BUFFER,
+        BUFFER_TARGET_COUNT
+    };
+
+    bool state_known = false;
+    RenderState state;
+
+    u32_t program = UNKNOWN;
+    u32_t vao = UNKNOWN;
+    u32_t framebuffer = UNKNOWN;
+    u32_t buffers[BUFFER_TARGET_COUNT];
+    BufferRange uniform_ranges[PXL_GL_UNIFORM_BINDINGS];
+
+    u32_t active_unit = UNKNOWN;
+    u32_t textures[PXL_GL_TEXTURE_UNITS];
+    GLenum texture_targets[PXL_GL_TEXTURE_UNITS];
+    u32_t samplers[PXL_GL_TEXTURE_UNITS];
+
+    glm::ivec4 viewport = glm::ivec4(-1);
+    glm::ivec4 scissor_rect = glm::ivec4(-1);
+    glm::vec4 clear_color = glm::vec4(-1.0f);
+
+    GL41StateStats stats;
+
+public:
+    GL41StateCache();
+
+    // Forget everything, the next call of each setter goes through
+    void reset();
+
+    void apply(const RenderState& state);
+
+    // glClear respects the depth / color masks and the scissor, opens them up first
+    void prepare_clear();
+
+    void use_program(u32_t program);
+    void bind_vao(u32_t vao);
+    void bind_framebuffer(u32_t framebuffer);
+
+    // ELEMENT_ARRAY_BUFFER is VAO state and not cached, unknown targets pass through
+    void bind_buffer(GLenum target, u32_t buffer);
+    void bind_buffer_range(u32_t index, u32_t buffer, GLintptr offset, GLsizeiptr size);
+
+    void bind_texture(u32_t unit, GLenum target, u32_t texture);
+    // Sampler objects override the texture's own parameters, 0 = back to those
+    void bind_sampler(u32_t unit, u32_t sampler);
+
+    void set_viewport(s32_t x, s32_t y, s32_t width, s32_t height);
+    void set_scissor(s32_t x, s32_t y, s32_t width, s32_t height);
+    void set_clear_color(const glm::vec4& color);
+
+    void forget_program(u32_t program);
+    void forget_vao(u32_t vao);
+    void forget_buffer(u32_t buffer);
+    void forget_texture(u32_t texture);
+    void forget_sampler(u32_t sampler);
+
+    u32_t get_vao() const { return vao; }
+    const GL41StateStats& get_stats() const { return stats; }
+    void reset_stats() { stats = {}; }
+
+private:
+
+    bool changed(bool differs) {
+        if(differs) stats.issued++;
+        else stats.avoided++;
+        return differs;
+    }
+
+    static s32_t buffer_target_index(GLenum target);
+    void set_capability(GLenum capability, bool enabled);
+
+};
+
+#endif
@@ -0,0 +1,183 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "gl41_texture_backend.h"
+
+#include "misc/utility/log.h"
+
+#include <cstring>
+
+// Extension enums GLAD wasn't generated with
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT     0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT    0x83F3
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR     0x93B0
+
+GL41TextureBackend::GL41TextureBackend(GL41StateCache& state) : state(state) {
+
+}
+
+u32_t GL41TextureBackend::create_texture() {
+    u32_t texture = 0;
+    glGenTextures(1, &texture);
+    return texture;
+}
+
+void GL41TextureBackend::destroy_texture(u32_t texture) {
+    state.forget_texture(texture);
+    glDeleteTextures(1, &texture);
+}
+
+static GLenum gl41_internal_format(TextureFormat format) {
+    switch(format) {
+        case TextureFormat::RGBA8:      return GL_RGBA8;
+        case TextureFormat::BC1:        return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3:        return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::BC5:        return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::BC7:        return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case TextureFormat::ETC2_RGB8:  return GL_COMPRESSED_RGB8_ETC2;
+        case TextureFormat::ETC2_RGBA8: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case TextureFormat::ASTC_4X4:   return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        case TextureFormat::COUNT:      break;
+    }
+    return GL_NONE;
+}
+
+bool GL41TextureBackend::supports(TextureFormat format) const {
+    if(!formats_queried) {
+        formats_queried = true;
+
+        auto add = [&](TextureFormat supported) { formats |= 1u << (u32_t)supported; };
+
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+        bool s3tc = false, bptc = false, etc2 = false, astc = false;
+        for(GLint i = 0; i < count; i++) {
+            const char* name = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if(!name) continue;
+
+            if(!std::strcmp(name, "GL_EXT_texture_compression_s3tc")) s3tc = true;
+            else if(!std::strcmp(name, "GL_ARB_texture_compression_bptc")) bptc = true;
+            else if(!std::strcmp(name, "GL_ARB_ES3_compatibility")) etc2 = true;
+            else if(!std::strcmp(name, "GL_KHR_texture_compression_astc_ldr")) astc = true;
+        }
+
+        // RGTC is core since 3.0, BPTC since 4.2, ETC2 since 4.3. S3TC never made
+        // it into core but every desktop driver has it
+        add(TextureFormat::RGBA8);
+        add(TextureFormat::BC5);
+        if(s3tc) {
+            add(TextureFormat::BC1);
+            add(TextureFormat::BC3);
+        }
+        if(bptc || GLAD_GL_VERSION_4_2) add(TextureFormat::BC7);
+        if(etc2 || GLAD_GL_VERSION_4_3) {
+            add(TextureFormat::ETC2_RGB8);
+            add(TextureFormat::ETC2_RGBA8);
+        }
+        if(astc) add(TextureFormat::ASTC_4X4);
+    }
+
+    return format < TextureFormat::COUNT && (formats & (1u << (u32_t)format));
+}
+
+void GL41TextureBackend::upload_level(u32_t texture, TextureFormat format, u8_t level,
+    u32_t width, u32_t height, const void* data, size_t bytes) {
+    state.bind_texture(0, GL_TEXTURE_2D, texture);
+
+    if(format == TextureFormat::RGBA8) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, data);
+    } else {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, gl41_internal_format(format),
+            width, height, 0, (GLsizei)bytes, data);
+    }
+}
+
+void GL41TextureBackend::release_level(u32_t texture, TextureFormat format, u8_t level) {
+    (void)format;
+
+    state.bind_texture(0, GL_TEXTURE_2D, texture);
+
+    // A 0x0 level owns no memory, base level > level keeps it out of completeness.
+    // Compressed ones too, the level's format doesn't matter once it's empty
+    glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, 0, 0, 0,
+        GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+}
+
+void GL41TextureBackend::set_level_range(u32_t texture, u8_t base, u8_t max) {
+    state.bind_texture(0, GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, base);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, max);
+}
+
+static GLint gl41_wrap(TextureWrap wrap) {
+    switch(wrap) {
+        case TextureWrap::REPEAT:   return GL_REPEAT;
+        case TextureWrap::CLAMP:    return GL_CLAMP_TO_EDGE;
+        case TextureWrap::MIRROR:   return GL_MIRRORED_REPEAT;
+    }
+    return GL_REPEAT;
+}
+
+u32_t GL41TextureBackend::create_sampler(const SamplerDesc& sampler) {
+    u32_t name = 0;
+    glGenSamplers(1, &name);
+
+    GLint min_filter = GL_LINEAR_MIPMAP_LINEAR;
+    GLint mag_filter = GL_LINEAR;
+
+    switch(sampler.filter) {
+        case TextureFilter::NEAREST:
+            min_filter = GL_NEAREST_MIPMAP_NEAREST;
+            mag_filter = GL_NEAREST;
+            break;
+        case TextureFilter::LINEAR:
+            min_filter = GL_LINEAR_MIPMAP_NEAREST;
+            break;
+        case TextureFilter::TRILINEAR:
+            break;
+    }
+
+    glSamplerParameteri(name, GL_TEXTURE_MIN_FILTER, min_filter);
+    glSamplerParameteri(name, GL_TEXTURE_MAG_FILTER, mag_filter);
+    glSamplerParameteri(name, GL_TEXTURE_WRAP_S, gl41_wrap(sampler.wrap_u));
+    glSamplerParameteri(name, GL_TEXTURE_WRAP_T, gl41_wrap(sampler.wrap_v));
+
+    // Core since 4.6, before that it's an extension GLAD doesn't load here
+    if(sampler.anisotropy > 1 && GLAD_GL_VERSION_4_6)
+        glSamplerParameterf(name, GL_TEXTURE_MAX_ANISOTROPY, (f32_t)sampler.anisotropy);
+
+    return name;
+}
+
+void GL41TextureBackend::destroy_sampler(u32_t sampler) {
+    state.forget_sampler(sampler);
+    glDeleteSamplers(1, &sampler);
+}
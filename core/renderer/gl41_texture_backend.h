@@ -0,0 +1,71 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef GL41_TEXTURE_BACKEND_H
+#define GL41_TEXTURE_BACKEND_H
+
+#include "pxl_texture_manager.h"
+#include "gl41_state_cache.h"
+
+#include <glad/glad.h>
+
+// TextureManager on GL 4.1. Storage is mutable (glTexImage2D per level, no
+// glTexStorage before 4.2), so levels can be defined and dropped one by one under
+// a name that never changes. GL_TEXTURE_BASE_LEVEL keeps the sampler off the
+// levels that aren't there. Binds go through texture unit 0 of the state cache.
+// Block formats go up as they are (glCompressedTexImage2D), which ones the driver
+// takes comes from the version and the extension list
+class GL41TextureBackend : public TextureBackend {
+
+private:
+    GL41StateCache& state;
+
+    // Bit per TextureFormat, asked once the context is up
+    mutable u32_t formats = 0;
+    mutable bool formats_queried = false;
+
+public:
+    GL41TextureBackend(GL41StateCache& state);
+
+    u32_t create_texture() override;
+    void destroy_texture(u32_t texture) override;
+
+    bool supports(TextureFormat format) const override;
+
+    void upload_level(u32_t texture, TextureFormat format, u8_t level,
+        u32_t width, u32_t height, const void* data, size_t bytes) override;
+    void release_level(u32_t texture, TextureFormat format, u8_t level) override;
+    void set_level_range(u32_t texture, u8_t base, u8_t max) override;
+
+    u32_t create_sampler(const SamplerDesc& sampler) override;
+    void destroy_sampler(u32_t sampler) override;
+
+};
+
+#endif
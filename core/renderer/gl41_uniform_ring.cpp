@@ -0,0 +1,236 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "gl41_uniform_ring.h"
+
+#include "core/debug/pxl_profiler.h"
+#include "misc/utility/log.h"
+
+#include <cstring>
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+GL41UniformRing::GL41UniformRing(GL41StateCache& state) : state(state) {
+
+}
+
+GL41UniformRing::~GL41UniformRing() {
+    cleanup();
+}
+
+void GL41UniformRing::init(size_t bytes_per_frame) {
+    GLint offset_alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offset_alignment);
+
+    alignment = offset_alignment > 0 ? (size_t)offset_alignment : 256;
+    frame_block_size = align_up(sizeof(PxlFrameConstants), alignment);
+    material_stride = align_up(sizeof(PxlMaterialConstants), alignment);
+    object_stride = align_up(sizeof(PxlObjectConstants), alignment);
+
+    persistent = GLAD_GL_VERSION_4_4 != 0;
+
+    create(bytes_per_frame);
+}
+
+void GL41UniformRing::cleanup() {
+    if(!buffer) return;
+
+    for(u32_t i = 0; i < PXL_UNIFORM_RING_FRAMES; i++)
+        wait(i);
+
+    destroy();
+}
+
+void GL41UniformRing::create(size_t bytes_per_frame) {
+    frame_size = align_up(bytes_per_frame, alignment);
+    size_t total = frame_size * PXL_UNIFORM_RING_FRAMES;
+
+    glGenBuffers(1, &buffer);
+    state.bind_buffer(GL_UNIFORM_BUFFER, buffer);
+
+    if(persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, total, nullptr, flags);
+        mapped = (u8_t*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, total, flags);
+
+        if(!mapped) {
+            WRN("Persistent uniform ring mapping failed, falling back to per frame maps");
+            state.forget_buffer(buffer);
+            glDeleteBuffers(1, &buffer);
+            persistent = false;
+            create(bytes_per_frame);
+            return;
+        }
+    } else {
+        glBufferData(GL_UNIFORM_BUFFER, total, nullptr, GL_STREAM_DRAW);
+    }
+
+    LOG("Uniform ring: %llu KB x %d frames (%s)",
+        (u64_t)(frame_size / 1024), PXL_UNIFORM_RING_FRAMES,
+        persistent ? "persistent" : "mapped per frame");
+}
+
+void GL41UniformRing::destroy() {
+    if(mapped) {
+        state.bind_buffer(GL_UNIFORM_BUFFER, buffer);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        mapped = nullptr;
+    }
+
+    state.forget_buffer(buffer);
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+void GL41UniformRing::wait(u32_t frame) {
+    GLsync& fence = fences[frame];
+    if(!fence) return;
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+
+    if(result == GL_TIMEOUT_EXPIRED) {
+        stalls++;
+
+        // Flush once so the fence can actually signal, then block
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        while(result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync(fence, 0, 1000000);
+    }
+
+    if(result == GL_WAIT_FAILED)
+        ERR("Uniform ring fence wait failed");
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+size_t GL41UniformRing::upload(const RenderCommandLog& log) {
+    PXL_PROFILE_FUNCTION();
+
+    if(!buffer) init();
+
+    size_t materials_size = log.materials.size() * material_stride;
+    size_t objects_size = frame_block_size + materials_size + log.objects.size() * object_stride;
+    size_t needed = objects_size + log.objects.size() * sizeof(glm::mat4);
+
+    // Grow by doubling, waits for every region since the old buffer goes away
+    if(needed > frame_size) {
+        size_t new_size = frame_size;
+        while(new_size < needed) new_size *= 2;
+
+        WRN("Uniform ring too small (%llu bytes needed), growing to %llu KB per frame",
+            (u64_t)needed, (u64_t)(new_size / 1024));
+
+        cleanup();
+        create(new_size);
+    }
+
+    wait(frame_index);
+    region_offset = frame_index * frame_size;
+
+    u8_t* region = nullptr;
+    if(persistent) {
+        region = mapped + region_offset;
+    } else {
+        state.bind_buffer(GL_UNIFORM_BUFFER, buffer);
+        region = (u8_t*)glMapBufferRange(
+            GL_UNIFORM_BUFFER, region_offset, needed,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+        if(!region) {
+            ERR("Uniform ring map failed");
+            state.bind_buffer(GL_UNIFORM_BUFFER, 0);
+            return 0;
+        }
+    }
+
+    memcpy(region, &log.frame, sizeof(PxlFrameConstants));
+
+    u8_t* material = region + frame_block_size;
+    for(const PxlMaterialConstants& constants : log.materials) {
+        memcpy(material, &constants, sizeof(PxlMaterialConstants));
+        material += material_stride;
+    }
+
+    u8_t* object = region + frame_block_size + materials_size;
+    glm::mat4* model = (glm::mat4*)(region + objects_size);
+
+    for(const PxlObjectConstants& constants : log.objects) {
+        memcpy(object, &constants, sizeof(PxlObjectConstants));
+        object += object_stride;
+        *model++ = constants.model;
+    }
+
+    objects_offset = region_offset + frame_block_size + materials_size;
+    instance_offset = region_offset + objects_size;
+
+    if(!persistent)
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+
+    return needed;
+}
+
+void GL41UniformRing::bind_frame() {
+    state.bind_buffer_range(PXL_FRAME_BINDING, buffer,
+        region_offset, sizeof(PxlFrameConstants));
+}
+
+void GL41UniformRing::bind_material(u32_t material_index) {
+    state.bind_buffer_range(PXL_MATERIAL_BINDING, buffer,
+        region_offset + frame_block_size + material_index * material_stride,
+        sizeof(PxlMaterialConstants));
+}
+
+void GL41UniformRing::bind_object(u32_t object_index) {
+    state.bind_buffer_range(PXL_OBJECT_BINDING, buffer,
+        objects_offset + object_index * object_stride,
+        sizeof(PxlObjectConstants));
+}
+
+void GL41UniformRing::bind_instances(u32_t first_object, s32_t location) {
+    state.bind_buffer(GL_ARRAY_BUFFER, buffer);
+
+    size_t offset = instance_offset + first_object * sizeof(glm::mat4);
+
+    for(s32_t column = 0; column < 4; column++) {
+        u32_t attribute = (u32_t)(location + column);
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+            (void*)(offset + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(attribute, 1);
+    }
+}
+
+void GL41UniformRing::end_frame() {
+    if(!buffer) return;
+
+    fences[frame_index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame_index = (frame_index + 1) % PXL_UNIFORM_RING_FRAMES;
+}
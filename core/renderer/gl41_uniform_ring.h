@@ -0,0 +1,116 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef GL41_UNIFORM_RING_H
+#define GL41_UNIFORM_RING_H
+
+#include "misc/utility/types.h"
+#include "pxl_render_commands.h"
+#include "gl41_state_cache.h"
+
+#include <glad/glad.h>
+
+#ifndef PXL_UNIFORM_RING_FRAMES
+#define PXL_UNIFORM_RING_FRAMES 3
+#endif
+
+#ifndef PXL_UNIFORM_RING_FRAME_BYTES
+#define PXL_UNIFORM_RING_FRAME_BYTES (1 << 20)
+#endif
+
+// One big UBO split into PXL_UNIFORM_RING_FRAMES regions. Each frame writes its
+// PxlFrame block, the PxlMaterial block of every material it uses (once each) and
+// every PxlObject block linearly into its own region, then draws
+// just move a glBindBufferRange window over it. The model matrices are written a
+// second time tightly packed behind the blocks, instanced draws read those as a
+// per instance vertex attribute (buffers don't care what they're bound as). A fence per region keeps the CPU
+// from writing over constants the GPU hasn't read yet.
+//
+// On 4.4+ drivers the buffer is persistently mapped, on plain 4.1 the region gets
+// mapped unsynchronized once per frame (the fence is the synchronization)
+class GL41UniformRing {
+
+private:
+    GL41StateCache& state;
+
+    u32_t buffer = 0;
+    u8_t* mapped = nullptr;         // persistent mapping, null on 4.1
+    bool persistent = false;
+
+    size_t frame_size = 0;          // bytes per region
+    size_t alignment = 256;         // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    size_t frame_block_size = 0;    // PxlFrameConstants rounded up to alignment
+    size_t material_stride = 0;     // PxlMaterialConstants rounded up to alignment
+    size_t object_stride = 0;       // PxlObjectConstants rounded up to alignment
+
+    u32_t frame_index = 0;
+    size_t region_offset = 0;
+    size_t objects_offset = 0;      // first PxlObject block of the current region
+    size_t instance_offset = 0;     // packed models of the current region
+    GLsync fences[PXL_UNIFORM_RING_FRAMES] = {};
+
+    u64_t stalls = 0;               // times the CPU had to wait on a fence
+
+public:
+    GL41UniformRing(GL41StateCache& state);
+    ~GL41UniformRing();
+
+    GL41UniformRing(const GL41UniformRing&) = delete;
+    GL41UniformRing& operator=(const GL41UniformRing&) = delete;
+
+    // Needs a current context, upload() calls it on first use
+    void init(size_t bytes_per_frame = PXL_UNIFORM_RING_FRAME_BYTES);
+    void cleanup();
+
+    // Waits for this frame's region and writes the log's constants into it.
+    // Returns the bytes written
+    size_t upload(const RenderCommandLog& log);
+
+    void bind_frame();
+    void bind_material(u32_t material_index);
+    void bind_object(u32_t object_index);
+
+    // Points the mat4 attribute at `location` (takes location..location+3) of the
+    // bound VAO at the packed models, starting at `first_object`
+    void bind_instances(u32_t first_object, s32_t location);
+
+    // Fences the region and moves on to the next one
+    void end_frame();
+
+    u64_t get_stalls() const { return stalls; }
+    bool is_persistent() const { return persistent; }
+
+private:
+
+    void create(size_t bytes_per_frame);
+    void destroy();
+    void wait(u32_t frame);
+
+};
+
+#endif
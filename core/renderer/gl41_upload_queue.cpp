@@ -0,0 +1,307 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "gl41_upload_queue.h"
+
+#include "core/thread/pxl_job_system.h"
+#include "core/debug/pxl_profiler.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+GL41UploadQueue::GL41UploadQueue(GL41StateCache& state) : state(state) {
+
+}
+
+GL41UploadQueue::~GL41UploadQueue() {
+    cleanup();
+}
+
+void GL41UploadQueue::init(size_t ring_bytes) {
+    capacity = align_up(ring_bytes, PXL_STAGING_ALIGNMENT);
+    head = used = 0;
+
+    persistent = GLAD_GL_VERSION_4_4 != 0;
+
+    if(persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glGenBuffers(1, &buffer);
+        state.bind_buffer(GL_COPY_READ_BUFFER, buffer);
+        glBufferStorage(GL_COPY_READ_BUFFER, capacity, nullptr, flags);
+        mapped = (u8_t*)glMapBufferRange(GL_COPY_READ_BUFFER, 0, capacity, flags);
+
+        if(!mapped) {
+            WRN("Persistent staging ring mapping failed, staging in CPU memory");
+            state.forget_buffer(buffer);
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+            persistent = false;
+        }
+    }
+
+    if(!persistent) memory.resize(capacity);
+
+    LOG("Staging ring: %llu KB (%s)", (u64_t)(capacity / 1024),
+        persistent ? "persistent" : "cpu memory");
+}
+
+void GL41UploadQueue::cleanup() {
+    // Workers may still be writing into the ring or reading the meshes
+    for(auto& upload : uploads) {
+        if(!upload->staging) continue;
+        while(!upload->decoded.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+    uploads.clear();
+
+    for(StagingFence& fence : fences) glDeleteSync(fence.sync);
+    fences.clear();
+
+    if(buffer) {
+        state.bind_buffer(GL_COPY_READ_BUFFER, buffer);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+        state.forget_buffer(buffer);
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+
+    mapped = nullptr;
+    std::vector<u8_t>().swap(memory);
+    capacity = head = used = 0;
+}
+
+void GL41UploadQueue::queue(Mesh& mesh, GL41MeshPool* pool) {
+    auto upload = std::make_unique<Upload>();
+    upload->mesh = &mesh;
+    upload->pool = pool;
+    upload->vertex_bytes = mesh.get_vertex_count() * mesh.get_layout().stride;
+    upload->index_bytes = mesh.indices.size() * mesh.get_index_size();
+
+    mesh.resident = false;
+    uploads.push_back(std::move(upload));
+}
+
+void GL41UploadQueue::cancel(const Mesh& mesh) {
+    for(auto it = uploads.begin(); it != uploads.end(); ++it) {
+        Upload& upload = **it;
+        if(upload.mesh != &mesh) continue;
+
+        // Not in the ring yet, nothing depends on it
+        if(!upload.staging) {
+            uploads.erase(it);
+            return;
+        }
+
+        while(!upload.decoded.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        upload.mesh = nullptr;
+        return;
+    }
+}
+
+GL41UploadStats GL41UploadQueue::update(size_t budget) {
+    PXL_PROFILE_FUNCTION();
+
+    GL41UploadStats stats;
+    if(uploads.empty() && fences.empty()) return stats;
+
+    if(!capacity) init();
+
+    retire();
+
+    // Stage as far ahead as the ring allows, the workers decode while we copy
+    for(auto& upload : uploads) {
+        if(upload->staging) continue;
+
+        size_t size = upload->vertex_bytes + upload->index_bytes;
+        if(size > capacity) {
+            upload->own.resize(size);
+            upload->staging = upload->own.data();
+        } else if(reserve(size, upload->staging_offset, upload->ring_bytes)) {
+            upload->staging = (mapped ? mapped : memory.data()) + upload->staging_offset;
+        } else {
+            // In order, the ring frees front to back
+            stats.ring_full++;
+            break;
+        }
+
+        stage(*upload);
+    }
+
+    size_t ring_done = 0;
+
+    while(!uploads.empty() && budget > 0) {
+        Upload& upload = *uploads.front();
+        if(!upload.staging || !upload.decoded.load(std::memory_order_acquire)) break;
+
+        if(!upload.mesh) {
+            ring_done += upload.ring_bytes;
+            uploads.pop_front();
+            continue;
+        }
+
+        size_t total = upload.vertex_bytes + upload.index_bytes;
+        size_t end = std::min(total, upload.copied + budget);
+
+        copy(upload, upload.copied, end);
+
+        budget -= end - upload.copied;
+        stats.bytes += end - upload.copied;
+        upload.copied = end;
+
+        if(upload.copied < total) break;
+
+        Mesh& mesh = *upload.mesh;
+        mesh.resident = true;
+        if(!mesh.keep_cpu_data) mesh.release_cpu_data();
+
+        ring_done += upload.ring_bytes;
+        stats.completed++;
+        uploads.pop_front();
+    }
+
+    if(ring_done) {
+        if(persistent)
+            fences.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), ring_done });
+        else
+            used -= ring_done;
+    }
+
+    stats.pending = uploads.size();
+    return stats;
+}
+
+// `size` contiguous bytes at the head, skipping the rest of the buffer when it
+// doesn't fit before the end (that bit frees together with this upload)
+bool GL41UploadQueue::reserve(size_t size, size_t& offset, size_t& ring_bytes) {
+    size = align_up(size, PXL_STAGING_ALIGNMENT);
+
+    offset = head;
+    size_t skipped = 0;
+    if(offset + size > capacity) {
+        skipped = capacity - offset;
+        offset = 0;
+    }
+
+    if(used + skipped + size > capacity) return false;
+
+    head = offset + size;
+    used += skipped + size;
+    ring_bytes = skipped + size;
+
+    return true;
+}
+
+void GL41UploadQueue::stage(Upload& upload) {
+    Upload* target = &upload;
+
+    // The mesh isn't touched on the GL thread until `decoded` is set
+    pxl::jobs::submit([target]() {
+        const Mesh& mesh = *target->mesh;
+
+        std::memcpy(target->staging, mesh.get_vertex_data(), target->vertex_bytes);
+
+        u8_t* indices = target->staging + target->vertex_bytes;
+        if(mesh.index_type == IndexType::U16) {
+            u16_t* out = (u16_t*)indices;
+            for(size_t i = 0; i < mesh.indices.size(); i++) out[i] = (u16_t)mesh.indices[i];
+        } else {
+            std::memcpy(indices, mesh.indices.data(), target->index_bytes);
+        }
+
+        target->decoded.store(true, std::memory_order_release);
+    });
+}
+
+// Staging holds the vertices then the indices, [begin, end) can span both
+void GL41UploadQueue::copy(Upload& upload, size_t begin, size_t end) {
+    const Mesh& mesh = *upload.mesh;
+
+    // Resolved now, a pool may have grown (new buffers) since queue()
+    u32_t vbo = mesh.vbo;
+    u32_t ebo = mesh.ebo;
+    size_t vertex_offset = 0;
+    size_t index_offset = 0;
+
+    if(upload.pool) {
+        vbo = upload.pool->get_vbo();
+        ebo = upload.pool->get_ebo();
+        vertex_offset = (size_t)mesh.base_vertex * upload.pool->get_layout().stride;
+        index_offset = (size_t)mesh.first_index * mesh.get_index_size();
+    }
+
+    if(begin < upload.vertex_bytes) {
+        size_t part_end = std::min(end, upload.vertex_bytes);
+        copy_part(vbo, vertex_offset + begin, upload, begin, part_end - begin);
+    }
+
+    if(end > upload.vertex_bytes) {
+        size_t part_begin = std::max(begin, upload.vertex_bytes);
+        copy_part(ebo, index_offset + part_begin - upload.vertex_bytes, upload,
+            part_begin, end - part_begin);
+    }
+}
+
+void GL41UploadQueue::copy_part(u32_t target, size_t target_offset, const Upload& upload, size_t source, size_t size) {
+    state.bind_buffer(GL_COPY_WRITE_BUFFER, target);
+
+    if(persistent && upload.ring_bytes) {
+        state.bind_buffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            upload.staging_offset + source, target_offset, size);
+    } else {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, target_offset, size, upload.staging + source);
+    }
+}
+
+void GL41UploadQueue::retire() {
+    while(!fences.empty()) {
+        StagingFence& fence = fences.front();
+
+        GLenum result = glClientWaitSync(fence.sync, 0, 0);
+        if(result == GL_TIMEOUT_EXPIRED) break;
+        if(result == GL_WAIT_FAILED)
+            ERR("Staging ring fence wait failed");
+
+        glDeleteSync(fence.sync);
+        used -= fence.bytes;
+        fences.pop_front();
+    }
+
+    if(used == 0) head = 0;
+}
@@ -0,0 +1,147 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef GL41_UPLOAD_QUEUE_H
+#define GL41_UPLOAD_QUEUE_H
+
+#include "pxl_renderer_backend.h"
+#include "gl41_state_cache.h"
+#include "gl41_mesh_pool.h"
+
+#include <glad/glad.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+
+#ifndef PXL_STAGING_RING_BYTES
+#define PXL_STAGING_RING_BYTES (16 << 20)
+#endif
+
+#ifndef PXL_STAGING_ALIGNMENT
+#define PXL_STAGING_ALIGNMENT 64
+#endif
+
+struct GL41UploadStats {
+    u64_t bytes = 0;            // copied to the GPU this update
+    u64_t completed = 0;        // meshes that became resident
+    u64_t pending = 0;          // meshes still queued afterwards
+    u64_t ring_full = 0;        // updates that couldn't stage the next mesh
+};
+
+// Streams mesh data to buffers that were created empty (GL41Mesh::create /
+// GL41MeshPool::add with `upload` off) instead of stalling add_mesh() on it.
+//
+// queue() only remembers the mesh. Each update() on the GL thread
+//  - retires staging space whose copies the GPU has finished (fences),
+//  - reserves ring space for queued meshes and hands the decode (vertex copy, u16
+//    index narrowing) to a pxl::jobs task,
+//  - copies decoded data into the real buffers, at most `budget` bytes a frame,
+//    resuming big meshes where the last frame stopped.
+// A mesh turns resident once all of it is copied, GL orders the copies before
+// later draws so nothing waits on the fence but the staging memory.
+//
+// On 4.4+ the ring is a persistently mapped buffer and copies are
+// glCopyBufferSubData, workers write straight into GPU visible memory. On plain
+// 4.1 it's CPU memory and glBufferSubData, the driver takes its copy on the call so
+// the space frees right away. Meshes bigger than the ring decode into memory of
+// their own
+class GL41UploadQueue {
+
+private:
+    struct Upload {
+        Mesh* mesh = nullptr;                   // null once cancelled
+        GL41MeshPool* pool = nullptr;           // null for MeshStorage::SEPARATE
+
+        size_t vertex_bytes = 0;
+        size_t index_bytes = 0;
+        size_t copied = 0;
+
+        u8_t* staging = nullptr;                // null until space is reserved
+        size_t staging_offset = 0;              // into the ring buffer
+        size_t ring_bytes = 0;                  // incl. padding / skipped tail, 0 when not in the ring
+        std::vector<u8_t> own;                  // meshes bigger than the ring
+
+        std::atomic<bool> decoded { false };
+    };
+
+    struct StagingFence {
+        GLsync sync;
+        size_t bytes;
+    };
+
+    GL41StateCache& state;
+
+    u32_t buffer = 0;
+    u8_t* mapped = nullptr;                     // persistent mapping, null on 4.1
+    std::vector<u8_t> memory;                   // the ring on 4.1
+    bool persistent = false;
+
+    size_t capacity = 0;
+    size_t head = 0;
+    size_t used = 0;
+
+    std::deque<std::unique_ptr<Upload>> uploads;
+    std::deque<StagingFence> fences;
+
+public:
+    GL41UploadQueue(GL41StateCache& state);
+    ~GL41UploadQueue();
+
+    GL41UploadQueue(const GL41UploadQueue&) = delete;
+    GL41UploadQueue& operator=(const GL41UploadQueue&) = delete;
+
+    // Needs a current context, update() calls it on first use
+    void init(size_t ring_bytes = PXL_STAGING_RING_BYTES);
+    // Waits for running decodes, queued meshes stay non resident
+    void cleanup();
+
+    // The mesh's buffers / pool ranges have to exist already and it must stay at
+    // the same address until it's resident
+    void queue(Mesh& mesh, GL41MeshPool* pool);
+    // Forgets the mesh's upload so it can go away, waits for its decode if one is
+    // running. Staging space it holds frees in order with the rest
+    void cancel(const Mesh& mesh);
+
+    GL41UploadStats update(size_t budget);
+
+    bool empty() const { return uploads.empty(); }
+    bool is_persistent() const { return persistent; }
+
+private:
+
+    bool reserve(size_t size, size_t& offset, size_t& ring_bytes);
+    void stage(Upload& upload);
+    void copy(Upload& upload, size_t begin, size_t end);
+    void copy_part(u32_t target, size_t target_offset, const Upload& upload, size_t source, size_t size);
+    void retire();
+
+};
+
+#endif
@@ -0,0 +1,264 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "null_renderer.h"
+#include "pxl_culling.h"
+
+#include "misc/utility/generator.h"
+#include "misc/utility/log.h"
+
+NullRenderer::NullRenderer(PXLRenderer* resource_target) :
+    resource_target(resource_target),
+    texture_manager(texture_backend) {
+
+    render_queue.set_texture_manager(&get_texture_manager());
+}
+
+NullRenderer::~NullRenderer() {
+    cleanup();
+}
+
+u64_t NullRenderer::add_mesh(struct Mesh& mesh) {
+    if(mesh.get_vertex_count() == 0) return -1;
+
+    if(mesh.bounds.radius < 0.0f && !mesh.verticies.empty())
+        mesh.bounds = pxl::culling::compute_bounds(mesh.verticies);
+
+    // Only what the queue needs to filter state, cull and count triangles is kept
+    Mesh null_mesh;
+    null_mesh.bounds = mesh.bounds;
+    null_mesh.textures = mesh.textures;
+    null_mesh.vao = 0;
+    null_mesh.vbo = 0;
+    null_mesh.ebo = 0;
+    null_mesh.size = mesh.indices.size();
+    null_mesh.index_type = mesh.fit_index_type();
+
+    null_mesh.position_scale = mesh.position_scale;
+    null_mesh.position_offset = mesh.position_offset;
+
+    null_mesh.lod_count = mesh.lod_count;
+    for(u8_t i = 0; i < mesh.lod_count; i++) null_mesh.lods[i] = mesh.lods[i];
+
+    u64_t mesh_id = resource_target
+        ? resource_target->add_mesh(mesh)
+        : Generator::generate_id();
+
+    if(mesh_id == (u64_t)-1) return mesh_id;
+
+    auto it = null_meshes.emplace(mesh_id, std::move(null_mesh)).first;
+    render_queue.register_mesh(mesh_id, &it->second);
+
+    return mesh_id;
+}
+
+void NullRenderer::remove_mesh(u64_t mesh_id) {
+    auto it = null_meshes.find(mesh_id);
+    if(it == null_meshes.end()) return;
+
+    render_queue.unregister_mesh(mesh_id);
+    null_meshes.erase(it);
+
+    if(resource_target) resource_target->remove_mesh(mesh_id);
+}
+
+u64_t NullRenderer::add_shader(struct Shader& shader) {
+    if(!shader.vertex || !shader.fragment) return -1;
+
+    u64_t shader_id = resource_target
+        ? resource_target->add_shader(shader)
+        : Generator::generate_id();
+
+    if(shader_id == (u64_t)-1) return shader_id;
+
+    null_shaders.insert(shader_id);
+    render_queue.register_shader(shader_id);
+
+    return shader_id;
+}
+
+// Nothing compiles here, a variant is just another id for the queue to sort by
+u64_t NullRenderer::add_shader_variant(u64_t shader_id, const char* keywords, bool precompile) {
+    if(!null_shaders.count(shader_id)) return -1;
+
+    u64_t variant_id = resource_target
+        ? resource_target->add_shader_variant(shader_id, keywords, precompile)
+        : Generator::generate_id();
+
+    if(variant_id == (u64_t)-1) return variant_id;
+
+    if(null_shaders.insert(variant_id).second)
+        render_queue.register_shader(variant_id);
+
+    return variant_id;
+}
+
+u64_t NullRenderer::add_material(const struct Material& material) {
+    u64_t existing = render_queue.find_material(material);
+    if(existing) return existing;
+
+    u64_t material_id = resource_target
+        ? resource_target->add_material(material)
+        : Generator::generate_id();
+
+    if(material_id == (u64_t)-1) return material_id;
+    if(!render_queue.register_material(material_id, material)) return -1;
+
+    return material_id;
+}
+
+void NullRenderer::set_camera(const struct Camera& camera) {
+    render_queue.set_camera(camera);
+}
+
+u32_t NullRenderer::load_texture(const char* path, const SamplerDesc& sampler) {
+    return resource_target
+        ? resource_target->load_texture(path, sampler)
+        : texture_manager.load(path, sampler);
+}
+
+// Nothing here is worth watching without a target, shaders are only ids
+void NullRenderer::set_hot_reload(bool enabled) {
+    if(resource_target) resource_target->set_hot_reload(enabled);
+}
+
+void NullRenderer::reload(const char* path) {
+    if(resource_target) resource_target->reload(path);
+    else texture_manager.reload(path);
+}
+
+TextureManager& NullRenderer::get_texture_manager() {
+    return resource_target ? resource_target->get_texture_manager() : texture_manager;
+}
+
+void NullRenderer::submit_draw_call(const struct DrawCall& draw_call) {
+    render_queue.submit(draw_call);
+}
+
+void NullRenderer::draw() {
+    frame_stats = {};
+    frame_stats.frames = 1;
+
+    // The target's draw() / replay() updates its own
+    if(!resource_target) {
+        TextureStats texture_stats = texture_manager.update();
+
+        frame_stats.texture_bytes = texture_stats.resident_bytes;
+        frame_stats.texture_upload_bytes = texture_stats.upload_bytes;
+        frame_stats.texture_evicted_bytes = texture_stats.evicted_bytes;
+        frame_stats.textures_streaming = texture_stats.streaming;
+    }
+
+    render_queue.build(frame_log, frame_stats);
+    render_queue.clear();
+
+    if(capturing)
+        capture_log.append(frame_log);
+
+    stats.accumulate(frame_stats);
+}
+
+void NullRenderer::reset_stats() {
+    stats = {};
+    frame_stats = {};
+}
+
+void NullRenderer::begin_capture() {
+    capture_log.reset();
+    capturing = true;
+}
+
+const RenderCommandLog& NullRenderer::end_capture() {
+    capturing = false;
+    return capture_log;
+}
+
+void NullRenderer::cleanup() {
+    null_shaders.clear();
+    null_meshes.clear();
+    render_queue.reset();
+    frame_log.reset();
+    capture_log.reset();
+    capturing = false;
+    texture_manager.cleanup();
+}
+
+u32_t NullTextureBackend::create_texture() {
+    u32_t texture = next_texture++;
+    textures[texture];
+    return texture;
+}
+
+void NullTextureBackend::destroy_texture(u32_t texture) {
+    auto it = textures.find(texture);
+    if(it == textures.end()) return;
+
+    for(size_t level_bytes : it->second) bytes -= level_bytes;
+    textures.erase(it);
+}
+
+void NullTextureBackend::upload_level(u32_t texture, TextureFormat format, u8_t level,
+    u32_t width, u32_t height, const void* data, size_t level_bytes) {
+    (void)format; (void)width; (void)height; (void)data;
+
+    auto it = textures.find(texture);
+    if(it == textures.end()) return;
+
+    std::vector<size_t>& levels = it->second;
+    if(levels.size() <= level) levels.resize(level + 1, 0);
+
+    bytes += level_bytes - levels[level];
+    levels[level] = level_bytes;
+    uploads++;
+}
+
+void NullTextureBackend::release_level(u32_t texture, TextureFormat format, u8_t level) {
+    (void)format;
+
+    auto it = textures.find(texture);
+    if(it == textures.end() || it->second.size() <= level) return;
+
+    bytes -= it->second[level];
+    it->second[level] = 0;
+}
+
+void NullTextureBackend::set_level_range(u32_t texture, u8_t base, u8_t max) {
+    (void)texture; (void)base; (void)max;
+}
+
+u32_t NullTextureBackend::create_sampler(const SamplerDesc& sampler) {
+    (void)sampler;
+
+    u32_t name = next_sampler++;
+    samplers.insert(name);
+    return name;
+}
+
+void NullTextureBackend::destroy_sampler(u32_t sampler) {
+    samplers.erase(sampler);
+}
@@ -0,0 +1,127 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef NULL_RENDERER_H
+#define NULL_RENDERER_H
+
+#include "pxl_renderer.h"
+#include "pxl_render_queue.h"
+
+// Fake TextureBackend: hands out names and keeps count of what the levels would
+// take on a GPU. Drives the TextureManager headless (and in tests) with the same
+// residency decisions the GL backend gets
+class NullTextureBackend : public TextureBackend {
+
+private:
+    u32_t next_texture = 1;
+    u32_t next_sampler = 1;
+
+    std::unordered_map<u32_t, std::vector<size_t>> textures;   // bytes per level
+    std::unordered_set<u32_t> samplers;
+    u64_t bytes = 0;
+    u64_t uploads = 0;
+
+public:
+    u32_t create_texture() override;
+    void destroy_texture(u32_t texture) override;
+
+    bool supports(TextureFormat format) const override { (void)format; return true; }
+
+    void upload_level(u32_t texture, TextureFormat format, u8_t level,
+        u32_t width, u32_t height, const void* data, size_t bytes) override;
+    void release_level(u32_t texture, TextureFormat format, u8_t level) override;
+    void set_level_range(u32_t texture, u8_t base, u8_t max) override;
+
+    u32_t create_sampler(const SamplerDesc& sampler) override;
+    void destroy_sampler(u32_t sampler) override;
+
+    u64_t get_bytes() const { return bytes; }
+    u64_t get_uploads() const { return uploads; }
+    size_t get_texture_count() const { return textures.size(); }
+    size_t get_sampler_count() const { return samplers.size(); }
+};
+
+// Headless / recording backend: goes through the same RenderQueue submission path
+// as GL41Renderer but keeps the resulting command log instead of executing it,
+// no GL context needed :D*
+//
+// Pass a resource target (a GL41Renderer) to have meshes and shaders created there
+// too, the recorded ids then match and the log can be replayed into it later.
+// Textures then live in the target's manager, fed with this queue's usage.
+class NullRenderer : public PXLRenderer {
+
+private:
+
+    PXLRenderer* resource_target = nullptr;
+
+    std::unordered_set<u64_t> null_shaders;
+    std::unordered_map<u64_t, Mesh> null_meshes;
+
+    RenderQueue render_queue;
+    RenderCommandLog frame_log;
+
+    NullTextureBackend texture_backend;
+    TextureManager texture_manager;
+    RenderCommandLog capture_log;
+    bool capturing = false;
+
+    RenderStats stats;
+    RenderStats frame_stats;
+
+public:
+    NullRenderer(PXLRenderer* resource_target = nullptr);
+    ~NullRenderer();
+
+    u64_t add_mesh(struct Mesh& mesh) override;
+    void remove_mesh(u64_t mesh_id) override;
+    u64_t add_shader(struct Shader& shader) override;
+    u64_t add_shader_variant(u64_t shader_id, const char* keywords, bool precompile = true) override;
+    u64_t add_material(const struct Material& material) override;
+    void set_camera(const struct Camera& camera) override;
+    u32_t load_texture(const char* path, const SamplerDesc& sampler = SamplerDesc()) override;
+    TextureManager& get_texture_manager() override;
+    void set_hot_reload(bool enabled) override;
+    void reload(const char* path) override;
+    void submit_draw_call(const struct DrawCall& draw_call) override;
+    void draw() override;
+    void cleanup() override;
+
+    const RenderStats& get_frame_stats() const override { return frame_stats; }
+    const RenderStats& get_stats() const { return stats; }
+    void reset_stats();
+
+    // Last frame's commands
+    const RenderCommandLog& get_command_log() const { return frame_log; }
+
+    // Every frame between begin and end appended into one log
+    void begin_capture();
+    const RenderCommandLog& end_capture();
+
+};
+
+#endif
@@ -0,0 +1,81 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_command_buffer.h"
+
+#include "core/memory/pxl_memory.h"
+
+CommandBuffer::CommandBuffer(std::thread::id owner) : owner(owner) {
+
+}
+
+CommandBuffer::~CommandBuffer() {
+    release();
+}
+
+DrawRecord* CommandBuffer::allocate() {
+    if(current < chunks.size() && chunks[current].used == RECORDS_PER_CHUNK)
+        current++;
+
+    if(current == chunks.size()) {
+        u8_t* memory = (u8_t*)os_alloc(RECORDS_PER_CHUNK * sizeof(DrawRecord));
+        if(!memory) return nullptr;
+        chunks.push_back({ memory, 0 });
+    }
+
+    Chunk& chunk = chunks[current];
+    DrawRecord* record = (DrawRecord*)chunk.memory + chunk.used;
+
+    chunk.used++;
+    count++;
+
+    return record;
+}
+
+void CommandBuffer::clear() {
+    for(auto& chunk : chunks) chunk.used = 0;
+    current = 0;
+    count = 0;
+}
+
+void CommandBuffer::release() {
+    for(auto& chunk : chunks)
+        os_free(chunk.memory, RECORDS_PER_CHUNK * sizeof(DrawRecord));
+
+    chunks.clear();
+    current = 0;
+    count = 0;
+}
+
+void CommandBuffer::gather(std::vector<const DrawRecord*>& out) const {
+    for(const auto& chunk : chunks) {
+        const DrawRecord* records = (const DrawRecord*)chunk.memory;
+        for(size_t i = 0; i < chunk.used; i++)
+            out.push_back(records + i);
+    }
+}
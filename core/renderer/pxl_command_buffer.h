@@ -0,0 +1,92 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_COMMAND_BUFFER_H
+#define PXL_COMMAND_BUFFER_H
+
+#include "pxl_renderer_backend.h"
+
+#include <thread>
+#include <type_traits>
+
+#ifndef PXL_COMMAND_CHUNK_BYTES
+#define PXL_COMMAND_CHUNK_BYTES (256 * 1024)
+#endif
+
+static_assert(std::is_trivially_copyable<DrawCall>::value,
+    "DrawCall is recorded with plain copies, keep it POD");
+
+// What a recording thread writes per draw, slots are resolved while recording so
+// the merge is just collecting pointers
+struct DrawRecord {
+    struct DrawCall call;
+    u32_t mesh_slot;
+    u32_t shader_slot;
+    u32_t material_slot;        // 0 = no material, else slot + 1
+};
+
+// Linear per thread storage for one frame of draws. Records are bump allocated
+// from fixed chunks straight from the OS and never move, clear() keeps the chunks
+// around so a steady frame doesn't allocate at all :)*
+class CommandBuffer {
+
+private:
+    struct Chunk {
+        u8_t* memory;
+        size_t used;
+    };
+
+    static constexpr size_t RECORDS_PER_CHUNK = PXL_COMMAND_CHUNK_BYTES / sizeof(DrawRecord);
+
+    std::vector<Chunk> chunks;
+    size_t current = 0;
+    size_t count = 0;
+
+    std::thread::id owner;
+
+public:
+    explicit CommandBuffer(std::thread::id owner);
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    DrawRecord* allocate();
+
+    void clear();
+    void release();
+
+    // Appends a pointer per record, in recording order
+    void gather(std::vector<const DrawRecord*>& out) const;
+
+    size_t size() const { return count; }
+    std::thread::id get_owner() const { return owner; }
+
+};
+
+#endif
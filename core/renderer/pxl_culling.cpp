@@ -0,0 +1,289 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_culling.h"
+
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PXL_CULLING_SSE
+    #include <immintrin.h>
+#endif
+
+// GCC / Clang can build an AVX version next to the SSE one and pick at runtime
+#if defined(PXL_CULLING_SSE) && (defined(__GNUC__) || defined(__clang__))
+    #define PXL_CULLING_AVX
+    #define PXL_TARGET_AVX __attribute__((target("avx")))
+#endif
+
+namespace pxl {
+namespace culling {
+
+    Frustum extract_frustum(const glm::mat4& m) {
+        // glm is column major, row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+        auto row = [&](s32_t i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+
+        Frustum frustum;
+        frustum.planes[0] = row(3) + row(0);
+        frustum.planes[1] = row(3) - row(0);
+        frustum.planes[2] = row(3) + row(1);
+        frustum.planes[3] = row(3) - row(1);
+        frustum.planes[4] = row(3) + row(2);
+        frustum.planes[5] = row(3) - row(2);
+
+        for(auto& plane : frustum.planes) {
+            f32_t length = glm::length(glm::vec3(plane));
+            if(length > 0.0f) plane /= length;
+        }
+
+        return frustum;
+    }
+
+    Bounds compute_bounds(const std::vector<Vertex>& vertices) {
+        Bounds bounds;
+        if(vertices.empty()) return bounds;
+
+        bounds.min = glm::vec3(FLT_MAX);
+        bounds.max = glm::vec3(-FLT_MAX);
+
+        for(const Vertex& vertex : vertices) {
+            glm::vec3 position(vertex.x, vertex.y, vertex.z);
+            bounds.min = glm::min(bounds.min, position);
+            bounds.max = glm::max(bounds.max, position);
+        }
+
+        // Centered on the box, radius from the furthest vertex (tighter than the half diagonal)
+        bounds.center = (bounds.min + bounds.max) * 0.5f;
+
+        f32_t radius_squared = 0.0f;
+        for(const Vertex& vertex : vertices) {
+            glm::vec3 offset = glm::vec3(vertex.x, vertex.y, vertex.z) - bounds.center;
+            radius_squared = std::max(radius_squared, glm::dot(offset, offset));
+        }
+
+        bounds.radius = std::sqrt(radius_squared);
+        return bounds;
+    }
+
+    glm::vec4 transform_sphere(const Bounds& bounds, const glm::mat4& transform) {
+        if(bounds.radius < 0.0f)
+            return glm::vec4(glm::vec3(transform[3]), INFINITY);
+
+        glm::vec3 center = glm::vec3(transform * glm::vec4(bounds.center, 1.0f));
+
+        f32_t scale_squared = std::max(
+            glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+            std::max(
+                glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))));
+
+        return glm::vec4(center, bounds.radius * std::sqrt(scale_squared));
+    }
+
+    u8_t select_lod(
+        const Mesh& mesh, const glm::vec4& world_sphere, const glm::vec3& eye,
+        f32_t projection_scale, f32_t max_error, f32_t hysteresis, u8_t previous
+    ) {
+        if(mesh.lod_count < 2 || projection_scale <= 0.0f) return 0;
+        if(mesh.bounds.radius <= 0.0f || std::isinf(world_sphere.w)) return 0;
+
+        // Camera inside the bounds, nothing to save
+        f32_t distance = glm::length(glm::vec3(world_sphere) - eye) - world_sphere.w;
+        if(distance <= 0.0f) return 0;
+
+        // Object space error -> fraction of the screen height
+        f32_t world_scale = world_sphere.w / mesh.bounds.radius;
+        f32_t to_screen = world_scale * projection_scale * 0.5f / distance;
+
+        if(previous == PXL_LOD_NONE) hysteresis = 0.0f;
+
+        u8_t lod = 0;
+        for(u8_t i = 1; i < mesh.lod_count; i++) {
+            f32_t limit = max_error * (i <= previous ? 1.0f + hysteresis : 1.0f - hysteresis);
+            if(mesh.lods[i].error * to_screen > limit) break;
+            lod = i;
+        }
+
+        return lod;
+    }
+
+    f32_t screen_size(const glm::vec4& world_sphere, const glm::vec3& eye, f32_t projection_scale) {
+        f32_t distance = glm::length(glm::vec3(world_sphere) - eye);
+        if(distance <= world_sphere.w) return INFINITY;
+
+        return world_sphere.w * projection_scale / distance;
+    }
+
+    static u32_t cull_scalar(
+        const Frustum& frustum,
+        const f32_t* x, const f32_t* y, const f32_t* z, const f32_t* radius,
+        u32_t begin, u32_t count, u8_t* visible
+    ) {
+        u32_t total = 0;
+
+        for(u32_t i = begin; i < count; i++) {
+            bool inside = true;
+            for(const auto& plane : frustum.planes) {
+                f32_t distance = plane.x * x[i] + plane.y * y[i] + plane.z * z[i] + plane.w;
+                if(distance < -radius[i]) { inside = false; break; }
+            }
+
+            visible[i] = inside;
+            total += inside;
+        }
+
+        return total;
+    }
+
+#ifdef PXL_CULLING_SSE
+    static u32_t cull_sse(
+        const Frustum& frustum,
+        const f32_t* x, const f32_t* y, const f32_t* z, const f32_t* radius,
+        u32_t count, u8_t* visible
+    ) {
+        __m128 plane_x[6], plane_y[6], plane_z[6], plane_w[6];
+        for(s32_t p = 0; p < 6; p++) {
+            plane_x[p] = _mm_set1_ps(frustum.planes[p].x);
+            plane_y[p] = _mm_set1_ps(frustum.planes[p].y);
+            plane_z[p] = _mm_set1_ps(frustum.planes[p].z);
+            plane_w[p] = _mm_set1_ps(frustum.planes[p].w);
+        }
+
+        const __m128 sign = _mm_set1_ps(-0.0f);
+
+        u32_t total = 0;
+        u32_t i = 0;
+
+        for(; i + 4 <= count; i += 4) {
+            __m128 sx = _mm_loadu_ps(x + i);
+            __m128 sy = _mm_loadu_ps(y + i);
+            __m128 sz = _mm_loadu_ps(z + i);
+            __m128 negative_radius = _mm_xor_ps(_mm_loadu_ps(radius + i), sign);
+
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for(s32_t p = 0; p < 6; p++) {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(plane_x[p], sx), _mm_mul_ps(plane_y[p], sy)),
+                    _mm_add_ps(_mm_mul_ps(plane_z[p], sz), plane_w[p]));
+
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negative_radius));
+            }
+
+            s32_t mask = _mm_movemask_ps(inside);
+            for(s32_t lane = 0; lane < 4; lane++) {
+                visible[i + lane] = (mask >> lane) & 1;
+                total += visible[i + lane];
+            }
+        }
+
+        return total + cull_scalar(frustum, x, y, z, radius, i, count, visible);
+    }
+#endif
+
+#ifdef PXL_CULLING_AVX
+    PXL_TARGET_AVX
+    static u32_t cull_avx(
+        const Frustum& frustum,
+        const f32_t* x, const f32_t* y, const f32_t* z, const f32_t* radius,
+        u32_t count, u8_t* visible
+    ) {
+        __m256 plane_x[6], plane_y[6], plane_z[6], plane_w[6];
+        for(s32_t p = 0; p < 6; p++) {
+            plane_x[p] = _mm256_set1_ps(frustum.planes[p].x);
+            plane_y[p] = _mm256_set1_ps(frustum.planes[p].y);
+            plane_z[p] = _mm256_set1_ps(frustum.planes[p].z);
+            plane_w[p] = _mm256_set1_ps(frustum.planes[p].w);
+        }
+
+        const __m256 sign = _mm256_set1_ps(-0.0f);
+
+        u32_t total = 0;
+        u32_t i = 0;
+
+        for(; i + 8 <= count; i += 8) {
+            __m256 sx = _mm256_loadu_ps(x + i);
+            __m256 sy = _mm256_loadu_ps(y + i);
+            __m256 sz = _mm256_loadu_ps(z + i);
+            __m256 negative_radius = _mm256_xor_ps(_mm256_loadu_ps(radius + i), sign);
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for(s32_t p = 0; p < 6; p++) {
+                __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(plane_x[p], sx), _mm256_mul_ps(plane_y[p], sy)),
+                    _mm256_add_ps(_mm256_mul_ps(plane_z[p], sz), plane_w[p]));
+
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negative_radius, _CMP_GE_OQ));
+            }
+
+            s32_t mask = _mm256_movemask_ps(inside);
+            for(s32_t lane = 0; lane < 8; lane++) {
+                visible[i + lane] = (mask >> lane) & 1;
+                total += visible[i + lane];
+            }
+        }
+
+        return total + cull_scalar(frustum, x, y, z, radius, i, count, visible);
+    }
+
+    static bool has_avx() {
+        static const bool supported = __builtin_cpu_supports("avx");
+        return supported;
+    }
+#endif
+
+    u32_t cull_spheres(
+        const Frustum& frustum,
+        const f32_t* x, const f32_t* y, const f32_t* z, const f32_t* radius,
+        u32_t count, u8_t* visible
+    ) {
+#ifdef PXL_CULLING_AVX
+        if(has_avx()) return cull_avx(frustum, x, y, z, radius, count, visible);
+#endif
+#ifdef PXL_CULLING_SSE
+        return cull_sse(frustum, x, y, z, radius, count, visible);
+#else
+        return cull_scalar(frustum, x, y, z, radius, 0, count, visible);
+#endif
+    }
+
+    const char* get_simd_path() {
+#ifdef PXL_CULLING_AVX
+        if(has_avx()) return "avx";
+#endif
+#ifdef PXL_CULLING_SSE
+        return "sse";
+#else
+        return "scalar";
+#endif
+    }
+
+};
+};
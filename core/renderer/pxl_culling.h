@@ -0,0 +1,80 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_CULLING_H
+#define PXL_CULLING_H
+
+#include "pxl_renderer_backend.h"
+
+// Frustum vs bounding sphere tests on SoA arrays. The world space spheres are laid
+// out as separate x / y / z / radius streams so one SSE (4) or AVX (8) compare tests
+// that many objects against a plane at once. AVX is picked at runtime when the CPU
+// has it, no build flags needed :D*
+
+namespace pxl {
+namespace culling {
+
+    struct Frustum {
+        glm::vec4 planes[6];    // xyz normal pointing inwards, w distance. left, right, bottom, top, near, far
+    };
+
+    // Gribb / Hartmann, planes normalized so distances are in world units
+    Frustum extract_frustum(const glm::mat4& view_projection);
+
+    Bounds compute_bounds(const std::vector<Vertex>& vertices);
+
+    // Object space sphere -> world space, the radius grows with the largest axis scale
+    glm::vec4 transform_sphere(const Bounds& bounds, const glm::mat4& transform);
+
+    // visible[i] = 1 when sphere i touches the frustum. Unknown bounds should be
+    // passed with an infinite radius. Returns the visible count
+    u32_t cull_spheres(
+        const Frustum& frustum,
+        const f32_t* x, const f32_t* y, const f32_t* z, const f32_t* radius,
+        u32_t count, u8_t* visible);
+
+    // Coarsest LOD whose error, projected at the world sphere's distance, stays under
+    // max_error (a fraction of the screen height). A LOD finer than or equal to
+    // `previous` is kept until its error is hysteresis above the limit, a coarser one
+    // is only taken once it's hysteresis below, so objects near a threshold don't
+    // flicker between two levels. previous = PXL_LOD_NONE for no history
+    u8_t select_lod(
+        const Mesh& mesh, const glm::vec4& world_sphere, const glm::vec3& eye,
+        f32_t projection_scale, f32_t max_error, f32_t hysteresis, u8_t previous);
+
+    // How much of the screen height the sphere's diameter covers, infinite with the
+    // eye inside it. projection_scale is Camera::projection_scale
+    f32_t screen_size(const glm::vec4& world_sphere, const glm::vec3& eye, f32_t projection_scale);
+
+    // Which path cull_spheres() takes on this CPU: "avx", "sse" or "scalar"
+    const char* get_simd_path();
+
+};
+};
+
+#endif
@@ -0,0 +1,240 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_RENDER_COMMANDS_H
+#define PXL_RENDER_COMMANDS_H
+
+#include "pxl_renderer_backend.h"
+#include "pxl_std140.h"
+
+#include <algorithm>
+
+// Compact log of the GL calls a frame would make after sorting and state filtering.
+// Built once per frame by the RenderQueue, executed by GL41Renderer, kept by the
+// NullRenderer so it can be inspected or replayed later :)*
+
+enum class RenderCommandType : u8_t {
+    CLEAR,
+    SET_STATE,
+    USE_SHADER,
+    BIND_MATERIAL,
+    BIND_TEXTURE,
+    BIND_MESH,
+    SET_MAT4,
+    BIND_OBJECT,
+    DRAW_MESH,
+    DRAW_INSTANCED,
+    COUNT
+};
+
+struct RenderCommand {
+    RenderCommandType type;
+    u8_t slot;          // texture unit for BIND_TEXTURE, LOD for DRAW_*
+    u16_t reserved;
+    u32_t payload;      // SET_MAT4: matrix, BIND_MATERIAL: material block, BIND_OBJECT: first object, DRAW_*: index count
+    u64_t id;           // state id, shader id, mesh id, texture name, uniform (Interner) id or instance count
+};
+
+static_assert(sizeof(RenderCommand) == 16, "RenderCommand should stay 16 bytes");
+static_assert(PXL_MAX_MATERIAL_PARAMS <= 8, "PxlMaterialConstants holds 8 vec4 params");
+
+class RenderCommandLog {
+
+public:
+    std::vector<RenderCommand> commands;
+    std::vector<glm::mat4> matrices;
+
+    // Constants for the PxlFrame / PxlObject blocks, uploaded in one go before executing
+    PxlFrameConstants frame = {};
+    std::vector<PxlMaterialConstants> materials;    // once per material used this frame
+    std::vector<PxlObjectConstants> objects;
+
+public:
+
+    void clear() {
+        commands.clear();
+        matrices.clear();
+        materials.clear();
+        objects.clear();
+    }
+
+    void reset() {
+        clear();
+        commands.shrink_to_fit();
+        matrices.shrink_to_fit();
+        materials.shrink_to_fit();
+        objects.shrink_to_fit();
+    }
+
+    void reserve(size_t draw_count) {
+        commands.reserve(draw_count * 3);
+        matrices.reserve(draw_count);
+        objects.reserve(draw_count);
+    }
+
+    void push(RenderCommandType type, u64_t id, u32_t payload = 0, u8_t slot = 0) {
+        commands.push_back({ type, slot, 0, payload, id });
+    }
+
+    void push_mat4(u32_t uniform_id, const glm::mat4& value) {
+        push(RenderCommandType::SET_MAT4, uniform_id, (u32_t)matrices.size());
+        matrices.push_back(value);
+    }
+
+    // Binds the next `count` objects, the caller pushes their constants right after
+    void push_objects(u32_t count) {
+        push(RenderCommandType::BIND_OBJECT, count, (u32_t)objects.size());
+    }
+
+    // Appends another log, re-basing its matrix, material and object indices. Frame
+    // constants are kept from this log
+    void append(const RenderCommandLog& other) {
+        u32_t matrix_base = (u32_t)matrices.size();
+        u32_t material_base = (u32_t)materials.size();
+        u32_t object_base = (u32_t)objects.size();
+        matrices.insert(matrices.end(), other.matrices.begin(), other.matrices.end());
+        materials.insert(materials.end(), other.materials.begin(), other.materials.end());
+        objects.insert(objects.end(), other.objects.begin(), other.objects.end());
+
+        for(RenderCommand command : other.commands) {
+            if(command.type == RenderCommandType::SET_MAT4)
+                command.payload += matrix_base;
+            else if(command.type == RenderCommandType::BIND_MATERIAL)
+                command.payload += material_base;
+            else if(command.type == RenderCommandType::BIND_OBJECT)
+                command.payload += object_base;
+            commands.push_back(command);
+        }
+    }
+
+    size_t count(RenderCommandType type) const {
+        size_t total = 0;
+        for(const auto& command : commands)
+            if(command.type == type) total++;
+        return total;
+    }
+
+    size_t size_bytes() const {
+        return commands.size() * sizeof(RenderCommand)
+            + matrices.size() * sizeof(glm::mat4)
+            + materials.size() * sizeof(PxlMaterialConstants)
+            + objects.size() * sizeof(PxlObjectConstants);
+    }
+};
+
+struct RenderStats {
+    u64_t frames = 0;
+    u64_t draw_calls = 0;           // an instanced draw counts once
+    u64_t instances = 0;            // objects drawn, instanced or not
+    u64_t instanced_draws = 0;
+    u64_t multi_draws = 0;          // glMultiDrawElementsIndirect calls (pooled meshes)
+    u64_t culled = 0;               // draws rejected by the frustum test
+    u64_t record_threads = 0;       // threads that recorded draws this frame
+    u64_t triangles = 0;
+    u64_t lod_reduced = 0;          // instances drawn below their finest LOD
+    u64_t triangles_saved = 0;      // vs. drawing every instance at LOD 0
+    u64_t index_bytes = 0;          // index data the draws read
+    u64_t index_bytes_saved = 0;    // vs. u32 indices everywhere
+
+    u64_t shader_changes = 0;
+    u64_t material_changes = 0;
+    u64_t mesh_changes = 0;
+    u64_t texture_changes = 0;
+    u64_t state_changes_fixed = 0;  // SET_STATE commands (blend / depth / cull ...)
+    u64_t redundant_skipped = 0;    // binds filtered out because the state was already set
+
+    u64_t gl_state_calls = 0;           // state calls the GL41StateCache let through
+    u64_t gl_state_calls_avoided = 0;   // and the ones it dropped as redundant
+
+    u64_t uniforms_uploaded = 0;
+    u64_t uniforms_skipped = 0;     // value already in the program, no glUniform* call
+    u64_t uniform_bytes = 0;        // written to the uniform ring
+
+    u64_t upload_bytes = 0;         // mesh data streamed to the GPU
+    u64_t uploads_completed = 0;    // meshes that became resident
+    u64_t uploads_pending = 0;      // still waiting to go up
+
+    u64_t texture_bytes = 0;            // resident mips
+    u64_t texture_upload_bytes = 0;
+    u64_t texture_evicted_bytes = 0;
+    u64_t textures_streaming = 0;       // below the level their screen size asks for
+
+    u64_t shaders_compiling = 0;        // variants started and not linked yet
+    u64_t shader_fallbacks = 0;         // binds that drew a variant with its base shader
+
+    // CPU time per stage
+    f64_t cull_ms = 0.0;
+    f64_t sort_ms = 0.0;
+    f64_t build_ms = 0.0;
+    f64_t execute_ms = 0.0;
+
+    u64_t state_changes() const {
+        return shader_changes + material_changes + mesh_changes + texture_changes + state_changes_fixed;
+    }
+
+    void accumulate(const RenderStats& other) {
+        frames += other.frames;
+        draw_calls += other.draw_calls;
+        instances += other.instances;
+        instanced_draws += other.instanced_draws;
+        multi_draws += other.multi_draws;
+        culled += other.culled;
+        record_threads = std::max(record_threads, other.record_threads);
+        triangles += other.triangles;
+        lod_reduced += other.lod_reduced;
+        triangles_saved += other.triangles_saved;
+        index_bytes += other.index_bytes;
+        index_bytes_saved += other.index_bytes_saved;
+        shader_changes += other.shader_changes;
+        material_changes += other.material_changes;
+        mesh_changes += other.mesh_changes;
+        texture_changes += other.texture_changes;
+        state_changes_fixed += other.state_changes_fixed;
+        redundant_skipped += other.redundant_skipped;
+        gl_state_calls += other.gl_state_calls;
+        gl_state_calls_avoided += other.gl_state_calls_avoided;
+        uniforms_uploaded += other.uniforms_uploaded;
+        uniforms_skipped += other.uniforms_skipped;
+        uniform_bytes += other.uniform_bytes;
+        upload_bytes += other.upload_bytes;
+        uploads_completed += other.uploads_completed;
+        uploads_pending = other.uploads_pending;
+        texture_bytes = other.texture_bytes;
+        texture_upload_bytes += other.texture_upload_bytes;
+        texture_evicted_bytes += other.texture_evicted_bytes;
+        textures_streaming = other.textures_streaming;
+        shaders_compiling = other.shaders_compiling;
+        shader_fallbacks += other.shader_fallbacks;
+        cull_ms += other.cull_ms;
+        sort_ms += other.sort_ms;
+        build_ms += other.build_ms;
+        execute_ms += other.execute_ms;
+    }
+};
+
+#endif
@@ -0,0 +1,668 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_render_queue.h"
+#include "pxl_sort_key.h"
+#include "pxl_culling.h"
+
+#include "core/debug/pxl_profiler.h"
+#include "core/thread/pxl_job_system.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+using render_clock = std::chrono::steady_clock;
+
+static inline f64_t elapsed_ms(render_clock::time_point start) {
+    return std::chrono::duration<f64_t, std::milli>(render_clock::now() - start).count();
+}
+
+static std::atomic<u32_t> global_queue_ids { 1 };
+
+RenderQueue::RenderQueue() : queue_id(global_queue_ids.fetch_add(1)) {
+
+}
+
+void RenderQueue::register_mesh(u64_t mesh_id, const Mesh* mesh) {
+    auto it = mesh_slot_lookup.find(mesh_id);
+    if(it != mesh_slot_lookup.end()) {
+        mesh_slots[it->second] = mesh;
+        return;
+    }
+
+    mesh_slot_lookup.emplace(mesh_id, (u32_t)mesh_slots.size());
+    mesh_slots.push_back(mesh);
+}
+
+void RenderQueue::unregister_mesh(u64_t mesh_id) {
+    auto it = mesh_slot_lookup.find(mesh_id);
+    if(it == mesh_slot_lookup.end()) return;
+
+    mesh_slots[it->second] = nullptr;
+    mesh_slot_lookup.erase(it);
+    meshes_removed = true;
+}
+
+void RenderQueue::register_shader(u64_t shader_id) {
+    if(shader_slots.find(shader_id) != shader_slots.end()) return;
+    shader_slots.emplace(shader_id, (u32_t)shader_slots.size());
+}
+
+// FNV-1a over the used part of the material only, unused slots and padding may hold anything
+static inline u64_t hash_bytes(u64_t hash, const void* data, size_t size) {
+    const u8_t* bytes = (const u8_t*)data;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+u64_t RenderQueue::hash_material(const Material& material) {
+    u64_t hash = 0xcbf29ce484222325ull;
+    hash = hash_bytes(hash, &material.shader_id, sizeof(material.shader_id));
+    hash = hash_bytes(hash, &material.render_state, sizeof(material.render_state));
+    hash = hash_bytes(hash, &material.texture_count, sizeof(material.texture_count));
+    hash = hash_bytes(hash, material.textures, material.texture_count * sizeof(u32_t));
+    hash = hash_bytes(hash, &material.param_count, sizeof(material.param_count));
+    hash = hash_bytes(hash, material.params, material.param_count * sizeof(glm::vec4));
+    return hash;
+}
+
+// Params compare bitwise, same as they hash
+bool RenderQueue::same_material(const Material& a, const Material& b) {
+    if(a.shader_id != b.shader_id || a.render_state != b.render_state) return false;
+    if(a.texture_count != b.texture_count || a.param_count != b.param_count) return false;
+
+    return std::memcmp(a.textures, b.textures, a.texture_count * sizeof(u32_t)) == 0
+        && std::memcmp(a.params, b.params, a.param_count * sizeof(glm::vec4)) == 0;
+}
+
+u64_t RenderQueue::find_material(const struct Material& material) const {
+    auto range = material_hashes.equal_range(hash_material(material));
+    for(auto it = range.first; it != range.second; ++it) {
+        const MaterialSlot& slot = material_slots[it->second];
+        if(same_material(slot.material, material)) return slot.id;
+    }
+    return 0;
+}
+
+bool RenderQueue::register_material(u64_t material_id, const struct Material& material) {
+    auto it_shader = shader_slots.find(material.shader_id);
+    if(it_shader == shader_slots.end()) {
+        ERR("Material shader not found: %llu", material.shader_id);
+        return false;
+    }
+
+    if(material_slot_lookup.find(material_id) != material_slot_lookup.end()) {
+        ERR("Material already registered: %llu", material_id);
+        return false;
+    }
+
+    MaterialSlot slot = {};
+    slot.material = material;
+    slot.id = material_id;
+    slot.hash = hash_material(material);
+    slot.shader_slot = it_shader->second;
+
+    u32_t index = (u32_t)material_slots.size();
+    material_slots.push_back(slot);
+    material_slot_lookup.emplace(material_id, index);
+    material_hashes.emplace(slot.hash, index);
+    return true;
+}
+
+const Material* RenderQueue::get_material(u64_t material_id) const {
+    auto it = material_slot_lookup.find(material_id);
+    return it != material_slot_lookup.end() ? &material_slots[it->second].material : nullptr;
+}
+
+void RenderQueue::set_camera(const struct Camera& camera) {
+    this->camera = camera;
+    has_camera = true;
+}
+
+void RenderQueue::set_culling(bool enabled) {
+    culling = enabled;
+}
+
+void RenderQueue::set_lod_error(f32_t screen_error) {
+    lod_error = screen_error;
+}
+
+void RenderQueue::set_lod_hysteresis(f32_t hysteresis) {
+    lod_hysteresis = hysteresis;
+}
+
+CommandBuffer* RenderQueue::thread_buffer() {
+    // Queue ids instead of pointers, a new queue could land on a dead one's address
+    struct ThreadBufferCache {
+        u32_t queue_id = 0;
+        CommandBuffer* buffer = nullptr;
+    };
+    static thread_local ThreadBufferCache t_cache;
+
+    if(t_cache.queue_id == queue_id) return t_cache.buffer;
+
+    std::thread::id thread = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+
+    CommandBuffer* buffer = nullptr;
+    for(auto& candidate : buffers) {
+        if(candidate->get_owner() == thread) {
+            buffer = candidate.get();
+            break;
+        }
+    }
+
+    if(!buffer) {
+        buffers.push_back(std::make_unique<CommandBuffer>(thread));
+        buffer = buffers.back().get();
+    }
+
+    t_cache = { queue_id, buffer };
+    return buffer;
+}
+
+void RenderQueue::submit(const struct DrawCall& draw_call) {
+    auto it_mesh = mesh_slot_lookup.find(draw_call.mesh_id);
+    if(it_mesh == mesh_slot_lookup.end()) {
+        ERR("Mesh Not Found: %llu", draw_call.mesh_id);
+        return;
+    }
+
+    // Still streaming in, residency only changes inside the backend's draw()
+    if(!mesh_slots[it_mesh->second]->resident) return;
+
+    const MaterialSlot* material = nullptr;
+    u32_t material_slot = 0;
+    u32_t shader_slot = 0;
+
+    if(draw_call.material_id) {
+        auto it_material = material_slot_lookup.find(draw_call.material_id);
+        if(it_material == material_slot_lookup.end()) {
+            ERR("Material not found: %llu", draw_call.material_id);
+            return;
+        }
+
+        material = &material_slots[it_material->second];
+        material_slot = it_material->second + 1;
+        shader_slot = material->shader_slot;
+    } else {
+        auto it_shader = shader_slots.find(draw_call.shader_id);
+        if(it_shader == shader_slots.end()) {
+            ERR("Shader not found: %llu", draw_call.shader_id);
+            return;
+        }
+
+        shader_slot = it_shader->second;
+    }
+
+    DrawRecord* record = thread_buffer()->allocate();
+    if(!record) {
+        ERR("Out of command buffer memory, draw dropped");
+        return;
+    }
+
+    record->call = draw_call;
+    record->mesh_slot = it_mesh->second;
+    record->shader_slot = shader_slot;
+    record->material_slot = material_slot;
+
+    // Baked into the record so sorting and the build loop don't care where they came from
+    if(material) {
+        record->call.shader_id = material->material.shader_id;
+        record->call.render_state = material->material.render_state;
+    }
+}
+
+// Thread buffers in creation order, so a single threaded frame keeps its submit order
+void RenderQueue::merge() {
+    PXL_PROFILE_SCOPE("RenderQueue::merge");
+
+    records.clear();
+    records.reserve(size());
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for(const auto& buffer : buffers)
+        buffer->gather(records);
+
+    // Recorded before their mesh went away
+    if(meshes_removed) {
+        records.erase(std::remove_if(records.begin(), records.end(), [this](const DrawRecord* record) {
+            return mesh_slots[record->mesh_slot] == nullptr;
+        }), records.end());
+        meshes_removed = false;
+    }
+}
+
+size_t RenderQueue::size() const {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+
+    size_t total = 0;
+    for(const auto& buffer : buffers) total += buffer->size();
+    return total;
+}
+
+u32_t RenderQueue::get_thread_count() const {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+
+    u32_t threads = 0;
+    for(const auto& buffer : buffers) threads += buffer->size() > 0;
+    return threads;
+}
+
+void RenderQueue::cull(RenderStats& stats) {
+    PXL_PROFILE_SCOPE("RenderQueue::cull");
+
+    const u32_t count = (u32_t)records.size();
+    visible.clear();
+    draw_lods.assign(count, 0);
+
+    // Without a camera there's no frustum and no distance to pick LODs by
+    const bool pick_lods = has_camera && camera.projection_scale > 0.0f;
+
+    if(!has_camera || (!culling && !pick_lods)) {
+        visible.resize(count);
+        for(u32_t i = 0; i < count; i++) visible[i] = i;
+        return;
+    }
+
+    auto cull_start = render_clock::now();
+
+    cull_x.resize(count);
+    cull_y.resize(count);
+    cull_z.resize(count);
+    cull_radius.resize(count);
+    cull_visible.resize(count);
+
+    const pxl::culling::Frustum frustum = pxl::culling::extract_frustum(camera.view_projection);
+
+    // World spheres into SoA + the SIMD test, chunked over the job workers for big
+    // scenes. Survivors get their LOD picked right away while the sphere is hot
+    pxl::jobs::parallel_for(count, PXL_CULL_GRAIN, [&](u32_t begin, u32_t end) {
+        for(u32_t i = begin; i < end; i++) {
+            const DrawRecord& record = *records[i];
+            const Mesh& mesh = *mesh_slots[record.mesh_slot];
+            glm::vec4 sphere = pxl::culling::transform_sphere(mesh.bounds, record.call.transform);
+
+            cull_x[i] = sphere.x;
+            cull_y[i] = sphere.y;
+            cull_z[i] = sphere.z;
+            cull_radius[i] = sphere.w;
+        }
+
+        if(culling) {
+            pxl::culling::cull_spheres(
+                frustum,
+                cull_x.data() + begin, cull_y.data() + begin,
+                cull_z.data() + begin, cull_radius.data() + begin,
+                end - begin, cull_visible.data() + begin);
+        } else {
+            std::memset(cull_visible.data() + begin, 1, end - begin);
+        }
+
+        if(!pick_lods) return;
+
+        for(u32_t i = begin; i < end; i++) {
+            if(!cull_visible[i]) continue;
+
+            const DrawRecord& record = *records[i];
+            const Mesh& mesh = *mesh_slots[record.mesh_slot];
+            if(mesh.lod_count < 2) continue;
+
+            // History is only resized on this thread after the jobs, reading is fine
+            u32_t handle = record.call.lod_handle;
+            u8_t previous = handle && handle < lod_history.size() ? lod_history[handle] : PXL_LOD_NONE;
+
+            draw_lods[i] = pxl::culling::select_lod(
+                mesh, glm::vec4(cull_x[i], cull_y[i], cull_z[i], cull_radius[i]),
+                camera.position, camera.projection_scale,
+                lod_error, lod_hysteresis, previous);
+        }
+    });
+
+    for(u32_t i = 0; i < count; i++) {
+        if(!cull_visible[i]) continue;
+        visible.push_back(i);
+
+        if(!pick_lods) continue;
+
+        u32_t handle = records[i]->call.lod_handle;
+        if(!handle) continue;
+
+        if(handle >= lod_history.size()) lod_history.resize(handle + 1, PXL_LOD_NONE);
+        lod_history[handle] = draw_lods[i];
+    }
+
+    stats.culled += count - visible.size();
+    stats.cull_ms += elapsed_ms(cull_start);
+}
+
+void RenderQueue::report_texture_usage() {
+    if(!texture_manager) return;
+
+    PXL_PROFILE_SCOPE("RenderQueue::report_texture_usage");
+
+    // cull() filled the spheres whenever there's a projection to measure them with
+    const bool measure = has_camera && camera.projection_scale > 0.0f;
+
+    mesh_usage.assign(mesh_slots.size(), 0.0f);
+    material_usage.assign(material_slots.size(), 0.0f);
+
+    for(u32_t index : visible) {
+        const DrawRecord& record = *records[index];
+
+        f32_t usage = measure ? pxl::culling::screen_size(
+            glm::vec4(cull_x[index], cull_y[index], cull_z[index], cull_radius[index]),
+            camera.position, camera.projection_scale) : 1.0f;
+
+        f32_t& slot = record.material_slot ? material_usage[record.material_slot - 1] : mesh_usage[record.mesh_slot];
+        slot = std::max(slot, usage);
+    }
+
+    for(size_t i = 0; i < mesh_usage.size(); i++) {
+        if(mesh_usage[i] <= 0.0f) continue;
+        for(u32_t texture : mesh_slots[i]->textures)
+            texture_manager->note_usage(texture, mesh_usage[i]);
+    }
+
+    for(size_t i = 0; i < material_usage.size(); i++) {
+        if(material_usage[i] <= 0.0f) continue;
+        const Material& material = material_slots[i].material;
+        for(u8_t t = 0; t < material.texture_count; t++)
+            texture_manager->note_usage(material.textures[t], material_usage[i]);
+    }
+}
+
+void RenderQueue::build_keys() {
+    const size_t count = visible.size();
+
+    keys.resize(count);
+    order.resize(count);
+    scratch_keys.resize(count);
+    scratch_order.resize(count);
+
+    const f32_t inverse_far = camera.far_plane > 0.0f ? 1.0f / camera.far_plane : 0.0f;
+
+    for(size_t i = 0; i < count; i++) {
+        const u32_t index = visible[i];
+        const DrawCall& call = records[index]->call;
+        const u32_t shader_slot = records[index]->shader_slot;
+        const u32_t mesh_slot = records[index]->mesh_slot;
+
+        // Materials take the material bits, plain draws fall back to their render
+        // state so draws sharing blend / depth state still stay together
+        const u32_t material = records[index]->material_slot
+            ? records[index]->material_slot
+            : call.render_state;
+
+        glm::vec3 offset = glm::vec3(call.transform[3]) - camera.position;
+        u32_t depth = pxl::sort_key::quantize_depth(glm::length(offset) * inverse_far);
+
+        keys[i] = call.translucent
+            ? pxl::sort_key::make_translucent(call.layer, shader_slot, material, mesh_slot, depth)
+            : pxl::sort_key::make_opaque(call.layer, shader_slot, material, mesh_slot, depth);
+
+        order[i] = index;
+    }
+}
+
+void RenderQueue::build(RenderCommandLog& log, RenderStats& stats) {
+    PXL_PROFILE_SCOPE("RenderQueue::build");
+
+    log.clear();
+
+    merge();
+    if(records.empty()) return;
+
+    stats.record_threads = get_thread_count();
+
+    cull(stats);
+    report_texture_usage();
+
+    auto sort_start = render_clock::now();
+
+    {
+        PXL_PROFILE_SCOPE("RenderQueue::sort");
+
+        build_keys();
+        pxl::sort_key::radix_sort(
+            keys.data(), order.data(),
+            scratch_keys.data(), scratch_order.data(),
+            keys.size());
+    }
+
+    stats.sort_ms += elapsed_ms(sort_start);
+
+    auto build_start = render_clock::now();
+
+    log.reserve(visible.size());
+    log.push(RenderCommandType::CLEAR, 0);
+
+    log.frame.view_projection = camera.view_projection;
+    log.frame.camera = glm::vec4(camera.position, camera.far_plane);
+
+    // Material blocks are pushed the first time a material shows up this frame
+    if(++build_stamp == 0) build_stamp = 1;
+
+    u64_t current_shader = 0;
+    u32_t current_material = 0;
+    u32_t current_state = ~0u;
+    u64_t bound_mesh = 0;
+    std::vector<u32_t> bound_textures;
+
+    const size_t count = order.size();
+
+    for(size_t first = 0; first < count;) {
+        const DrawCall& call = records[order[first]]->call;
+        const Mesh& mesh = *mesh_slots[records[order[first]]->mesh_slot];
+        const u32_t material_slot = records[order[first]]->material_slot;
+        const u8_t lod = draw_lods[order[first]];
+
+        // Sorting already put identical mesh/shader pairs next to each other
+        size_t last = first + 1;
+        if(instancing) {
+            while(last < count
+                && draw_lods[order[last]] == lod
+                && can_instance(call, records[order[last]]->call))
+                last++;
+        }
+
+        u32_t instances = (u32_t)(last - first);
+
+        if(current_state != call.render_state) {
+            log.push(RenderCommandType::SET_STATE, call.render_state);
+            current_state = call.render_state;
+            stats.state_changes_fixed++;
+        } else {
+            stats.redundant_skipped++;
+        }
+
+        if(current_shader != call.shader_id) {
+            log.push(RenderCommandType::USE_SHADER, call.shader_id);
+            current_shader = call.shader_id;
+            stats.shader_changes++;
+        } else {
+            stats.redundant_skipped++;
+        }
+
+        const u32_t* textures = mesh.textures.data();
+        size_t texture_count = mesh.textures.size();
+
+        if(material_slot) {
+            MaterialSlot& material = material_slots[material_slot - 1];
+            textures = material.material.textures;
+            texture_count = material.material.texture_count;
+
+            if(current_material != material_slot) {
+                if(material.stamp != build_stamp) {
+                    PxlMaterialConstants constants = {};
+                    for(u8_t i = 0; i < material.material.param_count; i++)
+                        constants.params[i] = material.material.params[i];
+
+                    material.block = (u32_t)log.materials.size();
+                    material.stamp = build_stamp;
+                    log.materials.push_back(constants);
+                }
+
+                log.push(RenderCommandType::BIND_MATERIAL, material.id, material.block);
+                current_material = material_slot;
+                stats.material_changes++;
+            } else {
+                stats.redundant_skipped++;
+            }
+        }
+
+        for(u8_t i = 0; i < call.mat4_uniform_count; i++)
+            log.push_mat4(call.mat4_uniforms[i].id, call.mat4_uniforms[i].value);
+
+        for(size_t i = 0; i < texture_count; ++i) {
+            u32_t texture = textures[i];
+
+            if(i < bound_textures.size() && bound_textures[i] == texture) {
+                stats.redundant_skipped++;
+                continue;
+            }
+
+            log.push(RenderCommandType::BIND_TEXTURE, texture, 0, (u8_t)i);
+            stats.texture_changes++;
+
+            if(i < bound_textures.size())
+                bound_textures[i] = texture;
+            else
+                bound_textures.push_back(texture);
+        }
+
+        if(bound_mesh != call.mesh_id) {
+            log.push(RenderCommandType::BIND_MESH, call.mesh_id);
+            bound_mesh = call.mesh_id;
+            stats.mesh_changes++;
+        } else {
+            stats.redundant_skipped++;
+        }
+
+        // Quantized positions get decoded by the model matrix, shaders never know
+        const bool packed = mesh.position_scale != glm::vec3(1.0f) || mesh.position_offset != glm::vec3(0.0f);
+        glm::mat4 decode = glm::mat4(1.0f);
+        if(packed) {
+            decode[0][0] = mesh.position_scale.x;
+            decode[1][1] = mesh.position_scale.y;
+            decode[2][2] = mesh.position_scale.z;
+            decode[3] = glm::vec4(mesh.position_offset, 1.0f);
+        }
+
+        log.push_objects(instances);
+        for(size_t i = first; i < last; i++) {
+            const glm::mat4& transform = records[order[i]]->call.transform;
+            glm::mat4 model = packed ? transform * decode : transform;
+            log.objects.push_back({ model, camera.view_projection * model });
+        }
+
+        // The slot carries the LOD, the backend finds its index range on the mesh
+        const u32_t index_count = mesh.get_lod_count(lod);
+
+        if(instances > 1) {
+            log.push(RenderCommandType::DRAW_INSTANCED, instances, index_count, lod);
+            stats.instanced_draws++;
+        } else {
+            log.push(RenderCommandType::DRAW_MESH, call.mesh_id, index_count, lod);
+        }
+
+        stats.draw_calls++;
+        stats.instances += instances;
+        stats.triangles += instances * (index_count / 3);
+        stats.index_bytes += (u64_t)index_count * mesh.get_index_size();
+        if(mesh.index_type == IndexType::U16) stats.index_bytes_saved += (u64_t)index_count * 2;
+
+        if(lod) {
+            stats.lod_reduced += instances;
+            stats.triangles_saved += instances * ((mesh.get_lod_count(0) - index_count) / 3);
+        }
+
+        first = last;
+    }
+
+    stats.build_ms += elapsed_ms(build_start);
+}
+
+// Same mesh, shader, material and per draw uniforms, only the transform may differ
+bool RenderQueue::can_instance(const DrawCall& a, const DrawCall& b) {
+    if(a.mesh_id != b.mesh_id || a.shader_id != b.shader_id) return false;
+    if(a.material_id != b.material_id) return false;
+    if(a.render_state != b.render_state) return false;
+    if(a.mat4_uniform_count != b.mat4_uniform_count) return false;
+
+    for(u8_t i = 0; i < a.mat4_uniform_count; i++) {
+        if(a.mat4_uniforms[i].id != b.mat4_uniforms[i].id) return false;
+        if(a.mat4_uniforms[i].value != b.mat4_uniforms[i].value) return false;
+    }
+
+    return true;
+}
+
+void RenderQueue::set_instancing(bool enabled) {
+    instancing = enabled;
+}
+
+void RenderQueue::clear() {
+    records.clear();
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for(auto& buffer : buffers) buffer->clear();
+}
+
+void RenderQueue::reset() {
+    clear();
+
+    shader_slots.clear();
+    mesh_slot_lookup.clear();
+    mesh_slots.clear();
+    meshes_removed = false;
+    material_slots.clear();
+    material_slot_lookup.clear();
+    material_hashes.clear();
+
+    visible.clear();
+    visible.shrink_to_fit();
+    draw_lods.clear(); draw_lods.shrink_to_fit();
+    lod_history.clear(); lod_history.shrink_to_fit();
+    cull_x.clear(); cull_x.shrink_to_fit();
+    cull_y.clear(); cull_y.shrink_to_fit();
+    cull_z.clear(); cull_z.shrink_to_fit();
+    cull_radius.clear(); cull_radius.shrink_to_fit();
+    cull_visible.clear(); cull_visible.shrink_to_fit();
+    records.shrink_to_fit();
+
+    // The buffers stay, recording threads still have them cached
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for(auto& buffer : buffers) buffer->release();
+}
@@ -0,0 +1,196 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_RENDER_QUEUE_H
+#define PXL_RENDER_QUEUE_H
+
+#include "pxl_render_commands.h"
+#include "pxl_command_buffer.h"
+#include "pxl_texture_manager.h"
+
+#include <memory>
+#include <mutex>
+
+// Below this many draws per chunk culling stays on the calling thread
+#ifndef PXL_CULL_GRAIN
+#define PXL_CULL_GRAIN 16384
+#endif
+
+// A LOD is good enough while its error covers less than this much of the screen
+// height, about a pixel at 1080p
+#ifndef PXL_LOD_SCREEN_ERROR
+#define PXL_LOD_SCREEN_ERROR (1.0f / 1080.0f)
+#endif
+
+#ifndef PXL_LOD_HYSTERESIS
+#define PXL_LOD_HYSTERESIS 0.15f
+#endif
+
+// Backend agnostic half of a frame: collects the submitted draw calls, sorts them
+// by 64 bit key (pxl_sort_key.h) and turns them into a state filtered RenderCommandLog.
+// Every backend goes through this so the NullRenderer measures exactly what
+// GL41Renderer would do :D*
+//
+// submit() is safe to call from any number of threads: each thread records into its
+// own CommandBuffer, build() merges them on the render thread. Recording has to be
+// finished before build(), and meshes / shaders are registered on the render thread
+// while nobody is recording
+class RenderQueue {
+
+private:
+
+    std::unordered_map<u64_t, u32_t> shader_slots;
+    std::unordered_map<u64_t, u32_t> mesh_slot_lookup;
+    std::vector<const Mesh*> mesh_slots;     // null once unregistered, slots aren't reused
+    bool meshes_removed = false;            // draws recorded before that get dropped in merge()
+
+    // Materials are deduplicated on their contents, the hash map only narrows
+    // down candidates, equality is checked field by field
+    struct MaterialSlot {
+        Material material;
+        u64_t id;
+        u64_t hash;
+        u32_t shader_slot;
+        u32_t block;            // index into this frame's log.materials
+        u32_t stamp;            // build() that pushed block, uploads once per frame
+    };
+
+    std::vector<MaterialSlot> material_slots;
+    std::unordered_map<u64_t, u32_t> material_slot_lookup;
+    std::unordered_multimap<u64_t, u32_t> material_hashes;
+    u32_t build_stamp = 0;
+
+    struct Camera camera;
+    bool has_camera = false;
+
+    // One buffer per recording thread, found again through a thread_local cache
+    const u32_t queue_id;
+    mutable std::mutex buffers_mutex;
+    std::vector<std::unique_ptr<CommandBuffer>> buffers;
+
+    // Payloads stay where they were recorded, only keys + indices get sorted
+    std::vector<const DrawRecord*> records;
+
+    std::vector<u64_t> keys;
+    std::vector<u32_t> order;
+    std::vector<u64_t> scratch_keys;
+    std::vector<u32_t> scratch_order;
+
+    bool instancing = true;
+    bool culling = true;
+
+    // Frustum culling, world space spheres as SoA streams for the SIMD test
+    std::vector<f32_t> cull_x;
+    std::vector<f32_t> cull_y;
+    std::vector<f32_t> cull_z;
+    std::vector<f32_t> cull_radius;
+    std::vector<u8_t> cull_visible;
+    std::vector<u32_t> visible;         // draw indices that survived culling
+
+    // LOD per draw index, picked while culling. The history (by DrawCall::lod_handle)
+    // remembers last frame's pick for hysteresis
+    std::vector<u8_t> draw_lods;
+    std::vector<u8_t> lod_history;
+    f32_t lod_error = PXL_LOD_SCREEN_ERROR;
+    f32_t lod_hysteresis = PXL_LOD_HYSTERESIS;
+
+    // Screen space usage of the visible draws' textures, reduced per mesh / material
+    // before it goes to the manager. Null = nobody streams
+    TextureManager* texture_manager = nullptr;
+    std::vector<f32_t> mesh_usage;
+    std::vector<f32_t> material_usage;
+
+public:
+    RenderQueue();
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // Meshes are referenced, not copied, keep them at a stable address
+    void register_mesh(u64_t mesh_id, const Mesh* mesh);
+    // Later submits of the id fail, ones already recorded this frame are dropped
+    void unregister_mesh(u64_t mesh_id);
+    void register_shader(u64_t shader_id);
+
+    // Id of an already registered material with the same contents, 0 if none
+    u64_t find_material(const struct Material& material) const;
+    // Fails if the material's shader isn't registered
+    bool register_material(u64_t material_id, const struct Material& material);
+    const Material* get_material(u64_t material_id) const;
+
+    void set_camera(const struct Camera& camera);
+    void submit(const struct DrawCall& draw_call);
+
+    void build(RenderCommandLog& log, RenderStats& stats);
+
+    // Merges runs of draws that only differ in their transform into one
+    // DRAW_INSTANCED, on by default
+    void set_instancing(bool enabled);
+    bool is_instancing() const { return instancing; }
+
+    // Frustum culls against the camera before sorting. On by default, but only
+    // once set_camera() was called (without a camera everything is drawn)
+    void set_culling(bool enabled);
+    bool is_culling() const { return culling; }
+
+    // LODs are picked by projected error (needs Camera::projection_scale). Error is
+    // a fraction of the screen height, hysteresis a fraction of that error
+    void set_lod_error(f32_t screen_error);
+    void set_lod_hysteresis(f32_t hysteresis);
+
+    // Each build() tells the manager how big the visible draws' textures are on
+    // screen (everything counts as full screen without Camera::projection_scale)
+    void set_texture_manager(TextureManager* manager) { texture_manager = manager; }
+
+    // Drops this frame's draws
+    void clear();
+
+    // Forgets every mesh, shader and material too
+    void reset();
+
+    // Draws recorded so far over all threads, don't call while still recording
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    u32_t get_thread_count() const;
+
+private:
+
+    CommandBuffer* thread_buffer();
+    void merge();
+
+    void cull(RenderStats& stats);
+    void report_texture_usage();
+    void build_keys();
+    static bool can_instance(const DrawCall& a, const DrawCall& b);
+
+    static u64_t hash_material(const Material& material);
+    static bool same_material(const Material& a, const Material& b);
+
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_render_state.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+// bit layout, low to high:
+//  0 blend | 1-4 src color | 5-8 dst color | 9-12 src alpha | 13-16 dst alpha | 17-19 op
+// 20 depth test | 21 depth write | 22-24 depth func | 25-26 cull | 27 front ccw
+// 28-31 color mask | 32 scissor
+u64_t RenderState::pack() const {
+    u64_t bits = 0;
+    bits |= (u64_t)blend;
+    bits |= (u64_t)blend_src_color << 1;
+    bits |= (u64_t)blend_dst_color << 5;
+    bits |= (u64_t)blend_src_alpha << 9;
+    bits |= (u64_t)blend_dst_alpha << 13;
+    bits |= (u64_t)blend_op << 17;
+    bits |= (u64_t)depth_test << 20;
+    bits |= (u64_t)depth_write << 21;
+    bits |= (u64_t)depth_func << 22;
+    bits |= (u64_t)cull << 25;
+    bits |= (u64_t)front_ccw << 27;
+    bits |= (u64_t)(color_mask & 0xF) << 28;
+    bits |= (u64_t)scissor << 32;
+    return bits;
+}
+
+RenderState RenderState::unpack(u64_t bits) {
+    RenderState state;
+    state.blend = bits & 1;
+    state.blend_src_color = (BlendFactor)((bits >> 1) & 0xF);
+    state.blend_dst_color = (BlendFactor)((bits >> 5) & 0xF);
+    state.blend_src_alpha = (BlendFactor)((bits >> 9) & 0xF);
+    state.blend_dst_alpha = (BlendFactor)((bits >> 13) & 0xF);
+    state.blend_op = (BlendOp)((bits >> 17) & 0x7);
+    state.depth_test = (bits >> 20) & 1;
+    state.depth_write = (bits >> 21) & 1;
+    state.depth_func = (CompareFunc)((bits >> 22) & 0x7);
+    state.cull = (CullMode)((bits >> 25) & 0x3);
+    state.front_ccw = (bits >> 27) & 1;
+    state.color_mask = (u8_t)((bits >> 28) & 0xF);
+    state.scissor = (bits >> 32) & 1;
+    return state;
+}
+
+RenderState RenderState::opaque() {
+    RenderState state;
+    state.depth_test = true;
+    state.cull = CullMode::BACK;
+    return state;
+}
+
+RenderState RenderState::translucent() {
+    RenderState state;
+    state.blend = true;
+    state.blend_src_color = BlendFactor::SRC_ALPHA;
+    state.blend_dst_color = BlendFactor::ONE_MINUS_SRC_ALPHA;
+    state.blend_src_alpha = BlendFactor::ONE;
+    state.blend_dst_alpha = BlendFactor::ONE_MINUS_SRC_ALPHA;
+    state.depth_test = true;
+    state.depth_write = false;
+    return state;
+}
+
+RenderState RenderState::additive() {
+    RenderState state = translucent();
+    state.blend_src_color = BlendFactor::ONE;
+    state.blend_dst_color = BlendFactor::ONE;
+    state.blend_dst_alpha = BlendFactor::ONE;
+    return state;
+}
+
+namespace pxl {
+namespace render_state {
+
+    struct StateTable {
+        std::mutex mutex;
+        std::unordered_map<u64_t, u32_t> ids;
+        std::deque<RenderState> states;
+
+        StateTable() {
+            RenderState default_state;
+            ids.emplace(default_state.pack(), DEFAULT);
+            states.push_back(default_state);
+        }
+    };
+
+    static StateTable& table() {
+        static StateTable _table;
+        return _table;
+    }
+
+    u32_t register_state(const RenderState& state) {
+        StateTable& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+
+        u64_t bits = state.pack();
+        auto it = t.ids.find(bits);
+        if(it != t.ids.end()) return it->second;
+
+        u32_t id = (u32_t)t.states.size();
+        t.ids.emplace(bits, id);
+        t.states.push_back(RenderState::unpack(bits));
+        return id;
+    }
+
+    RenderState get_state(u32_t id) {
+        StateTable& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return id < t.states.size() ? t.states[id] : t.states[DEFAULT];
+    }
+
+    u32_t count() {
+        StateTable& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return (u32_t)t.states.size();
+    }
+
+};
+};
@@ -0,0 +1,124 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_RENDER_STATE_H
+#define PXL_RENDER_STATE_H
+
+#include "misc/utility/types.h"
+
+// Fixed function state a draw needs (blend / depth / cull / masks), packed into
+// 64 bits so comparing or hashing two states is one integer op. Registered states
+// get a small id that DrawCalls and the command log carry around :)*
+
+enum class BlendFactor : u8_t {
+    ZERO,
+    ONE,
+    SRC_COLOR,
+    ONE_MINUS_SRC_COLOR,
+    DST_COLOR,
+    ONE_MINUS_DST_COLOR,
+    SRC_ALPHA,
+    ONE_MINUS_SRC_ALPHA,
+    DST_ALPHA,
+    ONE_MINUS_DST_ALPHA,
+    COUNT
+};
+
+enum class BlendOp : u8_t {
+    ADD,
+    SUBTRACT,
+    REVERSE_SUBTRACT,
+    MIN,
+    MAX,
+    COUNT
+};
+
+enum class CompareFunc : u8_t {
+    NEVER,
+    LESS,
+    EQUAL,
+    LESS_EQUAL,
+    GREATER,
+    NOT_EQUAL,
+    GREATER_EQUAL,
+    ALWAYS,
+    COUNT
+};
+
+enum class CullMode : u8_t {
+    NONE,
+    BACK,
+    FRONT,
+    COUNT
+};
+
+// Defaults match a fresh GL context, so the default state (id 0) changes nothing
+struct RenderState {
+    bool blend = false;
+    BlendFactor blend_src_color = BlendFactor::ONE;
+    BlendFactor blend_dst_color = BlendFactor::ZERO;
+    BlendFactor blend_src_alpha = BlendFactor::ONE;
+    BlendFactor blend_dst_alpha = BlendFactor::ZERO;
+    BlendOp blend_op = BlendOp::ADD;
+
+    bool depth_test = false;
+    bool depth_write = true;
+    CompareFunc depth_func = CompareFunc::LESS;
+
+    CullMode cull = CullMode::NONE;
+    bool front_ccw = true;
+
+    u8_t color_mask = 0xF;          // rgba bits
+    bool scissor = false;
+
+    u64_t pack() const;
+    static RenderState unpack(u64_t bits);
+
+    bool operator==(const RenderState& other) const { return pack() == other.pack(); }
+    bool operator!=(const RenderState& other) const { return pack() != other.pack(); }
+
+    // Common presets
+    static RenderState opaque();
+    static RenderState translucent();
+    static RenderState additive();
+};
+
+namespace pxl {
+namespace render_state {
+
+    constexpr u32_t DEFAULT = 0;
+
+    // Same state -> same id, thread safe
+    u32_t register_state(const RenderState& state);
+    RenderState get_state(u32_t id);
+    u32_t count();
+
+};
+};
+
+#endif
@@ -30,14 +30,48 @@
 #define PXL_RENDERER_H
 
 #include "pxL_renderer_backend.h"
+#include "pxl_render_commands.h"
+#include "pxl_texture_manager.h"
 
 class PXLRenderer {
 public:
+    virtual ~PXLRenderer() = default;
+
     virtual u64_t add_mesh(struct Mesh& mesh) = 0;
+    // Frees the mesh's GPU memory (pooled ranges go back to the pool). Draws of it
+    // already submitted this frame are dropped, its textures stay
+    virtual void remove_mesh(u64_t mesh_id) = 0;
     virtual u64_t add_shader(struct Shader& shader) = 0;
+    // The shader with some of its declared keywords defined (space separated, see
+    // pxl_shader_source.h). The id works right away, draws use the plain shader
+    // until the variant is compiled. Without `precompile` it only starts compiling
+    // on its first draw. The same keywords twice give the same id
+    virtual u64_t add_shader_variant(u64_t shader_id, const char* keywords, bool precompile = true) = 0;
+    // Identical materials share one id
+    virtual u64_t add_material(const struct Material& material) = 0;
+    virtual void set_camera(const struct Camera& camera) = 0;
+
+    // The name is valid right away (Mesh::textures, Material::add_texture), the
+    // image streams in over the next frames. 0 on failure
+    virtual u32_t load_texture(const char* path, const SamplerDesc& sampler = SamplerDesc()) = 0;
+    virtual TextureManager& get_texture_manager() = 0;
+
+    // Watches the files behind every shader and texture (added before or after) and
+    // reloads whatever changes on disk, see reload()
+    virtual void set_hot_reload(bool enabled) = 0;
+    // Builds the shaders and decodes the textures using `path` again, in the
+    // background. Ids stay the same, draws use the old ones until the new ones are
+    // ready (and keep them if the new ones fail)
+    virtual void reload(const char* path) = 0;
+
+    // Thread safe, every thread records into its own command buffer. All recording
+    // has to be done (joined) before draw() runs on the render thread
     virtual void submit_draw_call(const struct DrawCall& draw_call) = 0;
+
     virtual void draw() = 0;
     virtual void cleanup() = 0;
+
+    virtual const RenderStats& get_frame_stats() const = 0;
 };
 
 #endif
\ No newline at end of file
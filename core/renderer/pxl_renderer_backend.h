@@ -30,9 +30,12 @@
 #define VENDOR_H
 
 #include "misc/utility/types.h"
+#include "misc/utility/interner.h"
+#include "core/renderer/pxl_vertex_layout.h"
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <glm/glm.hpp> 
 
@@ -46,29 +49,213 @@ struct Texture{
     std::vector<const char*> texture_paths;
 };
 
+// Object space bounds, filled when the mesh is added. A negative radius means
+// "unknown", those meshes are never culled
+struct Bounds {
+    glm::vec3 center = glm::vec3(0.0f);
+    f32_t radius = -1.0f;
+
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+};
+
+#ifndef PXL_MAX_MESH_LODS
+#define PXL_MAX_MESH_LODS 4
+#endif
+
+#define PXL_LOD_NONE 0xFF
+
+// Meshes with at most this many vertices get 16 bit indices
+#define PXL_U16_INDEX_VERTICES 65536
+
+enum class IndexType : u8_t {
+    U16,
+    U32
+};
+
+// One level of detail, a range of the mesh's index list. All LODs share the vertices
+struct MeshLod {
+    u32_t first_index = 0;
+    u32_t index_count = 0;
+    f32_t error = 0.0f;         // object space distance the simplifier moved the surface
+};
+
 struct Mesh {
     std::vector<Vertex> verticies;
     std::vector<u32_t> indices;
     std::vector<u32_t> textures;
 
-    u32_t vao;
-    u32_t vbo;
-    u32_t ebo;
+    u32_t vao = 0;
+    u32_t vbo = 0;
+    u32_t ebo = 0;
+
+    size_t size = 0;
+
+    Bounds bounds;
+
+    // Set when the mesh lives in a shared pool (MeshStorage::POOLED), vbo / ebo are
+    // the pool's then and must not be deleted per mesh
+    bool pooled = false;
+    u32_t base_vertex = 0;
+    u32_t first_index = 0;
+
+    // Filled by pxl::lod::generate() (core/assets/pxl_mesh_lod.h), finest first. With
+    // no LODs the whole index list is drawn
+    MeshLod lods[PXL_MAX_MESH_LODS];
+    u8_t lod_count = 0;
+
+    // Packed by pxl::vertex::quantize() (core/assets/pxl_vertex_quantize.h), `layout`
+    // describes vertex_data. Without it `verticies` go up with the standard layout.
+    // Positions decode as stored * position_scale + position_offset, bounds and
+    // transforms stay in the unpacked space
+    VertexLayout layout = VertexLayout::standard();
+    std::vector<u8_t> vertex_data;
+    glm::vec3 position_scale = glm::vec3(1.0f);
+    glm::vec3 position_offset = glm::vec3(0.0f);
+
+    // CPU side indices are always u32 (simplifier, optimizer, ...), the backend
+    // uploads them as u16 whenever the vertices fit and sets this when adding
+    IndexType index_type = IndexType::U32;
+
+    // Streaming (GL41Renderer with an upload budget): draws of a mesh that isn't
+    // resident yet are skipped. Once it is the CPU copies get freed unless
+    // keep_cpu_data is set, size / bounds / lods / layout stay valid
+    bool resident = true;
+    bool keep_cpu_data = false;
+    u32_t gpu_vertex_count = 0;
+
+    void release_cpu_data() {
+        std::vector<Vertex>().swap(verticies);
+        std::vector<u8_t>().swap(vertex_data);
+        std::vector<u32_t>().swap(indices);
+    }
+
+    IndexType fit_index_type() const {
+        return get_vertex_count() <= PXL_U16_INDEX_VERTICES ? IndexType::U16 : IndexType::U32;
+    }
+
+    u32_t get_index_size() const { return index_type == IndexType::U16 ? 2 : 4; }
+
+    bool is_quantized() const { return !vertex_data.empty(); }
+
+    const void* get_vertex_data() const {
+        return is_quantized() ? (const void*)vertex_data.data() : (const void*)verticies.data();
+    }
+
+    size_t get_vertex_count() const {
+        return is_quantized() ? vertex_data.size() / layout.stride : verticies.size();
+    }
+
+    // Only quantize() changes it, so it's still right after release_cpu_data()
+    const VertexLayout& get_layout() const { return layout; }
 
-    size_t size;
+    u32_t get_lod_first(u8_t lod) const { return lod < lod_count ? lods[lod].first_index : 0; }
+    u32_t get_lod_count(u8_t lod) const { return lod < lod_count ? lods[lod].index_count : (u32_t)size; }
 };
 
 struct Shader {
     const char* vertex;
     const char* fragment;
+    // One per line, "NAME" or "NAME VALUE", both stages get them after #version
+    const char* defines = nullptr;
+};
+
+#ifndef PXL_MAX_MATERIAL_TEXTURES
+#define PXL_MAX_MATERIAL_TEXTURES 8
+#endif
+
+#ifndef PXL_MAX_MATERIAL_PARAMS
+#define PXL_MAX_MATERIAL_PARAMS 8
+#endif
+
+// Immutable once added: a shader, the textures it samples and a block of vec4
+// constants (the PxlMaterial uniform block). Adding the same material twice gives
+// back the first id, so draws sharing parameters sort and bind together :)*
+struct Material {
+    u64_t shader_id = 0;
+    u32_t render_state = 0;     // pxl::render_state id
+
+    u32_t textures[PXL_MAX_MATERIAL_TEXTURES] = {};
+    u8_t texture_count = 0;
+
+    glm::vec4 params[PXL_MAX_MATERIAL_PARAMS] = {};
+    u8_t param_count = 0;
+
+    bool add_texture(u32_t texture) {
+        if(texture_count >= PXL_MAX_MATERIAL_TEXTURES) return false;
+        textures[texture_count++] = texture;
+        return true;
+    }
+
+    bool add_param(const glm::vec4& value) {
+        if(param_count >= PXL_MAX_MATERIAL_PARAMS) return false;
+        params[param_count++] = value;
+        return true;
+    }
+};
+
+#ifndef PXL_MAX_DRAW_UNIFORMS
+#define PXL_MAX_DRAW_UNIFORMS 4
+#endif
+
+struct DrawUniform {
+    u32_t id;           // Interner id of the uniform name
+    glm::mat4 value;
 };
 
 struct DrawCall {
     u64_t mesh_id;
-    u64_t shader_id;
+    u64_t shader_id;            // ignored when a material is set
+
+    // 0 = none, the mesh's textures and render_state are used then. A material
+    // brings its own shader, textures, state and constants
+    u64_t material_id = 0;
     
     glm::mat4 transform;
-    std::unordered_map<std::string, glm::mat4> mat4_uniform;
+
+    // Fixed slots instead of a string keyed map, no allocations per submit
+    DrawUniform mat4_uniforms[PXL_MAX_DRAW_UNIFORMS];
+    u8_t mat4_uniform_count = 0;
+
+    u32_t render_state = 0;     // pxl::render_state id, 0 = GL defaults. Ignored with a material
+
+    // Any number stable for the object across frames (an entity index, ...) turns on
+    // LOD hysteresis for it, 0 = none. Keep them dense, they index a history table
+    u32_t lod_handle = 0;
+
+    u8_t layer = 0;             // 0..15, lower layers draw first
+    bool translucent = false;   // sorted back to front after the opaque draws of its layer
+
+    // Same id twice overwrites, returns false when the slots are full
+    bool set_mat4(u32_t uniform_id, const glm::mat4& value) {
+        for(u8_t i = 0; i < mat4_uniform_count; i++) {
+            if(mat4_uniforms[i].id == uniform_id) {
+                mat4_uniforms[i].value = value;
+                return true;
+            }
+        }
+
+        if(mat4_uniform_count >= PXL_MAX_DRAW_UNIFORMS) return false;
+
+        mat4_uniforms[mat4_uniform_count++] = { uniform_id, value };
+        return true;
+    }
+
+    // Interns on every call, prefer the id overload (PXL_INTERN("model")) in loops
+    bool set_mat4(const char* uniform, const glm::mat4& value) {
+        return set_mat4(Interner::intern(uniform), value);
+    }
+};
+
+// Only used for sorting (and later culling), shaders still get their matrices as uniforms
+struct Camera {
+    glm::mat4 view_projection = glm::mat4(1.0f);
+    glm::vec3 position = glm::vec3(0.0f);
+    f32_t far_plane = 1000.0f;
+
+    // projection[1][1] (1 / tan(fov_y / 2)), needed to pick LODs by screen size.
+    // 0 = always draw the finest LOD
+    f32_t projection_scale = 0.0f;
 };
 
 enum class Backend {
@@ -0,0 +1,147 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_shader_source.h"
+
+#include <algorithm>
+#include <cstring>
+
+// The #version directive, which GLSL only allows after whitespace and comments.
+// Null when something else comes first (or the source has none)
+static const char* find_version(const char* source) {
+    const char* cursor = source;
+
+    for(;;) {
+        while(*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n') cursor++;
+
+        if(cursor[0] == '/' && cursor[1] == '/') {
+            const char* end = std::strchr(cursor, '\n');
+            if(!end) return nullptr;
+            cursor = end + 1;
+        } else if(cursor[0] == '/' && cursor[1] == '*') {
+            const char* end = std::strstr(cursor + 2, "*/");
+            if(!end) return nullptr;
+            cursor = end + 2;
+        } else {
+            break;
+        }
+    }
+
+    if(*cursor != '#') return nullptr;
+
+    const char* directive = cursor + 1;
+    while(*directive == ' ' || *directive == '\t') directive++;
+
+    return std::strncmp(directive, "version", 7) ? nullptr : cursor;
+}
+
+namespace pxl {
+namespace shader {
+
+    std::string with_defines(const char* source, const char* defines) {
+        if(!defines || !*defines) return source;
+
+        std::string block;
+        for(const char* line = defines; *line;) {
+            const char* end = std::strchr(line, '\n');
+            if(!end) end = line + std::strlen(line);
+
+            const char* first = line;
+            const char* last = end;
+            while(first < last && (*first == ' ' || *first == '\t')) first++;
+            while(last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) last--;
+
+            if(first < last) {
+                block += "#define ";
+                block.append(first, last);
+                block += '\n';
+            }
+
+            line = *end ? end + 1 : end;
+        }
+
+        // #version has to stay the first thing the compiler sees
+        const char* version = find_version(source);
+        if(!version) return block + source;
+
+        const char* line_end = std::strchr(version, '\n');
+        if(!line_end) return std::string(source) + '\n' + block;
+
+        std::string result(source, line_end + 1);
+        result += block;
+        result += line_end + 1;
+        return result;
+    }
+
+    void declared_keywords(const char* source, std::vector<std::string>& out) {
+        static const char pragma[] = "pxl_keywords";
+
+        for(const char* line = source; line && *line;) {
+            const char* end = std::strchr(line, '\n');
+            if(!end) end = line + std::strlen(line);
+
+            const char* cursor = line;
+            while(cursor < end && (*cursor == ' ' || *cursor == '\t')) cursor++;
+
+            if(end - cursor > 7 && !std::strncmp(cursor, "#pragma", 7)) {
+                cursor += 7;
+                while(cursor < end && (*cursor == ' ' || *cursor == '\t')) cursor++;
+
+                const size_t length = sizeof(pragma) - 1;
+                if((size_t)(end - cursor) > length && !std::strncmp(cursor, pragma, length)
+                    && (cursor[length] == ' ' || cursor[length] == '\t')) {
+                    for(std::string& keyword : split_keywords(std::string(cursor + length, end).c_str()))
+                        if(std::find(out.begin(), out.end(), keyword) == out.end())
+                            out.push_back(std::move(keyword));
+                }
+            }
+
+            line = *end ? end + 1 : end;
+        }
+    }
+
+    std::vector<std::string> split_keywords(const char* keywords) {
+        std::vector<std::string> result;
+
+        for(const char* cursor = keywords; cursor && *cursor;) {
+            while(*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n') cursor++;
+
+            const char* first = cursor;
+            while(*cursor && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') cursor++;
+
+            if(cursor > first) result.emplace_back(first, cursor);
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+};
+};
@@ -0,0 +1,64 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_SHADER_SOURCE_H
+#define PXL_SHADER_SOURCE_H
+
+#include <string>
+#include <vector>
+
+// Backend agnostic GLSL source handling, before anything reaches the driver.
+//
+// Shaders declare the feature keywords they have variants for on their own line,
+// in either stage:
+//
+//      #pragma pxl_keywords SKINNED NORMAL_MAP FOG
+//
+// A variant is the same sources with some of them #defined (see
+// PXLRenderer::add_shader_variant()), GLSL compilers skip pragmas they don't know
+
+namespace pxl {
+namespace shader {
+
+    // `defines` holds one per line, "NAME" or "NAME VALUE". They go in right after
+    // the #version line (GLSL wants that first), so error line numbers past it
+    // shift by the number of defines
+    std::string with_defines(const char* source, const char* defines);
+
+    // Appends the keywords `source` declares to `out`, skipping ones already there
+    void declared_keywords(const char* source, std::vector<std::string>& out);
+
+    // Splits on spaces / tabs / newlines, sorted and without duplicates, so "B A"
+    // and "A B" name the same variant
+    std::vector<std::string> split_keywords(const char* keywords);
+
+};
+};
+
+#endif
@@ -0,0 +1,111 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_sort_key.h"
+
+#include <cstring>
+
+namespace pxl {
+namespace sort_key {
+
+    constexpr u32_t RADIX_BITS = 11;
+    constexpr u32_t RADIX_SIZE = 1u << RADIX_BITS;
+    constexpr u32_t RADIX_MASK = RADIX_SIZE - 1;
+    constexpr u32_t RADIX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+    static void insertion_sort(u64_t* keys, u32_t* values, size_t count) {
+        for(size_t i = 1; i < count; i++) {
+            u64_t key = keys[i];
+            u32_t value = values[i];
+
+            size_t j = i;
+            while(j > 0 && keys[j - 1] > key) {
+                keys[j] = keys[j - 1];
+                values[j] = values[j - 1];
+                j--;
+            }
+
+            keys[j] = key;
+            values[j] = value;
+        }
+    }
+
+    void radix_sort(u64_t* keys, u32_t* values, u64_t* scratch_keys, u32_t* scratch_values, size_t count) {
+        if(count < 64) {
+            insertion_sort(keys, values, count);
+            return;
+        }
+
+        // All six histograms in one read of the keys
+        static thread_local u32_t histograms[RADIX_PASSES][RADIX_SIZE];
+        memset(histograms, 0, sizeof(histograms));
+
+        for(size_t i = 0; i < count; i++) {
+            u64_t key = keys[i];
+            for(u32_t pass = 0; pass < RADIX_PASSES; pass++)
+                histograms[pass][(key >> (pass * RADIX_BITS)) & RADIX_MASK]++;
+        }
+
+        u64_t* src_keys = keys;
+        u32_t* src_values = values;
+        u64_t* dst_keys = scratch_keys;
+        u32_t* dst_values = scratch_values;
+
+        for(u32_t pass = 0; pass < RADIX_PASSES; pass++) {
+            u32_t* histogram = histograms[pass];
+            u32_t shift = pass * RADIX_BITS;
+
+            // Every key has the same digit here, nothing would move
+            if(histogram[(src_keys[0] >> shift) & RADIX_MASK] == count) continue;
+
+            u32_t offset = 0;
+            for(u32_t bin = 0; bin < RADIX_SIZE; bin++) {
+                u32_t bin_count = histogram[bin];
+                histogram[bin] = offset;
+                offset += bin_count;
+            }
+
+            for(size_t i = 0; i < count; i++) {
+                u64_t key = src_keys[i];
+                u32_t destination = histogram[(key >> shift) & RADIX_MASK]++;
+                dst_keys[destination] = key;
+                dst_values[destination] = src_values[i];
+            }
+
+            u64_t* swap_keys = src_keys; src_keys = dst_keys; dst_keys = swap_keys;
+            u32_t* swap_values = src_values; src_values = dst_values; dst_values = swap_values;
+        }
+
+        if(src_keys != keys) {
+            memcpy(keys, src_keys, count * sizeof(u64_t));
+            memcpy(values, src_values, count * sizeof(u32_t));
+        }
+    }
+
+} // namespace sort_key
+} // namespace pxl
@@ -0,0 +1,98 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_SORT_KEY_H
+#define PXL_SORT_KEY_H
+
+#include "misc/utility/types.h"
+
+#include <cstddef>
+
+// 64 bit draw sort keys :)*
+//
+//  opaque       | layer 4 | 0 | shader 11 | material 14 | mesh 16 | depth 18 (front to back) |
+//  translucent  | layer 4 | 1 | depth 18 (back to front) | shader 11 | material 14 | mesh 16 |
+//
+// Fields are compact slot indices handed out by the RenderQueue, not the 64 bit ids.
+// A slot wider than its field only costs batching (the payload still has the real ids).
+
+namespace pxl {
+namespace sort_key {
+
+    constexpr u32_t LAYER_BITS          = 4;
+    constexpr u32_t SHADER_BITS         = 11;
+    constexpr u32_t MATERIAL_BITS       = 14;
+    constexpr u32_t MESH_BITS           = 16;
+    constexpr u32_t DEPTH_BITS          = 18;
+
+    constexpr u64_t LAYER_MASK          = (1ull << LAYER_BITS) - 1;
+    constexpr u64_t SHADER_MASK         = (1ull << SHADER_BITS) - 1;
+    constexpr u64_t MATERIAL_MASK       = (1ull << MATERIAL_BITS) - 1;
+    constexpr u64_t MESH_MASK           = (1ull << MESH_BITS) - 1;
+    constexpr u64_t DEPTH_MASK          = (1ull << DEPTH_BITS) - 1;
+
+    constexpr u32_t LAYER_SHIFT         = 60;
+    constexpr u32_t TRANSLUCENT_SHIFT   = 59;
+
+    // depth is 0..1 (distance / far plane), clamped
+    inline u32_t quantize_depth(f32_t depth) {
+        if(!(depth > 0.0f)) return 0;
+        if(depth >= 1.0f) return (u32_t)DEPTH_MASK;
+        return (u32_t)(depth * (f32_t)DEPTH_MASK);
+    }
+
+    inline u64_t make_opaque(u32_t layer, u32_t shader, u32_t material, u32_t mesh, u32_t depth) {
+        return ((layer & LAYER_MASK) << LAYER_SHIFT)
+             | ((shader & SHADER_MASK) << 48)
+             | ((material & MATERIAL_MASK) << 34)
+             | ((mesh & MESH_MASK) << 18)
+             | (depth & DEPTH_MASK);
+    }
+
+    inline u64_t make_translucent(u32_t layer, u32_t shader, u32_t material, u32_t mesh, u32_t depth) {
+        return ((layer & LAYER_MASK) << LAYER_SHIFT)
+             | (1ull << TRANSLUCENT_SHIFT)
+             | ((DEPTH_MASK - (depth & DEPTH_MASK)) << 41)
+             | ((shader & SHADER_MASK) << 30)
+             | ((material & MATERIAL_MASK) << 16)
+             | (mesh & MESH_MASK);
+    }
+
+    inline bool is_translucent(u64_t key) {
+        return (key >> TRANSLUCENT_SHIFT) & 1;
+    }
+
+    // Stable LSD radix sort of keys with their payload indices riding along, 11 bit
+    // digits (6 passes) and passes where every key shares the digit are skipped.
+    // Scratch arrays must hold count elements, the result always ends up in keys / values
+    void radix_sort(u64_t* keys, u32_t* values, u64_t* scratch_keys, u32_t* scratch_values, size_t count);
+
+} // namespace sort_key
+} // namespace pxl
+
+#endif
@@ -0,0 +1,157 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_STD140_H
+#define PXL_STD140_H
+
+#include "misc/utility/types.h"
+
+#include <glm/glm.hpp>
+#include <cstring>
+#include <vector>
+
+// std140 rules in short: scalars align to 4, vec2 to 8, vec3/vec4 to 16, every array
+// element and every matrix column to 16. So a mat3 is three vec4 columns and a
+// float[4] takes 64 bytes, not 16 :D*
+
+// Engine side constant blocks. Shaders opt in by declaring them:
+//
+//      layout(std140) uniform PxlFrame {
+//          mat4 pxl_view_projection;
+//          vec4 pxl_camera;            // xyz position, w far plane
+//      };
+//
+//      layout(std140) uniform PxlMaterial {
+//          vec4 pxl_material_params[8];
+//      };
+//
+//      layout(std140) uniform PxlObject {
+//          mat4 pxl_model;
+//          mat4 pxl_model_view_projection;
+//      };
+//
+// Instanced draws don't rebind PxlObject per instance, shaders that want to be
+// instanced read the model matrix from an attribute instead:
+//
+//      layout(location = 3) in mat4 pxl_instance_model;       // takes 3..6
+
+#define PXL_FRAME_BLOCK_NAME    "PxlFrame"
+#define PXL_OBJECT_BLOCK_NAME   "PxlObject"
+#define PXL_MATERIAL_BLOCK_NAME "PxlMaterial"
+
+#define PXL_FRAME_BINDING       0
+#define PXL_OBJECT_BINDING      1
+#define PXL_MATERIAL_BINDING    2
+
+#define PXL_INSTANCE_ATTRIBUTE  "pxl_instance_model"
+
+struct PxlFrameConstants {
+    glm::mat4 view_projection;
+    glm::vec4 camera;
+};
+
+struct PxlObjectConstants {
+    glm::mat4 model;
+    glm::mat4 model_view_projection;
+};
+
+struct PxlMaterialConstants {
+    glm::vec4 params[8];
+};
+
+static_assert(sizeof(PxlFrameConstants) == 80, "PxlFrameConstants has to match the std140 PxlFrame block");
+static_assert(sizeof(PxlObjectConstants) == 128, "PxlObjectConstants has to match the std140 PxlObject block");
+static_assert(sizeof(PxlMaterialConstants) == 128, "PxlMaterialConstants has to match the std140 PxlMaterial block");
+
+// For blocks that aren't mirrored by a struct, writes members in declaration order
+// and pads them like the driver expects
+class Std140Writer {
+
+private:
+    std::vector<u8_t> data;
+
+public:
+
+    void clear() { data.clear(); }
+
+    const u8_t* bytes() const { return data.data(); }
+    size_t size() const { return data.size(); }
+
+    // Blocks are padded to 16 bytes, call before uploading
+    size_t finish() {
+        align(16);
+        return data.size();
+    }
+
+    void write(f32_t value) { put(&value, 4, 4); }
+    void write(s32_t value) { put(&value, 4, 4); }
+    void write(u32_t value) { put(&value, 4, 4); }
+    void write(bool value) { write((u32_t)value); }
+
+    void write(const glm::vec2& value) { put(&value, 8, 8); }
+    void write(const glm::vec3& value) { put(&value, 12, 16); }
+    void write(const glm::vec4& value) { put(&value, 16, 16); }
+    void write(const glm::ivec4& value) { put(&value, 16, 16); }
+
+    void write(const glm::mat3& value) {
+        for(s32_t i = 0; i < 3; i++)
+            put(&value[i], 12, 16);
+        align(16);
+    }
+
+    void write(const glm::mat4& value) { put(&value, 64, 16); }
+
+    // Arrays pad each element to a vec4
+    template<typename T>
+    void write_array(const T* values, size_t count) {
+        for(size_t i = 0; i < count; i++) {
+            align(16);
+            write(values[i]);
+        }
+        align(16);
+    }
+
+    // Nested structs start on a 16 byte boundary and are padded to one
+    void begin_struct() { align(16); }
+    void end_struct() { align(16); }
+
+private:
+
+    void align(size_t alignment) {
+        data.resize((data.size() + alignment - 1) & ~(alignment - 1), 0);
+    }
+
+    void put(const void* value, size_t size, size_t alignment) {
+        align(alignment);
+        size_t offset = data.size();
+        data.resize(offset + size);
+        memcpy(data.data() + offset, value, size);
+    }
+};
+
+#endif
@@ -0,0 +1,455 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#include "pxl_texture_manager.h"
+
+#include "core/thread/pxl_job_system.h"
+#include "core/debug/pxl_profiler.h"
+#include "misc/utility/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+static u32_t level_size(u32_t size, u8_t level) {
+    return std::max<u32_t>(size >> level, 1);
+}
+
+TextureManager::TextureManager(TextureBackend& backend, u64_t budget) :
+    backend(backend),
+    budget(budget) {
+
+}
+
+TextureManager::~TextureManager() {
+    cleanup();
+}
+
+u32_t TextureManager::load(const char* path, const SamplerDesc& sampler) {
+    std::string key = std::string(path) + "#" + std::to_string(sampler.key());
+
+    auto it = paths.find(key);
+    if(it != paths.end()) return it->second;
+
+    auto entry = std::make_unique<Entry>();
+    entry->path = path;
+
+    Entry* loaded = entry.get();
+    u32_t handle = add(std::move(entry), sampler);
+    if(!handle) return 0;
+
+    paths.emplace(key, handle);
+    decode(*loaded);
+
+    return handle;
+}
+
+u32_t TextureManager::create(Image image, const SamplerDesc& sampler) {
+    if(image.levels.empty()) return 0;
+
+    if(image.levels.size() == 1 && image.format == TextureFormat::RGBA8)
+        pxl::image::generate_mips(image);
+
+    auto entry = std::make_unique<Entry>();
+    Entry* created = entry.get();
+
+    u32_t handle = add(std::move(entry), sampler);
+    if(!handle) return 0;
+
+    auto source = std::make_unique<Source>();
+    source->image = std::move(image);
+    source->view = pxl::image::view(source->image);
+
+    accept(*created, std::move(source));
+    return handle;
+}
+
+u32_t TextureManager::add(std::unique_ptr<Entry> entry, const SamplerDesc& sampler) {
+    u32_t handle = backend.create_texture();
+    if(!handle) {
+        ERR("Couldn't create a texture");
+        return 0;
+    }
+
+    auto it = samplers.find(sampler.key());
+    if(it == samplers.end())
+        it = samplers.emplace(sampler.key(), SamplerSlot{ backend.create_sampler(sampler), 0 }).first;
+    it->second.references++;
+
+    entry->handle = handle;
+    entry->sampler_key = sampler.key();
+    entry->sampler = it->second.sampler;
+
+    entries.emplace(handle, std::move(entry));
+    return handle;
+}
+
+void TextureManager::decode(Entry& entry) {
+    if(entry.path.empty() || (entry.broken && !entry.reload_queued)) return;
+    if(entry.job.load(std::memory_order_acquire) != IDLE) return;
+
+    entry.job.store(DECODING, std::memory_order_relaxed);
+    entry.reloading = entry.reload_queued;
+    entry.reload_queued = false;
+
+    // Nothing on this thread touches path / decoded until the job is done
+    Entry* target = &entry;
+    pxl::jobs::submit([target]() {
+        auto source = std::make_unique<Source>();
+        bool loaded = read(target->path.c_str(), *source);
+
+        if(loaded) target->decoded = std::move(source);
+        target->job.store(loaded ? READY : FAILED, std::memory_order_release);
+    });
+}
+
+// On a job worker. A .pxtex is only validated here, its pages come in when
+// upload() hands the levels to the backend
+bool TextureManager::read(const char* path, Source& source) {
+    if(pxl::image::can_map(path))
+        return pxl::image::map(path, source.file, source.view);
+
+    if(!pxl::image::load(path, source.image)) return false;
+
+    if(source.image.levels.size() == 1 && source.image.format == TextureFormat::RGBA8)
+        pxl::image::generate_mips(source.image);
+
+    source.view = pxl::image::view(source.image);
+    return true;
+}
+
+bool TextureManager::accept(Entry& entry, std::unique_ptr<Source> image) {
+    const ImageView& view = image->view;
+    const u8_t level_count = (u8_t)std::min<size_t>(view.levels.size(), PXL_TEXTURE_LEVEL_NONE);
+
+    // No software fallback, cook the texture in a format the target has
+    if(!backend.supports(view.format)) {
+        ERR("%s textures aren't supported here: %s", pxl::image::format_name(view.format),
+            entry.path.empty() ? "(image)" : entry.path.c_str());
+        entry.broken = true;
+        return false;
+    }
+
+    if(!entry.level_count) {
+        entry.format = view.format;
+        entry.width = view.get_width();
+        entry.height = view.get_height();
+        entry.level_count = level_count;
+        entry.resident = level_count;
+
+        entry.tail = level_count - 1;
+        for(u8_t i = 0; i < level_count; i++) {
+            if(std::max(level_size(entry.width, i), level_size(entry.height, i)) <= PXL_TEXTURE_TAIL_SIZE) {
+                entry.tail = i;
+                break;
+            }
+        }
+
+        entry.wanted = entry.usage > 0.0f ? pick_level(entry, entry.usage) : entry.tail;
+    } else if(view.format != entry.format || view.get_width() != entry.width
+        || view.get_height() != entry.height || level_count != entry.level_count) {
+        // Redecoded after an eviction, levels already on the GPU wouldn't match
+        ERR("Texture changed while streaming, keeping what's resident: %s", entry.path.c_str());
+        entry.broken = true;
+        return false;
+    }
+
+    entry.image = std::move(image);
+    entry.image_used = frame;
+    return true;
+}
+
+// Levels of the old image can't mix with the new one, all of them go and the new
+// tail goes up right after (same update), so the name never samples nothing
+void TextureManager::replace(Entry& entry, std::unique_ptr<Source> image) {
+    if(!backend.supports(image->view.format)) {
+        ERR("%s textures aren't supported here, keeping the old one: %s",
+            pxl::image::format_name(image->view.format), entry.path.c_str());
+        return;
+    }
+
+    for(u8_t level = entry.resident; level < entry.level_count; level++)
+        backend.release_level(entry.handle, entry.format, level);
+
+    resident_bytes -= entry.resident_bytes;
+    entry.resident_bytes = 0;
+    entry.level_count = 0;
+    entry.broken = false;
+    entry.image.reset();
+
+    if(!accept(entry, std::move(image))) return;
+
+    if(entry.last_usage > 0.0f) entry.wanted = pick_level(entry, entry.last_usage);
+    LOG("Reloaded texture: %s", entry.path.c_str());
+}
+
+u8_t TextureManager::pick_level(const Entry& entry, f32_t usage) const {
+    // Texels along the texture vs. pixels it covers, every halving is a level
+    f32_t pixels = usage * (f32_t)screen_height;
+    if(pixels <= 0.0f) return entry.tail;
+
+    f32_t level = std::log2((f32_t)std::max(entry.width, entry.height) / pixels) + lod_bias;
+    if(!(level > 0.0f)) return 0;
+
+    return (u8_t)std::min<f32_t>(std::floor(level), (f32_t)entry.tail);
+}
+
+void TextureManager::note_usage(u32_t texture, f32_t screen_fraction) {
+    auto it = entries.find(texture);
+    if(it == entries.end()) return;
+
+    Entry& entry = *it->second;
+    entry.usage = std::max(entry.usage, screen_fraction);
+}
+
+TextureStats TextureManager::update() {
+    PXL_PROFILE_FUNCTION();
+
+    TextureStats stats;
+    frame++;
+    streaming.clear();
+
+    for(auto& pair : entries) {
+        Entry& entry = *pair.second;
+
+        u8_t job = entry.job.load(std::memory_order_acquire);
+        if(job == READY) {
+            std::unique_ptr<Source> image = std::move(entry.decoded);
+            entry.job.store(IDLE, std::memory_order_relaxed);
+
+            if(entry.reloading) replace(entry, std::move(image));
+            else accept(entry, std::move(image));
+        } else if(job == FAILED) {
+            entry.job.store(IDLE, std::memory_order_relaxed);
+
+            // A half written file, what's up keeps working and the next save reloads it
+            if(entry.reloading && entry.level_count) ERR("Couldn't reload texture, keeping the old one: %s", entry.path.c_str());
+            else entry.broken = true;
+        }
+
+        if(entry.reload_queued) decode(entry);
+
+        if(entry.usage > 0.0f) {
+            entry.last_used = frame;
+            entry.last_usage = entry.usage;
+            entry.usage = 0.0f;
+
+            if(entry.level_count) entry.wanted = pick_level(entry, entry.last_usage);
+        }
+
+        if(!entry.level_count) continue;
+
+        // The tail skips both budgets, it's tiny and makes the texture show up at all
+        while(entry.image && entry.resident > entry.tail)
+            upload(entry, entry.resident - 1, stats);
+
+        if(entry.resident > entry.wanted) streaming.push_back(&entry);
+    }
+
+    // On screen most recently and biggest first
+    std::sort(streaming.begin(), streaming.end(), [](const Entry* a, const Entry* b) {
+        if(a->last_used != b->last_used) return a->last_used > b->last_used;
+        return a->last_usage > b->last_usage;
+    });
+
+    u64_t upload_left = upload_budget - std::min<u64_t>(stats.upload_bytes, upload_budget);
+    bool out_of_uploads = false;
+
+    for(Entry* entry : streaming) {
+        while(!out_of_uploads && entry->resident > entry->wanted) {
+            if(!entry->image) {
+                if(!entry->broken && entry->job.load(std::memory_order_acquire) == IDLE) {
+                    decode(*entry);
+                    stats.decodes++;
+                }
+                break;
+            }
+
+            u8_t level = entry->resident - 1;
+            size_t bytes = pxl::image::level_bytes(entry->format,
+                level_size(entry->width, level), level_size(entry->height, level));
+
+            // One level always goes, however big
+            if(bytes > upload_left && stats.upload_bytes > 0) {
+                out_of_uploads = true;
+                break;
+            }
+
+            // Memory's full of things on screen, this one stays blurrier
+            if(resident_bytes + bytes > budget && !make_room(bytes, *entry, stats)) break;
+
+            upload(*entry, level, stats);
+            upload_left -= std::min<u64_t>(bytes, upload_left);
+        }
+
+        if(entry->resident > entry->wanted) stats.streaming++;
+    }
+
+    // Done file images go, dropped levels decode again. create() ones have nothing to go back to
+    for(auto& pair : entries) {
+        Entry& entry = *pair.second;
+        if(!entry.image || entry.path.empty() || entry.resident > entry.wanted) continue;
+        if(frame - entry.image_used > PXL_TEXTURE_KEEP_FRAMES || entry.resident == 0) entry.image.reset();
+    }
+
+    stats.resident_bytes = resident_bytes;
+    return stats;
+}
+
+void TextureManager::upload(Entry& entry, u8_t level, TextureStats& stats) {
+    const ImageLevelView& source = entry.image->view.levels[level];
+
+    backend.upload_level(entry.handle, entry.format, level,
+        source.width, source.height, source.data, source.size);
+    backend.set_level_range(entry.handle, level, entry.level_count - 1);
+
+    entry.resident = level;
+    entry.resident_bytes += source.size;
+    entry.image_used = frame;
+
+    resident_bytes += source.size;
+    stats.upload_bytes += source.size;
+}
+
+// Drops the finest resident level, out of the sampled range first
+void TextureManager::evict(Entry& entry, TextureStats& stats) {
+    u8_t level = entry.resident;
+    size_t bytes = pxl::image::level_bytes(entry.format,
+        level_size(entry.width, level), level_size(entry.height, level));
+
+    backend.set_level_range(entry.handle, level + 1, entry.level_count - 1);
+    backend.release_level(entry.handle, entry.format, level);
+
+    entry.resident = level + 1;
+    entry.resident_bytes -= bytes;
+
+    resident_bytes -= bytes;
+    stats.evicted_bytes += bytes;
+}
+
+bool TextureManager::make_room(size_t bytes, const Entry& requester, TextureStats& stats) {
+    while(resident_bytes + bytes > budget) {
+        Entry* victim = nullptr;
+        bool victim_unneeded = false;
+
+        for(auto& pair : entries) {
+            Entry& entry = *pair.second;
+            if(&entry == &requester || !entry.level_count || entry.resident >= entry.tail) continue;
+
+            // Levels finer than the texture wants right now go first, then whatever
+            // wasn't on screen for the longest. Used this frame and needed: hands off
+            bool unneeded = entry.resident < entry.wanted;
+            if(!unneeded && entry.last_used == frame) continue;
+
+            if(!victim || (unneeded && !victim_unneeded)
+                || (unneeded == victim_unneeded && entry.last_used < victim->last_used)) {
+                victim = &entry;
+                victim_unneeded = unneeded;
+            }
+        }
+
+        if(!victim) return false;
+        evict(*victim, stats);
+    }
+
+    return true;
+}
+
+u32_t TextureManager::get_sampler(u32_t texture) const {
+    auto it = entries.find(texture);
+    return it != entries.end() ? it->second->sampler : 0;
+}
+
+u8_t TextureManager::get_resident_level(u32_t texture) const {
+    auto it = entries.find(texture);
+    if(it == entries.end() || it->second->resident >= it->second->level_count) return PXL_TEXTURE_LEVEL_NONE;
+    return it->second->resident;
+}
+
+void TextureManager::wait(Entry& entry) {
+    while(entry.job.load(std::memory_order_acquire) == DECODING)
+        std::this_thread::yield();
+}
+
+void TextureManager::destroy(Entry& entry) {
+    wait(entry);
+
+    backend.destroy_texture(entry.handle);
+    resident_bytes -= entry.resident_bytes;
+
+    auto it = samplers.find(entry.sampler_key);
+    if(it != samplers.end() && --it->second.references == 0) {
+        backend.destroy_sampler(it->second.sampler);
+        samplers.erase(it);
+    }
+}
+
+void TextureManager::release(u32_t texture) {
+    auto it = entries.find(texture);
+    if(it == entries.end()) return;
+
+    destroy(*it->second);
+
+    for(auto path = paths.begin(); path != paths.end(); ++path) {
+        if(path->second != texture) continue;
+        paths.erase(path);
+        break;
+    }
+
+    entries.erase(it);
+}
+
+u32_t TextureManager::reload(const char* path) {
+    u32_t reloaded = 0;
+
+    for(auto& pair : entries) {
+        Entry& entry = *pair.second;
+        if(entry.path != path) continue;
+
+        // Being rewritten, the old mapping can't be read from anymore
+        if(entry.image && entry.image->file.is_open()) entry.image.reset();
+
+        // A decode that's already running may have read the old file
+        entry.reload_queued = true;
+        decode(entry);
+        reloaded++;
+    }
+
+    return reloaded;
+}
+
+void TextureManager::cleanup() {
+    for(auto& pair : entries) destroy(*pair.second);
+
+    entries.clear();
+    paths.clear();
+    samplers.clear();
+    streaming.clear();
+    resident_bytes = 0;
+}
@@ -0,0 +1,268 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+
+#ifndef PXL_TEXTURE_MANAGER_H
+#define PXL_TEXTURE_MANAGER_H
+
+#include "core/assets/pxl_image.h"
+#include "core/io/pxl_mapped_file.h"
+#include "core/config.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Texture bytes uploaded per frame, one level always goes even if it's bigger
+#ifndef PXL_TEXTURE_UPLOAD_BYTES
+#define PXL_TEXTURE_UPLOAD_BYTES (4 << 20)
+#endif
+
+// Levels this size and smaller (the mip tail) go up as soon as a texture is
+// decoded and never get evicted
+#ifndef PXL_TEXTURE_TAIL_SIZE
+#define PXL_TEXTURE_TAIL_SIZE 64
+#endif
+
+// Decoded file images stay around this many updates after their last upload, in
+// case the texture wants finer levels again soon
+#ifndef PXL_TEXTURE_KEEP_FRAMES
+#define PXL_TEXTURE_KEEP_FRAMES 120
+#endif
+
+#define PXL_TEXTURE_LEVEL_NONE 0xFF
+
+enum class TextureFilter : u8_t {
+    NEAREST,
+    LINEAR,
+    TRILINEAR
+};
+
+enum class TextureWrap : u8_t {
+    REPEAT,
+    CLAMP,
+    MIRROR
+};
+
+struct SamplerDesc {
+    TextureFilter filter = TextureFilter::TRILINEAR;
+    TextureWrap wrap_u = TextureWrap::REPEAT;
+    TextureWrap wrap_v = TextureWrap::REPEAT;
+    u8_t anisotropy = 1;        // 1 = off
+
+    u64_t key() const {
+        return (u64_t)filter | ((u64_t)wrap_u << 8) | ((u64_t)wrap_v << 16) | ((u64_t)anisotropy << 24);
+    }
+};
+
+// What the TextureManager needs from a graphics API. Texture names come out of
+// create_texture() before anything is known about them and stay the same while
+// levels come and go, so materials / meshes can hold on to them. The NullRenderer
+// has a fake one that only counts
+class TextureBackend {
+public:
+    virtual ~TextureBackend() = default;
+
+    virtual u32_t create_texture() = 0;
+    virtual void destroy_texture(u32_t texture) = 0;
+
+    // Whether upload_level() takes `format`, block formats depend on the driver
+    virtual bool supports(TextureFormat format) const = 0;
+
+    // Defines one mip level, `data` is tightly packed in `format`
+    virtual void upload_level(u32_t texture, TextureFormat format, u8_t level,
+        u32_t width, u32_t height, const void* data, size_t bytes) = 0;
+    // Frees the level's memory, it's outside the sampled range by then
+    virtual void release_level(u32_t texture, TextureFormat format, u8_t level) = 0;
+    // Only levels base..max get sampled
+    virtual void set_level_range(u32_t texture, u8_t base, u8_t max) = 0;
+
+    virtual u32_t create_sampler(const SamplerDesc& sampler) = 0;
+    virtual void destroy_sampler(u32_t sampler) = 0;
+};
+
+struct TextureStats {
+    u64_t resident_bytes = 0;
+    u64_t upload_bytes = 0;         // this update
+    u64_t evicted_bytes = 0;        // this update
+    u64_t streaming = 0;            // textures still below the level they want
+    u64_t decodes = 0;              // decodes started this update
+};
+
+// Owns every texture loaded through it and decides which mip levels live on the
+// GPU. Files decode on job workers (pxl::jobs::submit), the mip tail goes up right
+// away so the texture is usable (blurry) from the next frame on. Finer levels
+// follow on demand: note_usage() gets the fraction of the screen height the
+// texture covers (the RenderQueue feeds it from the visible draws), that picks the
+// level it wants and update() streams towards it, coarse to fine, within the per
+// frame upload budget.
+//
+// Once everything resident would go over the memory budget, levels get dropped
+// from the textures nobody looked at for the longest, and first of all the
+// levels finer than what their texture currently wants. Dropped levels of file
+// textures decode again when they're needed, images handed to create() keep
+// their CPU copy instead.
+//
+// .pxtex files aren't decoded at all, the worker only maps and validates them and
+// upload() passes the level spans inside the mapping to the backend. The mapping
+// stays open while the texture streams (on Windows the file can't be overwritten
+// until then).
+//
+// reload() decodes a file texture again after it changed on disk. The old levels
+// stay up until the new image is decoded, then the name gets the new mip tail in
+// the same update and finer levels stream in like after a load.
+//
+// Everything but the decoding runs on the backend's thread and is plain CPU
+// bookkeeping, any TextureBackend works :)*
+class TextureManager {
+
+private:
+    enum : u8_t {
+        IDLE,
+        DECODING,
+        READY,
+        FAILED
+    };
+
+    // CPU side levels while some aren't on the GPU. Decoded files and create()
+    // images own theirs. A .pxtex stays mapped and its levels go to the backend
+    // straight out of the mapping, so nothing gets copied on the way
+    struct Source {
+        Image image;
+        MappedFile file;
+        ImageView view;                     // the levels, in `image` or in `file`
+    };
+
+    struct Entry {
+        u32_t handle = 0;
+        std::string path;                   // empty for create() images
+        u64_t sampler_key = 0;
+        u32_t sampler = 0;
+
+        TextureFormat format = TextureFormat::RGBA8;
+        u32_t width = 0;
+        u32_t height = 0;
+        u8_t level_count = 0;               // 0 until the first decode
+        u8_t tail = 0;                      // first level of the mip tail
+        u8_t resident = 0;                  // finest level on the GPU, level_count = none
+        u8_t wanted = 0;
+        bool broken = false;
+        bool reload_queued = false;         // file changed, decode it again once idle
+        bool reloading = false;             // the running decode replaces everything
+
+        f32_t usage = 0.0f;                 // largest note_usage() since the last update
+        f32_t last_usage = 0.0f;
+        u64_t last_used = 0;                // update() that last saw usage
+        size_t resident_bytes = 0;
+
+        std::unique_ptr<Source> image;      // CPU levels while some are missing
+        u64_t image_used = 0;               // update() that last uploaded from it
+        std::unique_ptr<Source> decoded;    // worker output, handed over on READY
+        std::atomic<u8_t> job { IDLE };
+    };
+
+    struct SamplerSlot {
+        u32_t sampler;
+        u32_t references;
+    };
+
+    TextureBackend& backend;
+
+    std::unordered_map<u32_t, std::unique_ptr<Entry>> entries;
+    std::unordered_map<std::string, u32_t> paths;
+    std::unordered_map<u64_t, SamplerSlot> samplers;
+
+    u64_t budget;
+    u64_t upload_budget = PXL_TEXTURE_UPLOAD_BYTES;
+    u32_t screen_height = 1080;
+    f32_t lod_bias = 0.0f;
+
+    u64_t frame = 0;
+    u64_t resident_bytes = 0;
+
+    std::vector<Entry*> streaming;
+
+public:
+    TextureManager(TextureBackend& backend, u64_t budget = PXL_TEXTURE_BUDGET_BYTES);
+    ~TextureManager();
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    // Returns the texture name right away, levels arrive over the next updates. The
+    // same path and sampler twice give the same texture. 0 on failure
+    u32_t load(const char* path, const SamplerDesc& sampler = SamplerDesc());
+    // Images without mips get them generated
+    u32_t create(Image image, const SamplerDesc& sampler = SamplerDesc());
+    void release(u32_t texture);
+    // Every texture loaded from `path` (spelled like in load()), returns how many
+    u32_t reload(const char* path);
+    void cleanup();
+
+    // `screen_fraction`: how much of the screen height the texture is stretched
+    // over, 1 = all of it. Call between updates, the largest one wins
+    void note_usage(u32_t texture, f32_t screen_fraction);
+
+    // Once per frame on the backend's thread
+    TextureStats update();
+
+    bool owns(u32_t texture) const { return entries.count(texture) != 0; }
+    // Deduplicated sampler of the texture, 0 for textures the manager doesn't own
+    u32_t get_sampler(u32_t texture) const;
+    // Finest level on the GPU, PXL_TEXTURE_LEVEL_NONE when nothing is
+    u8_t get_resident_level(u32_t texture) const;
+
+    void set_budget(u64_t bytes) { budget = bytes; }
+    void set_upload_budget(u64_t bytes) { upload_budget = bytes; }
+    void set_screen_height(u32_t pixels) { screen_height = pixels; }
+    // > 0 asks for blurrier levels, < 0 for sharper ones
+    void set_lod_bias(f32_t bias) { lod_bias = bias; }
+
+    u64_t get_resident_bytes() const { return resident_bytes; }
+
+private:
+
+    u32_t add(std::unique_ptr<Entry> entry, const SamplerDesc& sampler);
+    void decode(Entry& entry);
+    static bool read(const char* path, Source& source);
+    bool accept(Entry& entry, std::unique_ptr<Source> image);
+    void replace(Entry& entry, std::unique_ptr<Source> image);
+    u8_t pick_level(const Entry& entry, f32_t usage) const;
+
+    void upload(Entry& entry, u8_t level, TextureStats& stats);
+    void evict(Entry& entry, TextureStats& stats);
+    bool make_room(size_t bytes, const Entry& requester, TextureStats& stats);
+
+    void wait(Entry& entry);
+    void destroy(Entry& entry);
+
+};
+
+#endif
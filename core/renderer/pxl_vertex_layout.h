@@ -0,0 +1,183 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_VERTEX_LAYOUT_H
+#define PXL_VERTEX_LAYOUT_H
+
+#include "misc/utility/types.h"
+
+// Declarative vertex formats. A mesh either keeps the plain f32 Vertex (the
+// standard layout) or gets packed by pxl::vertex::quantize() into whatever layout
+// it asks for, and the backend generates its attribute setup from the layout.
+//
+// Quantized positions are stored normalized to the mesh's box, the renderer folds
+// Mesh::position_scale / position_offset into the model matrix so shaders don't
+// change. Octahedral normals arrive as a vec2 in -1..1 though, decode them with:
+//
+//      vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+//      if(n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * sign(n.xy);
+//      n = normalize(n);
+
+#ifndef PXL_MAX_VERTEX_ATTRIBUTES
+#define PXL_MAX_VERTEX_ATTRIBUTES 8
+#endif
+
+enum class VertexFormat : u8_t {
+    FLOAT2,
+    FLOAT3,
+    FLOAT4,
+    HALF2,
+    HALF4,          // positions, w = 1 keeps it 8 byte aligned
+    UNORM8X4,       // colors
+    SNORM16X2,      // octahedral normals
+    UNORM16X2       // uvs that stay inside 0..1
+};
+
+enum class VertexSemantic : u8_t {
+    POSITION,
+    COLOR,
+    UV,
+    NORMAL,
+    COUNT
+};
+
+struct VertexAttribute {
+    VertexSemantic semantic;
+    VertexFormat format;
+    u8_t location;
+    u8_t offset;
+};
+
+namespace pxl {
+namespace vertex {
+
+    inline u32_t format_size(VertexFormat format) {
+        switch(format) {
+            case VertexFormat::FLOAT2:      return 8;
+            case VertexFormat::FLOAT3:      return 12;
+            case VertexFormat::FLOAT4:      return 16;
+            case VertexFormat::HALF2:       return 4;
+            case VertexFormat::HALF4:       return 8;
+            case VertexFormat::UNORM8X4:    return 4;
+            case VertexFormat::SNORM16X2:   return 4;
+            case VertexFormat::UNORM16X2:   return 4;
+        }
+        return 0;
+    }
+
+    // Locations 3..6 belong to pxl_instance_model, normals go behind it
+    inline u8_t default_location(VertexSemantic semantic) {
+        switch(semantic) {
+            case VertexSemantic::POSITION:  return 0;
+            case VertexSemantic::COLOR:     return 1;
+            case VertexSemantic::UV:        return 2;
+            case VertexSemantic::NORMAL:    return 7;
+            default:                        return 0;
+        }
+    }
+
+};
+};
+
+struct VertexLayout {
+    VertexAttribute attributes[PXL_MAX_VERTEX_ATTRIBUTES] = {};
+    u8_t count = 0;
+    u16_t stride = 0;
+
+    // Attributes are packed in the order they're added, every one 4 byte aligned
+    VertexLayout& add(VertexSemantic semantic, VertexFormat format) {
+        return add(semantic, format, pxl::vertex::default_location(semantic));
+    }
+
+    VertexLayout& add(VertexSemantic semantic, VertexFormat format, u8_t location) {
+        if(count >= PXL_MAX_VERTEX_ATTRIBUTES) return *this;
+
+        attributes[count++] = { semantic, format, location, (u8_t)stride };
+        stride = (u16_t)(stride + ((pxl::vertex::format_size(format) + 3) & ~3u));
+        return *this;
+    }
+
+    const VertexAttribute* find(VertexSemantic semantic) const {
+        for(u8_t i = 0; i < count; i++)
+            if(attributes[i].semantic == semantic) return &attributes[i];
+        return nullptr;
+    }
+
+    // Pools and caches key on this
+    u64_t hash() const {
+        u64_t hash = 0xcbf29ce484222325ull;
+        auto mix = [&hash](u32_t value) {
+            hash ^= value;
+            hash *= 0x100000001b3ull;
+        };
+
+        mix(stride);
+        for(u8_t i = 0; i < count; i++) {
+            const VertexAttribute& attribute = attributes[i];
+            mix((u32_t)attribute.semantic
+                | ((u32_t)attribute.format << 8)
+                | ((u32_t)attribute.location << 16)
+                | ((u32_t)attribute.offset << 24));
+        }
+        return hash;
+    }
+
+    bool operator==(const VertexLayout& other) const {
+        if(count != other.count || stride != other.stride) return false;
+        for(u8_t i = 0; i < count; i++) {
+            const VertexAttribute& a = attributes[i];
+            const VertexAttribute& b = other.attributes[i];
+            if(a.semantic != b.semantic || a.format != b.format) return false;
+            if(a.location != b.location || a.offset != b.offset) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const VertexLayout& other) const { return !(*this == other); }
+
+    // The f32 Vertex struct: position, color, uv. 32 bytes
+    static VertexLayout standard() {
+        VertexLayout layout;
+        layout.add(VertexSemantic::POSITION, VertexFormat::FLOAT3)
+              .add(VertexSemantic::COLOR, VertexFormat::FLOAT3)
+              .add(VertexSemantic::UV, VertexFormat::FLOAT2);
+        return layout;
+    }
+
+    // Half positions, unorm8 colors, half uvs (+ octahedral normals). 16 / 20 bytes
+    static VertexLayout compressed(bool normals = false) {
+        VertexLayout layout;
+        layout.add(VertexSemantic::POSITION, VertexFormat::HALF4)
+              .add(VertexSemantic::COLOR, VertexFormat::UNORM8X4)
+              .add(VertexSemantic::UV, VertexFormat::HALF2);
+        if(normals) layout.add(VertexSemantic::NORMAL, VertexFormat::SNORM16X2);
+        return layout;
+    }
+};
+
+#endif
@@ -0,0 +1,249 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#include "pxl_job_system.h"
+
+#include "core/debug/pxl_metrics.h"
+#include "core/debug/pxl_profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pxl {
+namespace jobs {
+
+    struct JobBatch {
+        const RangeJob* job = nullptr;
+        u32_t count = 0;
+        u32_t chunk = 0;
+        u32_t chunks = 0;
+
+        std::atomic<u32_t> next { 0 };
+        std::atomic<u32_t> done { 0 };
+    };
+
+    struct JobSystem {
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+
+        JobBatch batch;
+        std::deque<Task> tasks;
+        u64_t generation = 0;
+        u32_t active = 0;           // workers inside run_chunks()
+        bool quit = false;
+
+        std::atomic<bool> busy { false };
+
+        ~JobSystem() { stop(); }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                quit = true;
+            }
+            wake.notify_all();
+
+            for(auto& worker : workers)
+                if(worker.joinable()) worker.join();
+
+            workers.clear();
+            quit = false;
+
+            // Nobody's left to run them, whoever waits on them still expects them done
+            while(!tasks.empty()) {
+                Task task = std::move(tasks.front());
+                tasks.pop_front();
+                task();
+            }
+        }
+    };
+
+    static JobSystem global_jobs;
+    static thread_local bool t_in_job = false;
+
+    static void run_chunks(JobBatch& batch) {
+        u32_t executed = 0;
+
+        for(;;) {
+            u32_t index = batch.next.fetch_add(1, std::memory_order_relaxed);
+            if(index >= batch.chunks) break;
+
+            u32_t begin = index * batch.chunk;
+            u32_t end = std::min(begin + batch.chunk, batch.count);
+            (*batch.job)(begin, end);
+
+            executed++;
+            batch.done.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        if(executed) PXL_METRIC_ADD("jobs.executed", executed);
+    }
+
+    static void worker_main(u32_t index) {
+        char name[32];
+        snprintf(name, sizeof(name), "job worker %u", index);
+        PXL_PROFILE_THREAD(name);
+        (void)name;
+
+        t_in_job = true;
+        u64_t seen = 0;
+
+        for(;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(global_jobs.mutex);
+                global_jobs.wake.wait(lock, [&]() {
+                    return global_jobs.quit || global_jobs.generation != seen || !global_jobs.tasks.empty();
+                });
+
+                if(global_jobs.quit) return;
+
+                // Batches first, the caller of parallel_for() is blocked on them
+                if(global_jobs.generation != seen) {
+                    seen = global_jobs.generation;
+                    global_jobs.active++;
+                } else {
+                    task = std::move(global_jobs.tasks.front());
+                    global_jobs.tasks.pop_front();
+                }
+            }
+
+            if(task) {
+                task();
+                PXL_METRIC_ADD("jobs.tasks", 1);
+                continue;
+            }
+
+            run_chunks(global_jobs.batch);
+
+            {
+                std::lock_guard<std::mutex> lock(global_jobs.mutex);
+                global_jobs.active--;
+            }
+            global_jobs.finished.notify_all();
+        }
+    }
+
+    void init(u32_t worker_count) {
+        if(!global_jobs.workers.empty()) return;
+
+        if(worker_count == 0) {
+            u32_t hardware = std::thread::hardware_concurrency();
+            worker_count = hardware > 1 ? hardware - 1 : 0;
+        }
+        worker_count = std::min<u32_t>(worker_count, PXL_MAX_JOB_THREADS);
+
+        for(u32_t i = 0; i < worker_count; i++)
+            global_jobs.workers.emplace_back(worker_main, i);
+    }
+
+    void shutdown() {
+        global_jobs.stop();
+    }
+
+    u32_t get_worker_count() {
+        return (u32_t)global_jobs.workers.size();
+    }
+
+    void parallel_for(u32_t count, u32_t grain, const RangeJob& job) {
+        if(count == 0) return;
+
+        grain = std::max<u32_t>(grain, 1);
+
+        // Small, nested or contended: not worth waking anyone
+        bool expected = false;
+        if(count <= grain || t_in_job || !global_jobs.busy.compare_exchange_strong(expected, true)) {
+            job(0, count);
+            return;
+        }
+
+        init();
+
+        u32_t threads = get_worker_count() + 1;
+        u32_t chunk = std::max(grain, (count + threads * 4 - 1) / (threads * 4));
+
+        JobBatch& batch = global_jobs.batch;
+        {
+            std::unique_lock<std::mutex> lock(global_jobs.mutex);
+
+            // A worker that woke up late for the previous batch may still be on its way out
+            global_jobs.finished.wait(lock, []() { return global_jobs.active == 0; });
+
+            batch.job = &job;
+            batch.count = count;
+            batch.chunk = chunk;
+            batch.chunks = (count + chunk - 1) / chunk;
+            batch.next.store(0, std::memory_order_relaxed);
+            batch.done.store(0, std::memory_order_relaxed);
+            global_jobs.generation++;
+        }
+        global_jobs.wake.notify_all();
+
+        t_in_job = true;
+        run_chunks(batch);
+        t_in_job = false;
+
+        {
+            std::unique_lock<std::mutex> lock(global_jobs.mutex);
+            // Also wait for the workers to leave run_chunks(), the next batch resets
+            // the counters they're reading
+            global_jobs.finished.wait(lock, [&]() {
+                return batch.done.load(std::memory_order_acquire) == batch.chunks
+                    && global_jobs.active == 0;
+            });
+        }
+
+        global_jobs.busy.store(false, std::memory_order_release);
+    }
+
+    void submit(Task task) {
+        init();
+
+        if(get_worker_count() == 0) {
+            task();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(global_jobs.mutex);
+            global_jobs.tasks.push_back(std::move(task));
+        }
+        global_jobs.wake.notify_one();
+    }
+
+};
+};
@@ -0,0 +1,71 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef PXL_JOB_SYSTEM_H
+#define PXL_JOB_SYSTEM_H
+
+#include "misc/utility/types.h"
+
+#include <functional>
+
+// Fork/join helper for data parallel frame work (culling, ...). A fixed set of
+// workers sleeps until parallel_for() hands out chunks, the calling thread works
+// along and returns once every chunk is done. Nested calls (or calls while
+// another thread's batch is running) just run inline :)*
+//
+// submit() is the other half: fire and forget tasks (asset decoding, ...) that the
+// workers pick up whenever no batch is waiting
+
+#ifndef PXL_MAX_JOB_THREADS
+#define PXL_MAX_JOB_THREADS 16
+#endif
+
+namespace pxl {
+namespace jobs {
+
+    using RangeJob = std::function<void(u32_t begin, u32_t end)>;
+    using Task = std::function<void()>;
+
+    // 0 = hardware threads - 1, started lazily by the first parallel_for()
+    void init(u32_t worker_count = 0);
+    void shutdown();
+
+    u32_t get_worker_count();
+
+    // Splits [0, count) into chunks of at least `grain` items
+    void parallel_for(u32_t count, u32_t grain, const RangeJob& job);
+
+    // Queues `task` for the next free worker and returns right away. Without workers
+    // (single core boxes) it runs inline, tasks still queued at shutdown() run on the
+    // calling thread. Completion is the task's business (an atomic flag, ...)
+    void submit(Task task);
+
+};
+};
+
+#endif
@@ -30,6 +30,10 @@
 
 #include "misc/utility/log.h"
 
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+#include <imgui_impl_opengl3.h>
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);  
 
 Window* Window::create_window() {
@@ -41,7 +45,7 @@ void Window::init() {
 
     LOG("Creating Window!");
 
-    if(!glfwInit()) ERROR("Failed to create Window!");
+    if(!glfwInit()) ERR("Failed to create Window!");
 
     // OpenGL 4.1 for cross platform compat :)* no posix systems for now can't test them
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
@@ -57,7 +61,7 @@ void Window::init() {
     );
 
     if(!_handle) {
-        ERROR("Failed to create Window");
+        ERR("Failed to create Window");
         cleanup();
         return;
     }
@@ -86,6 +90,49 @@ void Window::toggle_vsync() {
     glfwSwapInterval(vsync);
 }
 
+void Window::init_ui() {
+    if(ui || !_handle) return;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGui::GetIO().IniFilename = nullptr;
+    ImGui::StyleColorsDark();
+
+    // Chains to callbacks set before it, so the framebuffer resize one stays
+    ImGui_ImplGlfw_InitForOpenGL(_handle, true);
+    ImGui_ImplOpenGL3_Init("#version 410 core");
+
+    ui = true;
+    LOG("ImGui Initialized");
+}
+
+void Window::begin_ui_frame() {
+    init_ui();
+    if(!ui) return;
+
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplGlfw_NewFrame();
+    ImGui::NewFrame();
+}
+
+void Window::render_ui() {
+    if(!ui) return;
+
+    // The backend saves and restores the GL state it touches, the renderer's
+    // state cache stays valid
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
+void Window::cleanup_ui() {
+    if(!ui) return;
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+    ui = false;
+}
+
 bool Window::close() {
     return _handle ? glfwWindowShouldClose(_handle) : true;
 }
@@ -99,6 +146,8 @@ void Window::refresh() {
 }
 
 void Window::cleanup() {
+    cleanup_ui();
+
     if(_handle) {
         glfwDestroyWindow(_handle);
         _handle = nullptr; 
@@ -40,6 +40,7 @@ private:
     struct WindowConfig _config;
     
     bool vsync = false;
+    bool ui = false;
 
 public:
     ~Window();
@@ -53,6 +54,12 @@ public:
     void toggle_vsync();
     bool close();
 
+    // Dear ImGui drawn over the frame (the metrics overlay). The context and the
+    // GLFW / OpenGL3 backends start on the first begin_ui_frame()
+    void begin_ui_frame();
+    void render_ui();
+    void cleanup_ui();
+
     Window(const Window&) = delete;
     Window& operator=(const Window&) = delete;
     Window(Window&&) = delete;
@@ -60,6 +67,7 @@ public:
 
 private:
     Window();
+    void init_ui();
     void cleanup();
     
 };
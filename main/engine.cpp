@@ -28,8 +28,39 @@
 
 #include "engine.h"
 
-Engine::Engine(IAppLogic& applogic) :
-    applogic(&applogic) {
+#include "core/renderer/gl41_renderer.h"
+#include "core/renderer/null_renderer.h"
+#include "core/thread/pxl_job_system.h"
+#include "core/debug/pxl_profiler.h"
+#include "core/debug/pxl_metrics.h"
+#include "core/memory/pxl_memory.h"
+#include "misc/utility/log.h"
+
+#include <chrono>
+#include <thread>
+
+using engine_clock = std::chrono::steady_clock;
+
+Engine::Engine(IAppLogic& applogic, const EngineConfig& config) :
+    applogic(&applogic),
+    config(config) {
+
+    // lets CI force headless on an unmodified game binary :)*
+    const char* headless_env = getenv("PIXL_HEADLESS");
+    if(headless_env && headless_env[0] && headless_env[0] != '0')
+        this->config.mode = EngineMode::HEADLESS;
+
+    // Same for iterating on shaders / textures without a rebuild
+    const char* hot_reload_env = getenv("PIXL_HOT_RELOAD");
+    if(hot_reload_env && hot_reload_env[0] && hot_reload_env[0] != '0')
+        this->config.hot_reload = true;
+
+    const char* overlay_env = getenv("PIXL_METRICS_OVERLAY");
+    if(overlay_env && overlay_env[0] && overlay_env[0] != '0')
+        this->config.metrics_overlay = true;
+
+    if(this->config.tick_rate <= 0.0f)
+        this->config.tick_rate = 60.0f;
 }
 
 Engine::~Engine() {
@@ -41,40 +72,173 @@ void Engine::start() {
 }
 
 void Engine::stop() {
-
+    running.store(false, std::memory_order_relaxed);
 }
 
 void Engine::init() {
-    window = Window::create_window();
+    if(is_headless()) {
+        LOG("Starting headless, tick rate: %.2f%s",
+            config.tick_rate, config.unlocked ? " (unlocked)" : "");
+
+        renderer = std::make_unique<NullRenderer>();
+    } else {
+        window = Window::create_window();
+        window->setup_window_config(config.window);
+        window->init();
+
+        renderer = std::make_unique<GL41Renderer>(config.mesh_storage, config.upload_budget);
+    }
 
-    WindowConfig config;    
-    window->setup_window_config(config);
-    window->init();
+    renderer->get_texture_manager().set_budget(config.texture_budget);
+    renderer->set_hot_reload(config.hot_reload);
 
+    applogic->renderer = renderer.get();
     applogic->init();
 }
 
 void Engine::tick(const f32_t& dt) {
+    PXL_PROFILE_SCOPE("Engine::tick");
     applogic->tick(dt);
+    tick_count++;
 }
 
 void Engine::render() {
+    PXL_PROFILE_SCOPE("Engine::render");
     applogic->render();
+    renderer->draw();
+
+    if(window && config.metrics_overlay) {
+        PXL_PROFILE_SCOPE("Engine::metrics_overlay");
+        window->begin_ui_frame();
+        pxl::metrics::draw_overlay(&config.metrics_overlay);
+        window->render_ui();
+    }
 }
 
 void Engine::run() {
+    PXL_PROFILE_THREAD("main");
+
     init();
 
-    while(true) {
+    const f32_t dt = 1.0f / config.tick_rate;
+    const auto step = std::chrono::duration_cast<engine_clock::duration>(
+        std::chrono::duration<f64_t>(1.0 / config.tick_rate));
+
+    auto next_tick = engine_clock::now();
+    auto frame_start = next_tick;
+
+    running.store(true, std::memory_order_relaxed);
+
+    while(running.load(std::memory_order_relaxed)) {
+        PXL_PROFILE_FRAME();
+
+        auto frame_now = engine_clock::now();
+        publish_metrics(std::chrono::duration<f64_t, std::milli>(frame_now - frame_start).count());
+        frame_start = frame_now;
+
+        if(config.max_ticks && tick_count >= config.max_ticks) break;
+
+        if(is_headless()) {
+            // Fixed dt no matter how long the tick took so runs are deterministic
+            tick(dt);
+            render();
+
+            if(!config.unlocked) {
+                next_tick += step;
+                std::this_thread::sleep_until(next_tick);
+            }
+            continue;
+        }
+
         if(window->close()) break;
 
-        window->poll_events();
+        {
+            PXL_PROFILE_SCOPE("Window::poll_events");
+            window->poll_events();
+        }
+
+        auto now = engine_clock::now();
+
+        // Drop the backlog after a long stall (debugger, window drag) instead of spiraling
+        if(now - next_tick > step * 8)
+            next_tick = now;
+
+        while(next_tick <= now) {
+            tick(dt);
+            next_tick += step;
+
+            if(config.max_ticks && tick_count >= config.max_ticks) break;
+        }
+
+        render();
+
+        PXL_PROFILE_SCOPE("Window::refresh");
         window->refresh();        
     }
 
+    running.store(false, std::memory_order_relaxed);
+
     cleanup();
 }
 
+// Last frame's numbers, published at the top of the next one so the frame time
+// includes the swap / pacing sleep
+void Engine::publish_metrics(const f64_t& frame_ms) {
+    PXL_PROFILE_SCOPE("Engine::publish_metrics");
+
+    PXL_METRIC_RECORD("frame.time_ms", frame_ms);
+    PXL_METRIC_SET("frame.ticks", (f64_t)tick_count);
+
+    if(renderer) {
+        const RenderStats& stats = renderer->get_frame_stats();
+
+        PXL_METRIC_SET("renderer.draw_calls", (f64_t)stats.draw_calls);
+        PXL_METRIC_SET("renderer.triangles", (f64_t)stats.triangles);
+        PXL_METRIC_SET("renderer.triangles_saved", (f64_t)stats.triangles_saved);
+        PXL_METRIC_SET("renderer.lod_reduced", (f64_t)stats.lod_reduced);
+        PXL_METRIC_SET("renderer.index_bytes", (f64_t)stats.index_bytes);
+        PXL_METRIC_SET("renderer.index_bytes_saved", (f64_t)stats.index_bytes_saved);
+        PXL_METRIC_SET("renderer.state_changes", (f64_t)stats.state_changes());
+        PXL_METRIC_SET("renderer.material_changes", (f64_t)stats.material_changes);
+        PXL_METRIC_SET("renderer.redundant_skipped", (f64_t)stats.redundant_skipped);
+        PXL_METRIC_SET("renderer.gl_state_calls", (f64_t)stats.gl_state_calls);
+        PXL_METRIC_SET("renderer.gl_state_calls_avoided", (f64_t)stats.gl_state_calls_avoided);
+        PXL_METRIC_SET("renderer.uniforms_uploaded", (f64_t)stats.uniforms_uploaded);
+        PXL_METRIC_SET("renderer.uniform_bytes", (f64_t)stats.uniform_bytes);
+        PXL_METRIC_SET("renderer.upload_bytes", (f64_t)stats.upload_bytes);
+        PXL_METRIC_SET("renderer.uploads_pending", (f64_t)stats.uploads_pending);
+        PXL_METRIC_SET("renderer.texture_bytes", (f64_t)stats.texture_bytes);
+        PXL_METRIC_SET("renderer.texture_upload_bytes", (f64_t)stats.texture_upload_bytes);
+        PXL_METRIC_SET("renderer.textures_streaming", (f64_t)stats.textures_streaming);
+        PXL_METRIC_SET("renderer.shaders_compiling", (f64_t)stats.shaders_compiling);
+        PXL_METRIC_SET("renderer.shader_fallbacks", (f64_t)stats.shader_fallbacks);
+        PXL_METRIC_SET("renderer.culled", (f64_t)stats.culled);
+        PXL_METRIC_SET("renderer.cull_ms", stats.cull_ms);
+        PXL_METRIC_SET("renderer.sort_ms", stats.sort_ms);
+        PXL_METRIC_SET("renderer.build_ms", stats.build_ms);
+        PXL_METRIC_SET("renderer.execute_ms", stats.execute_ms);
+    }
+
+#if PXL_ENABLE_STATS
+    PXL_METRIC_SET("memory.heap.allocated_bytes", (f64_t)pxl_allocated_bytes());
+    PXL_METRIC_SET("memory.heap.peak_bytes", (f64_t)pxl_peak_bytes());
+    PXL_METRIC_SET("memory.heap.alloc_count", (f64_t)pxl_alloc_count());
+#endif
+
+    pxl::metrics::end_frame();
+}
+
 void Engine::cleanup() {
     applogic->cleanup();
-}
\ No newline at end of file
+    applogic->renderer = nullptr;
+
+    // GL objects have to go before the context does
+    if(window) window->cleanup_ui();
+
+    if(renderer) {
+        renderer->cleanup();
+        renderer.reset();
+    }
+
+    pxl::jobs::shutdown();
+}
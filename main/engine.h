@@ -30,28 +30,45 @@
 #define ENGINE_H
 
 #include "misc/utility/types.h"
+#include "core/config.h"
 #include "core/window/window.h"
+#include "core/renderer/pxl_renderer.h"
 #include "scene/iapplogic.h"
 
+#include <atomic>
+#include <memory>
+
 class Engine {
 
 private:
     Window* window = nullptr;
     IAppLogic* applogic = nullptr;
+    std::unique_ptr<PXLRenderer> renderer;
+
+    EngineConfig config;
+    std::atomic<bool> running{false};
+    u64_t tick_count = 0;
 
 public:
-    Engine(IAppLogic& applogic);
+    Engine(IAppLogic& applogic, const EngineConfig& config = EngineConfig());
     ~Engine();
 
     void start();
     void stop();
 
+    bool is_headless() const { return config.mode == EngineMode::HEADLESS; }
+    // Closing the overlay's window turns it off too
+    void set_metrics_overlay(bool shown) { config.metrics_overlay = shown; }
+    u64_t get_tick_count() const { return tick_count; }
+    PXLRenderer* get_renderer() { return renderer.get(); }
+
 private:
 
     void run();
     void init();
     void tick(const f32_t& dt);
     void render();
+    void publish_metrics(const f64_t& frame_ms);
     void cleanup();
 };
 
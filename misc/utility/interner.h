@@ -0,0 +1,83 @@
+/*********************************************************************************
+*                                                                                *
+*                                PIXL ENGINE                                     *
+*                                                                                *
+*  Copyright (c) 2025-present John Paul Valenzuela                               *
+*                                                                                *
+*  MIT License                                                                   *
+*                                                                                *
+*  Permission is hereby granted, free of charge, to any person obtaining a copy  *
+*  of this software and associated documentation files (the "Software"), to      *
+*  deal in the Software without restriction, including without limitation the    *
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or   *
+*  sell copies of the Software, and to permit persons to whom the Software is    *
+*  furnished to do so, subject to the following conditions:                      *
+*                                                                                *
+*  The above copyright notice and this permission notice shall be included in    *
+*  all copies or substantial portions of the Software.                           *
+*                                                                                *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL       *
+*  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER    *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, *
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN     *
+*  THE SOFTWARE.                                                                 *
+*                                                                                * 
+**********************************************************************************/
+
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include "types.h"
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Small dense ids for names that get looked up every frame (uniforms, blocks, ...).
+// Interning takes a lock, cache the id (PXL_INTERN does) and use that in hot loops
+namespace Interner{
+
+    struct InternTable {
+        std::mutex mutex;
+        std::unordered_map<std::string, u32_t> ids;
+        std::deque<std::string> names;     // deque so name_of() pointers stay valid
+    };
+
+    inline InternTable& table() {
+        static InternTable _table;
+        return _table;
+    }
+
+    inline u32_t intern(const char* name) {
+        InternTable& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+
+        auto it = t.ids.find(name);
+        if(it != t.ids.end()) return it->second;
+
+        u32_t id = (u32_t)t.names.size();
+        t.names.emplace_back(name);
+        t.ids.emplace(t.names.back(), id);
+        return id;
+    }
+
+    inline const char* name_of(u32_t id) {
+        InternTable& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return id < t.names.size() ? t.names[id].c_str() : "";
+    }
+
+    inline u32_t count() {
+        InternTable& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return (u32_t)t.names.size();
+    }
+};
+
+#define PXL_INTERN(name) \
+    ([]() { static const u32_t _id = Interner::intern(name); return _id; }())
+
+#endif
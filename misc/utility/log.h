@@ -33,6 +33,8 @@
 
 #include "types.h"
 
+#include "core/debug/pxl_logger.h"
+
 static inline const char* pixlShortFile(const char* path) {
     const char* src_pos;
 
@@ -49,31 +51,49 @@ static inline const char* pixlShortFile(const char* path) {
     return last ? last + 1 : path;
 }
 
-#define PIXL_LOG_IMPL(prefix, fmt, ...) \
+// Compile time floor: 0 = everything, 1 = WRN and ERR, 2 = ERR only.
+// The runtime level is pxl::logger::set_level()
+#ifndef PXL_LOG_LEVEL
+#define PXL_LOG_LEVEL 0
+#endif
+
+// Only the static call site and the raw arguments are captured here, formatting
+// happens on the logger thread (core/debug/pxl_logger.h) :D*
+#define PIXL_LOG_IMPL(level, fmt, ...) \
     do { \
-        char buffer[1024]; \
-        snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-        fprintf(stdout, "[%s][%s:%d][%s] %s\n", \
-                prefix, \
-                pixlShortFile(__FILE__), \
-                __LINE__, \
-                __func__, \
-                buffer); \
+        static const pxl::logger::LogSite _pxl_log_site = { \
+            level, fmt, __FILE__, __LINE__, __func__ }; \
+        pxl::logger::write(&_pxl_log_site, ##__VA_ARGS__); \
     } while (0)
 
-#ifdef PXL_LOGGER_ENABLED
-    #define LOG(fmt, ...)    PIXL_LOG_IMPL("LOG", fmt, ##__VA_ARGS__)
-    #define WRN(fmt, ...)   PIXL_LOG_IMPL("WRN", fmt, ##__VA_ARGS__)
-    #define ERR(fmt, ...)  PIXL_LOG_IMPL("ERR", fmt, ##__VA_ARGS__)
+#if defined(PXL_LOGGER_ENABLED) && PXL_LOG_LEVEL <= 0
+    #define LOG(fmt, ...)    PIXL_LOG_IMPL(pxl::logger::LogLevel::LOG, fmt, ##__VA_ARGS__)
 #else
     #define LOG(fmt, ...)    ((void)0)
+#endif
+
+#if defined(PXL_LOGGER_ENABLED) && PXL_LOG_LEVEL <= 1
+    #define WRN(fmt, ...)   PIXL_LOG_IMPL(pxl::logger::LogLevel::WRN, fmt, ##__VA_ARGS__)
+#else
     #define WRN(fmt, ...)   ((void)0)
+#endif
+
+#if defined(PXL_LOGGER_ENABLED) && PXL_LOG_LEVEL <= 2
+    #define ERR(fmt, ...)  PIXL_LOG_IMPL(pxl::logger::LogLevel::ERR, fmt, ##__VA_ARGS__)
+#else
     #define ERR(fmt, ...)  ((void)0)
 #endif
 
+#ifdef PXL_LOGGER_ENABLED
+    #define PIXL_LOG_FLUSH() pxl::logger::flush()
+#else
+    #define PIXL_LOG_FLUSH() ((void)0)
+#endif
+
 #define ASSERT(expr, fmt, ...)                                              \
     do {                                                                    \
         if (!(expr)) {                                                      \
+            PIXL_LOG_FLUSH();                                               \
             fprintf(stderr,                                                 \
                 "[ASSERT][%s:%d][%s] FAILED (%s): " fmt "\n",               \
                 pixlShortFile(__FILE__),                                    \
@@ -31,12 +31,20 @@
 
 #include "misc/utility/types.h"
 
+class PXLRenderer;
+
 class IAppLogic {
+    friend class Engine;
+
 public:
     virtual void init() = 0;
     virtual void tick(const f32_t& dt) = 0;
     virtual void render() = 0;
     virtual void cleanup() = 0;
+
+protected:
+    // Set by the engine before init(), GL41Renderer when windowed, NullRenderer when headless
+    PXLRenderer* renderer = nullptr;
 };
 
 #endif
\ No newline at end of file